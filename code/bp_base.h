@@ -5,6 +5,78 @@
 #include <string.h>
 #include <stdint.h>
 
+//~ NOTE(christian): context cracking
+#if defined(_WIN32)
+# define OS_WINDOWS 1
+#elif defined(__linux__)
+# define OS_LINUX 1
+#else
+// NOTE(christian): bp_os_linux.c is linux only (inotify, eventfd, clock_nanosleep on CLOCK_MONOTONIC),
+// so other unixes and macOS need a layer of their own first.
+# error "unsupported platform, only windows and linux have an OS layer"
+#endif
+
+#if !defined(OS_WINDOWS)
+# define OS_WINDOWS 0
+#endif
+#if !defined(OS_LINUX)
+# define OS_LINUX 0
+#endif
+
+#if defined(_MSC_VER)
+# define COMPILER_MSVC 1
+#else
+# define COMPILER_GCC 1
+#endif
+
+#if !defined(COMPILER_MSVC)
+# define COMPILER_MSVC 0
+#endif
+#if !defined(COMPILER_GCC)
+# define COMPILER_GCC 0
+#endif
+
+#if defined(_M_X64) || defined(__x86_64__)
+# define ARCH_X64 1
+#else
+# define ARCH_X64 0
+#endif
+
+// NOTE(christian): SSE2 is part of x64, so that is our baseline wide path. AVX2 is picked up when the
+// compiler is told to target it (/arch:AVX2, -mavx2). BP_SIMD_SCALAR forces the scalar fallback.
+#if !defined(BP_SIMD_SCALAR)
+# define BP_SIMD_SCALAR 0
+#endif
+
+#if ARCH_X64 && !BP_SIMD_SCALAR
+# if defined(__AVX2__)
+#  define SIMD_AVX2 1
+#  include <immintrin.h>
+# else
+#  define SIMD_SSE2 1
+#  include <emmintrin.h>
+# endif
+#endif
+
+#if !defined(SIMD_AVX2)
+# define SIMD_AVX2 0
+#endif
+#if !defined(SIMD_SSE2)
+# define SIMD_SSE2 0
+#endif
+
+// NOTE(christian): SSSE3 isn't part of x64 either. SSE2 builds compile the odd routine that wants
+// pshufb for it on its own with SIMD_TARGET_SSSE3, and only call it when the cpu has it.
+#if SIMD_SSE2
+# include <tmmintrin.h>
+# if COMPILER_MSVC
+#  include <intrin.h>
+#  define SIMD_TARGET_SSSE3
+# else
+#  define SIMD_TARGET_SSSE3 __attribute__((target("ssse3")))
+# endif
+#endif
+
 typedef    int8_t s8;
 typedef   uint8_t u8;
 typedef  int16_t s16;
@@ -55,6 +127,8 @@ typedef struct String_Const_U32
 
 #if BP_DEBUG
 # define Assert(c) Stmnt( if(!(c)){ AssertBreak(); } )
+#else
+# define Assert(c) Stmnt( (void)sizeof(c); )
 #endif
 
 #define AssertTrue(c) Assert((c)==True)
@@ -63,14 +137,51 @@ typedef struct String_Const_U32
 #define InvalidCodePath() AssertBreak()
 
 #define MemoryCopy(dest,source,size) memcpy(dest,source,size)
+#define MemoryZero(dest,size) memset(dest,0,size)
 #define Min(a,b) ((a)<(b)?(a):(b))
 #define Max(a,b) ((a)>(b)?(a):(b))
+#define Clamp(lo,x,hi) (((x)<(lo))?(lo):(((x)>(hi))?(hi):(x)))
 #define ArrayCount(a) (sizeof(a)/sizeof(*(a)))
 
+#define AlignPow2(v,a) (((v) + ((a) - 1)) & ~((a) - 1))
+#define IsPow2(v) ((v) && !((v) & ((v) - 1)))
+
 #define KB(v) (1024llu*(u64)(v))
 #define MB(v) (1024llu*KB(v))
 #define GB(v) (1024llu*MB(v))
 
+#if COMPILER_MSVC
+# define per_thread __declspec(thread)
+#else
+# define per_thread __thread
+#endif
+
+//~ NOTE(christian): atomics. all of these are full barriers. the ones that modify return the new value.
+#if COMPILER_MSVC
+# define AtomicLoadU32(p) ((u32)_InterlockedOr((volatile long *)(p), 0))
+# define AtomicStoreU32(p,v) ((void)_InterlockedExchange((volatile long *)(p), (long)(v)))
+# define AtomicAddU32(p,v) ((u32)_InterlockedExchangeAdd((volatile long *)(p), (long)(v)) + (u32)(v))
+# define AtomicIncrementU32(p) ((u32)_InterlockedIncrement((volatile long *)(p)))
+# define AtomicDecrementU32(p) ((u32)_InterlockedDecrement((volatile long *)(p)))
+# define AtomicCompareExchangeU32(p,expected,desired) ((u32)_InterlockedCompareExchange((volatile long *)(p), (long)(desired), (long)(expected)) == (u32)(expected))
+#else
+# define AtomicLoadU32(p) __atomic_load_n((volatile u32 *)(p), __ATOMIC_SEQ_CST)
+# define AtomicStoreU32(p,v) __atomic_store_n((volatile u32 *)(p), (u32)(v), __ATOMIC_SEQ_CST)
+# define AtomicAddU32(p,v) __atomic_add_fetch((volatile u32 *)(p), (u32)(v), __ATOMIC_SEQ_CST)
+# define AtomicIncrementU32(p) __atomic_add_fetch((volatile u32 *)(p), 1, __ATOMIC_SEQ_CST)
+# define AtomicDecrementU32(p) __atomic_sub_fetch((volatile u32 *)(p), 1, __ATOMIC_SEQ_CST)
+# define AtomicCompareExchangeU32(p,expected,desired) __sync_bool_compare_and_swap((volatile u32 *)(p), (u32)(expected), (u32)(desired))
+#endif
+
+// NOTE(christian): hint for spin-wait loops.
+#if COMPILER_MSVC
+# define SpinPause() YieldProcessor()
+#elif ARCH_X64
+# define SpinPause() __builtin_ia32_pause()
+#else
+# define SpinPause()
+#endif
+
 #define global static
 #define local static
 #define function static
@@ -85,7 +196,7 @@ typedef struct String_Const_U32
 
 #define bad_index_u32 0xFFFFFFFF
 
-#include "bp_base_util.h"
 #include "bp_base_math.h"
+#include "bp_base_util.h"
 
 #endif //BP_BASE_H
@@ -3,7 +3,9 @@
 inline f32
 EaseOutQuart(f32 t)
 {
-    f32 result = 1.0f - powf(1.0f - t, 4.0f);
+    f32 u = 1.0f - t;
+    u = u * u;
+    f32 result = 1.0f - u * u;
     return(result);
 }
 
@@ -31,6 +33,156 @@ ToRadiansF32(f32 x)
     return(result);
 }
 
+// NOTE(christian): constants shared by the scalar and the wide approximations.
+#define round_magic_F32 12582912.0f // 1.5 * 2^23
+#define inv_two_pi_F32 0.159154943f
+#define two_pi_hi_F32 6.28125f
+#define two_pi_lo_F32 0.00193530717f
+#define sin_c3_F32 -1.66666667e-1f
+#define sin_c5_F32 8.33333333e-3f
+#define sin_c7_F32 -1.98412698e-4f
+#define sin_c9_F32 2.75573192e-6f
+#define sin_c11_F32 -2.50521084e-8f
+#define rsqrt_magic_U32 0x5f375a86
+
+// NOTE(christian): round to nearest even, valid for |x| < 2^22.
+inline f32
+RoundF32(f32 x)
+{
+    f32 biased = x + round_magic_F32;
+    f32 result = biased - round_magic_F32;
+    return(result);
+}
+
+inline f32
+SinApproxF32(f32 x)
+{
+    // NOTE(christian): reduce to [-pi, pi], reflect to [-pi/2, pi/2], then odd taylor to x^11.
+    f32 k = RoundF32(x * inv_two_pi_F32);
+    x = x - k * two_pi_hi_F32;
+    x = x - k * two_pi_lo_F32;
+    
+    if (x > half_pi_F32)
+    {
+        x = pi_F32 - x;
+    }
+    
+    if (x < -half_pi_F32)
+    {
+        x = -pi_F32 - x;
+    }
+    
+    f32 x2 = x * x;
+    f32 p = sin_c11_F32;
+    p = p * x2 + sin_c9_F32;
+    p = p * x2 + sin_c7_F32;
+    p = p * x2 + sin_c5_F32;
+    p = p * x2 + sin_c3_F32;
+    f32 result = (x * x2) * p + x;
+    return(result);
+}
+
+inline f32
+CosApproxF32(f32 x)
+{
+    f32 result = SinApproxF32(x + half_pi_F32);
+    return(result);
+}
+
+inline f32
+RSqrtApproxF32(f32 x)
+{
+    union { f32 f; u32 n; } guess;
+    guess.f = x;
+    guess.n = rsqrt_magic_U32 - (guess.n >> 1);
+    
+    f32 half_x = x * 0.5f;
+    f32 y = guess.f;
+    y = y * (1.5f - (half_x * y) * y);
+    y = y * (1.5f - (half_x * y) * y);
+    return(y);
+}
+
+inline f32
+SqrtApproxF32(f32 x)
+{
+    f32 result = x * RSqrtApproxF32(x);
+    return(result);
+}
+
+#define log2_sqrt2_F32 1.41421356f
+#define log2_scale_F32 2.88539008f // 2 / ln(2)
+#define exp2_ln2_F32 0.693147181f
+#define exp2_min_F32 -126.0f
+#define exp2_max_F32 126.0f
+#define float_exponent_bias_U32 127
+#define round_magic_bits_U32 0x4B400000
+
+// NOTE(christian): x = m * 2^e with m in [sqrt(1/2), sqrt(2)), then log2(m) = 2/ln2 * atanh((m-1)/(m+1)).
+// x must be positive and normal. about 1e-7 absolute error.
+inline f32
+Log2ApproxF32(f32 x)
+{
+    union { f32 f; u32 n; } bits;
+    bits.f = x;
+    f32 exponent = (f32)(s32)(((bits.n >> 23) & 0xFF) - float_exponent_bias_U32);
+    bits.n = (bits.n & 0x007FFFFF) | 0x3F800000;
+    f32 m = bits.f;
+    
+    if (m > log2_sqrt2_F32)
+    {
+        m = m * 0.5f;
+        exponent = exponent + 1.0f;
+    }
+    
+    f32 t = (m - 1.0f) / (m + 1.0f);
+    f32 t2 = t * t;
+    f32 p = 1.0f / 7.0f;
+    p = p * t2 + (1.0f / 5.0f);
+    p = p * t2 + (1.0f / 3.0f);
+    p = p * t2 + 1.0f;
+    f32 result = (t * p) * log2_scale_F32 + exponent;
+    return(result);
+}
+
+// NOTE(christian): 2^x = 2^k * e^(f*ln2) with k = round(x). x is clamped to the normal range.
+inline f32
+Exp2ApproxF32(f32 x)
+{
+    x = (x > exp2_min_F32) ? x : exp2_min_F32;
+    x = (x < exp2_max_F32) ? x : exp2_max_F32;
+    
+    union { f32 f; u32 n; } biased;
+    biased.f = x + round_magic_F32;
+    f32 k = biased.f - round_magic_F32;
+    f32 g = (x - k) * exp2_ln2_F32;
+    
+    f32 p = 1.0f / 720.0f;
+    p = p * g + (1.0f / 120.0f);
+    p = p * g + (1.0f / 24.0f);
+    p = p * g + (1.0f / 6.0f);
+    p = p * g + 0.5f;
+    p = p * g + 1.0f;
+    p = p * g + 1.0f;
+    
+    union { f32 f; u32 n; } scale;
+    scale.n = ((biased.n - round_magic_bits_U32) + float_exponent_bias_U32) << 23;
+    f32 result = p * scale.f;
+    return(result);
+}
+
+// NOTE(christian): x <= 0 gives 0.
+inline f32
+PowApproxF32(f32 x, f32 y)
+{
+    f32 result = 0.0f;
+    if (x > 0.0f)
+    {
+        result = Exp2ApproxF32(y * Log2ApproxF32(x));
+    }
+    return(result);
+}
+
 //~ NOTE(christian): V2F
 inline v2f
 V2F_Scale(v2f a, f32 scale)
@@ -80,4 +232,583 @@ Matrix4x4_Orthographic_LH_CM_Z01(f32 left, f32 right, f32 top,
     result.r2 = V4F(0.0f, 0.0f, 1.0f / (far - near), -near / (far - near));
     result.r3 = V4F(0.0f, 0.0f , 0.0f, 1.0f);
     return(result);
-}
\ No newline at end of file
+}
+
+inline m44
+Matrix4x4_Multiply(m44 a, m44 b)
+{
+    m44 result;
+#if SIMD_SSE2 || SIMD_AVX2
+    __m128 b0 = _mm_loadu_ps(b.m[0]);
+    __m128 b1 = _mm_loadu_ps(b.m[1]);
+    __m128 b2 = _mm_loadu_ps(b.m[2]);
+    __m128 b3 = _mm_loadu_ps(b.m[3]);
+    for (u32 row = 0; row < 4; ++row)
+    {
+        __m128 r = _mm_mul_ps(_mm_set1_ps(a.m[row][0]), b0);
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a.m[row][1]), b1));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a.m[row][2]), b2));
+        r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a.m[row][3]), b3));
+        _mm_storeu_ps(result.m[row], r);
+    }
+#else
+    for (u32 row = 0; row < 4; ++row)
+    {
+        for (u32 column = 0; column < 4; ++column)
+        {
+            f32 r = a.m[row][0] * b.m[0][column];
+            r = r + a.m[row][1] * b.m[1][column];
+            r = r + a.m[row][2] * b.m[2][column];
+            r = r + a.m[row][3] * b.m[3][column];
+            result.m[row][column] = r;
+        }
+    }
+#endif
+    return(result);
+}
+
+inline v4f
+Matrix4x4_TransformV4F(m44 m, v4f v)
+{
+    v4f result;
+    for (u32 row = 0; row < 4; ++row)
+    {
+        f32 r = m.m[row][0] * v.x;
+        r = r + m.m[row][1] * v.y;
+        r = r + m.m[row][2] * v.z;
+        r = r + m.m[row][3] * v.w;
+        result.v[row] = r;
+    }
+    return(result);
+}
+
+// NOTE(christian): points are (x, y, 0, 1). only x and y of the result are kept.
+function void
+Matrix4x4_TransformPointsV2F(m44 m, v2f *points, v2f *out, u32 count)
+{
+    u32 point_index = 0;
+#if lane_width > 1
+    lane_f32 m00 = LaneF32_Set1(m.m[0][0]), m01 = LaneF32_Set1(m.m[0][1]), m03 = LaneF32_Set1(m.m[0][3]);
+    lane_f32 m10 = LaneF32_Set1(m.m[1][0]), m11 = LaneF32_Set1(m.m[1][1]), m13 = LaneF32_Set1(m.m[1][3]);
+    for (; (point_index + lane_width) <= count; point_index += lane_width)
+    {
+        f32 xs[lane_width];
+        f32 ys[lane_width];
+        for (u32 lane_index = 0; lane_index < lane_width; ++lane_index)
+        {
+            xs[lane_index] = points[point_index + lane_index].x;
+            ys[lane_index] = points[point_index + lane_index].y;
+        }
+        
+        lane_v2f p = LaneV2F_Load(xs, ys);
+        lane_v2f r;
+        r.x = LaneF32_Add(LaneF32_Add(LaneF32_Multiply(m00, p.x), LaneF32_Multiply(m01, p.y)), m03);
+        r.y = LaneF32_Add(LaneF32_Add(LaneF32_Multiply(m10, p.x), LaneF32_Multiply(m11, p.y)), m13);
+        LaneV2F_StoreInterleaved(out + point_index, r);
+    }
+#endif
+    for (; point_index < count; ++point_index)
+    {
+        v2f p = points[point_index];
+        out[point_index].x = (m.m[0][0] * p.x + m.m[0][1] * p.y) + m.m[0][3];
+        out[point_index].y = (m.m[1][0] * p.x + m.m[1][1] * p.y) + m.m[1][3];
+    }
+}
+
+//~ NOTE(christian): wide lanes
+#if SIMD_AVX2
+inline lane_f32 LaneF32_Set1(f32 a) { lane_f32 r; r.v = _mm256_set1_ps(a); return(r); }
+inline lane_f32 LaneF32_Load(f32 *a) { lane_f32 r; r.v = _mm256_loadu_ps(a); return(r); }
+inline void LaneF32_Store(f32 *dest, lane_f32 a) { _mm256_storeu_ps(dest, a.v); }
+inline lane_f32 LaneF32_Add(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm256_add_ps(a.v, b.v); return(r); }
+inline lane_f32 LaneF32_Subtract(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm256_sub_ps(a.v, b.v); return(r); }
+inline lane_f32 LaneF32_Multiply(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm256_mul_ps(a.v, b.v); return(r); }
+inline lane_f32 LaneF32_Divide(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm256_div_ps(a.v, b.v); return(r); }
+inline lane_f32 LaneF32_Min(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm256_min_ps(a.v, b.v); return(r); }
+inline lane_f32 LaneF32_Max(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm256_max_ps(a.v, b.v); return(r); }
+inline lane_f32 LaneF32_Sqrt(lane_f32 a) { lane_f32 r; r.v = _mm256_sqrt_ps(a.v); return(r); }
+inline lane_u32 LaneF32_GreaterThan(lane_f32 a, lane_f32 b) { lane_u32 r; r.v = _mm256_castps_si256(_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)); return(r); }
+inline lane_u32 LaneF32_LessThan(lane_f32 a, lane_f32 b) { lane_u32 r; r.v = _mm256_castps_si256(_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)); return(r); }
+inline lane_u32 LaneF32_GreaterEqual(lane_f32 a, lane_f32 b) { lane_u32 r; r.v = _mm256_castps_si256(_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)); return(r); }
+inline lane_f32 LaneF32_Select(lane_u32 mask, lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm256_blendv_ps(b.v, a.v, _mm256_castsi256_ps(mask.v)); return(r); }
+
+inline lane_f32 LaneF32_FromBits(lane_u32 a) { lane_f32 r; r.v = _mm256_castsi256_ps(a.v); return(r); }
+inline lane_u32 LaneU32_FromBits(lane_f32 a) { lane_u32 r; r.v = _mm256_castps_si256(a.v); return(r); }
+inline lane_f32 LaneF32_FromS32(lane_u32 a) { lane_f32 r; r.v = _mm256_cvtepi32_ps(a.v); return(r); }
+inline lane_u32 LaneU32_FromF32(lane_f32 a) { lane_u32 r; r.v = _mm256_cvtps_epi32(a.v); return(r); }
+inline lane_u32 LaneU32_Set1(u32 a) { lane_u32 r; r.v = _mm256_set1_epi32((s32)a); return(r); }
+inline lane_u32 LaneU32_Add(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = _mm256_add_epi32(a.v, b.v); return(r); }
+inline lane_u32 LaneU32_Subtract(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = _mm256_sub_epi32(a.v, b.v); return(r); }
+inline lane_u32 LaneU32_And(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = _mm256_and_si256(a.v, b.v); return(r); }
+inline lane_u32 LaneU32_Or(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = _mm256_or_si256(a.v, b.v); return(r); }
+inline lane_u32 LaneU32_ShiftLeft(lane_u32 a, u32 shift) { lane_u32 r; r.v = _mm256_sll_epi32(a.v, _mm_cvtsi32_si128((s32)shift)); return(r); }
+inline lane_u32 LaneU32_ShiftRight(lane_u32 a, u32 shift) { lane_u32 r; r.v = _mm256_srl_epi32(a.v, _mm_cvtsi32_si128((s32)shift)); return(r); }
+inline b32 LaneU32_AnyNonZero(lane_u32 mask) { return(!_mm256_testz_si256(mask.v, mask.v)); }
+inline lane_u32 LaneU32_Load(u32 *a) { lane_u32 r; r.v = _mm256_loadu_si256((__m256i *)a); return(r); }
+inline void LaneU32_Store(u32 *dest, lane_u32 a) { _mm256_storeu_si256((__m256i *)dest, a.v); }
+inline lane_u32 LaneU32_Xor(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = _mm256_xor_si256(a.v, b.v); return(r); }
+
+// NOTE(christian): mul_epu32 only multiplies the even lanes, so the odd ones are shifted down and done
+// in a second multiply. the shuffles and unpacks stay inside each 128 bit half, same as the sse2 one.
+inline lane_u32
+LaneU32_MultiplyWide(lane_u32 a, lane_u32 b, lane_u32 *out_hi)
+{
+    __m256i even = _mm256_mul_epu32(a.v, b.v);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a.v, 32), _mm256_srli_epi64(b.v, 32));
+    even = _mm256_shuffle_epi32(even, _MM_SHUFFLE(3, 1, 2, 0));
+    odd = _mm256_shuffle_epi32(odd, _MM_SHUFFLE(3, 1, 2, 0));
+    lane_u32 result;
+    result.v = _mm256_unpacklo_epi32(even, odd);
+    out_hi->v = _mm256_unpackhi_epi32(even, odd);
+    return(result);
+}
+
+inline lane_f32
+LaneF32_RSqrtApprox(lane_f32 a)
+{
+    __m256i bits = _mm256_sub_epi32(_mm256_set1_epi32(rsqrt_magic_U32), _mm256_srli_epi32(_mm256_castps_si256(a.v), 1));
+    lane_f32 half_x = LaneF32_Multiply(a, LaneF32_Set1(0.5f));
+    lane_f32 three_halves = LaneF32_Set1(1.5f);
+    lane_f32 y;
+    y.v = _mm256_castsi256_ps(bits);
+    y = LaneF32_Multiply(y, LaneF32_Subtract(three_halves, LaneF32_Multiply(LaneF32_Multiply(half_x, y), y)));
+    y = LaneF32_Multiply(y, LaneF32_Subtract(three_halves, LaneF32_Multiply(LaneF32_Multiply(half_x, y), y)));
+    return(y);
+}
+
+inline void
+LaneV2F_StoreInterleaved(v2f *dest, lane_v2f a)
+{
+    __m256 lo = _mm256_unpacklo_ps(a.x.v, a.y.v);
+    __m256 hi = _mm256_unpackhi_ps(a.x.v, a.y.v);
+    _mm256_storeu_ps((f32 *)(dest + 0), _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_storeu_ps((f32 *)(dest + 4), _mm256_permute2f128_ps(lo, hi, 0x31));
+}
+
+// NOTE(christian): 4x4 transposes within the 128 bit halves, rows 0-3 and 4-7 apart. half k of
+// the results is then lanes k and k + 4, the permutes put each lane's two halves together.
+inline void
+LaneU32_StoreInterleaved8(u32 *dest, lane_u32 *a)
+{
+    for (u32 half = 0; half < 2; ++half)
+    {
+        lane_u32 *rows = a + 4 * half;
+        __m256i t0 = _mm256_unpacklo_epi32(rows[0].v, rows[1].v);
+        __m256i t1 = _mm256_unpacklo_epi32(rows[2].v, rows[3].v);
+        __m256i t2 = _mm256_unpackhi_epi32(rows[0].v, rows[1].v);
+        __m256i t3 = _mm256_unpackhi_epi32(rows[2].v, rows[3].v);
+        __m256i columns[4];
+        columns[0] = _mm256_unpacklo_epi64(t0, t1);
+        columns[1] = _mm256_unpackhi_epi64(t0, t1);
+        columns[2] = _mm256_unpacklo_epi64(t2, t3);
+        columns[3] = _mm256_unpackhi_epi64(t2, t3);
+        for (u32 lane_index = 0; lane_index < 4; ++lane_index)
+        {
+            u32 *lane_dest = dest + 8 * lane_index + 4 * half;
+            _mm_storeu_si128((__m128i *)lane_dest, _mm256_castsi256_si128(columns[lane_index]));
+            _mm_storeu_si128((__m128i *)(lane_dest + 32), _mm256_extracti128_si256(columns[lane_index], 1));
+        }
+    }
+}
+#elif SIMD_SSE2
+inline lane_f32 LaneF32_Set1(f32 a) { lane_f32 r; r.v = _mm_set1_ps(a); return(r); }
+inline lane_f32 LaneF32_Load(f32 *a) { lane_f32 r; r.v = _mm_loadu_ps(a); return(r); }
+inline void LaneF32_Store(f32 *dest, lane_f32 a) { _mm_storeu_ps(dest, a.v); }
+inline lane_f32 LaneF32_Add(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm_add_ps(a.v, b.v); return(r); }
+inline lane_f32 LaneF32_Subtract(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm_sub_ps(a.v, b.v); return(r); }
+inline lane_f32 LaneF32_Multiply(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm_mul_ps(a.v, b.v); return(r); }
+inline lane_f32 LaneF32_Divide(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm_div_ps(a.v, b.v); return(r); }
+inline lane_f32 LaneF32_Min(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm_min_ps(a.v, b.v); return(r); }
+inline lane_f32 LaneF32_Max(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = _mm_max_ps(a.v, b.v); return(r); }
+inline lane_f32 LaneF32_Sqrt(lane_f32 a) { lane_f32 r; r.v = _mm_sqrt_ps(a.v); return(r); }
+inline lane_u32 LaneF32_GreaterThan(lane_f32 a, lane_f32 b) { lane_u32 r; r.v = _mm_castps_si128(_mm_cmpgt_ps(a.v, b.v)); return(r); }
+inline lane_u32 LaneF32_LessThan(lane_f32 a, lane_f32 b) { lane_u32 r; r.v = _mm_castps_si128(_mm_cmplt_ps(a.v, b.v)); return(r); }
+inline lane_u32 LaneF32_GreaterEqual(lane_f32 a, lane_f32 b) { lane_u32 r; r.v = _mm_castps_si128(_mm_cmpge_ps(a.v, b.v)); return(r); }
+
+inline lane_f32
+LaneF32_Select(lane_u32 mask, lane_f32 a, lane_f32 b)
+{
+    __m128 m = _mm_castsi128_ps(mask.v);
+    lane_f32 r;
+    r.v = _mm_or_ps(_mm_and_ps(m, a.v), _mm_andnot_ps(m, b.v));
+    return(r);
+}
+
+inline lane_f32 LaneF32_FromBits(lane_u32 a) { lane_f32 r; r.v = _mm_castsi128_ps(a.v); return(r); }
+inline lane_u32 LaneU32_FromBits(lane_f32 a) { lane_u32 r; r.v = _mm_castps_si128(a.v); return(r); }
+inline lane_f32 LaneF32_FromS32(lane_u32 a) { lane_f32 r; r.v = _mm_cvtepi32_ps(a.v); return(r); }
+inline lane_u32 LaneU32_FromF32(lane_f32 a) { lane_u32 r; r.v = _mm_cvtps_epi32(a.v); return(r); }
+inline lane_u32 LaneU32_Set1(u32 a) { lane_u32 r; r.v = _mm_set1_epi32((s32)a); return(r); }
+inline lane_u32 LaneU32_Add(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = _mm_add_epi32(a.v, b.v); return(r); }
+inline lane_u32 LaneU32_Subtract(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = _mm_sub_epi32(a.v, b.v); return(r); }
+inline lane_u32 LaneU32_And(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = _mm_and_si128(a.v, b.v); return(r); }
+inline lane_u32 LaneU32_Or(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = _mm_or_si128(a.v, b.v); return(r); }
+inline lane_u32 LaneU32_ShiftLeft(lane_u32 a, u32 shift) { lane_u32 r; r.v = _mm_sll_epi32(a.v, _mm_cvtsi32_si128((s32)shift)); return(r); }
+inline lane_u32 LaneU32_ShiftRight(lane_u32 a, u32 shift) { lane_u32 r; r.v = _mm_srl_epi32(a.v, _mm_cvtsi32_si128((s32)shift)); return(r); }
+inline b32 LaneU32_AnyNonZero(lane_u32 mask) { return(_mm_movemask_epi8(mask.v) != 0); }
+inline lane_u32 LaneU32_Load(u32 *a) { lane_u32 r; r.v = _mm_loadu_si128((__m128i *)a); return(r); }
+inline void LaneU32_Store(u32 *dest, lane_u32 a) { _mm_storeu_si128((__m128i *)dest, a.v); }
+inline lane_u32 LaneU32_Xor(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = _mm_xor_si128(a.v, b.v); return(r); }
+
+// NOTE(christian): mul_epu32 only multiplies lanes 0 and 2, so 1 and 3 are shifted down and done in a
+// second multiply. the shuffles put the low halves of both products first, the unpacks interleave them.
+inline lane_u32
+LaneU32_MultiplyWide(lane_u32 a, lane_u32 b, lane_u32 *out_hi)
+{
+    __m128i even = _mm_mul_epu32(a.v, b.v);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a.v, 32), _mm_srli_epi64(b.v, 32));
+    even = _mm_shuffle_epi32(even, _MM_SHUFFLE(3, 1, 2, 0));
+    odd = _mm_shuffle_epi32(odd, _MM_SHUFFLE(3, 1, 2, 0));
+    lane_u32 result;
+    result.v = _mm_unpacklo_epi32(even, odd);
+    out_hi->v = _mm_unpackhi_epi32(even, odd);
+    return(result);
+}
+
+inline lane_f32
+LaneF32_RSqrtApprox(lane_f32 a)
+{
+    __m128i bits = _mm_sub_epi32(_mm_set1_epi32(rsqrt_magic_U32), _mm_srli_epi32(_mm_castps_si128(a.v), 1));
+    lane_f32 half_x = LaneF32_Multiply(a, LaneF32_Set1(0.5f));
+    lane_f32 three_halves = LaneF32_Set1(1.5f);
+    lane_f32 y;
+    y.v = _mm_castsi128_ps(bits);
+    y = LaneF32_Multiply(y, LaneF32_Subtract(three_halves, LaneF32_Multiply(LaneF32_Multiply(half_x, y), y)));
+    y = LaneF32_Multiply(y, LaneF32_Subtract(three_halves, LaneF32_Multiply(LaneF32_Multiply(half_x, y), y)));
+    return(y);
+}
+
+inline void
+LaneV2F_StoreInterleaved(v2f *dest, lane_v2f a)
+{
+    _mm_storeu_ps((f32 *)(dest + 0), _mm_unpacklo_ps(a.x.v, a.y.v));
+    _mm_storeu_ps((f32 *)(dest + 2), _mm_unpackhi_ps(a.x.v, a.y.v));
+}
+
+inline void
+LaneU32_StoreInterleaved8(u32 *dest, lane_u32 *a)
+{
+    for (u32 half = 0; half < 2; ++half)
+    {
+        lane_u32 *rows = a + 4 * half;
+        __m128i t0 = _mm_unpacklo_epi32(rows[0].v, rows[1].v);
+        __m128i t1 = _mm_unpacklo_epi32(rows[2].v, rows[3].v);
+        __m128i t2 = _mm_unpackhi_epi32(rows[0].v, rows[1].v);
+        __m128i t3 = _mm_unpackhi_epi32(rows[2].v, rows[3].v);
+        _mm_storeu_si128((__m128i *)(dest + 0 + 4 * half), _mm_unpacklo_epi64(t0, t1));
+        _mm_storeu_si128((__m128i *)(dest + 8 + 4 * half), _mm_unpackhi_epi64(t0, t1));
+        _mm_storeu_si128((__m128i *)(dest + 16 + 4 * half), _mm_unpacklo_epi64(t2, t3));
+        _mm_storeu_si128((__m128i *)(dest + 24 + 4 * half), _mm_unpackhi_epi64(t2, t3));
+    }
+}
+#else
+inline lane_f32 LaneF32_Set1(f32 a) { lane_f32 r; r.v = a; return(r); }
+inline lane_f32 LaneF32_Load(f32 *a) { lane_f32 r; r.v = *a; return(r); }
+inline void LaneF32_Store(f32 *dest, lane_f32 a) { *dest = a.v; }
+inline lane_f32 LaneF32_Add(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = a.v + b.v; return(r); }
+inline lane_f32 LaneF32_Subtract(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = a.v - b.v; return(r); }
+inline lane_f32 LaneF32_Multiply(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = a.v * b.v; return(r); }
+inline lane_f32 LaneF32_Divide(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = a.v / b.v; return(r); }
+inline lane_f32 LaneF32_Min(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = (a.v < b.v) ? a.v : b.v; return(r); }
+inline lane_f32 LaneF32_Max(lane_f32 a, lane_f32 b) { lane_f32 r; r.v = (a.v > b.v) ? a.v : b.v; return(r); }
+inline lane_f32 LaneF32_Sqrt(lane_f32 a) { lane_f32 r; r.v = sqrtf(a.v); return(r); }
+inline lane_u32 LaneF32_GreaterThan(lane_f32 a, lane_f32 b) { lane_u32 r; r.v = (a.v > b.v) ? 0xFFFFFFFF : 0; return(r); }
+inline lane_u32 LaneF32_LessThan(lane_f32 a, lane_f32 b) { lane_u32 r; r.v = (a.v < b.v) ? 0xFFFFFFFF : 0; return(r); }
+inline lane_u32 LaneF32_GreaterEqual(lane_f32 a, lane_f32 b) { lane_u32 r; r.v = (a.v >= b.v) ? 0xFFFFFFFF : 0; return(r); }
+inline lane_f32 LaneF32_Select(lane_u32 mask, lane_f32 a, lane_f32 b) { lane_f32 r; r.v = mask.v ? a.v : b.v; return(r); }
+inline lane_f32 LaneF32_RSqrtApprox(lane_f32 a) { lane_f32 r; r.v = RSqrtApproxF32(a.v); return(r); }
+inline void LaneV2F_StoreInterleaved(v2f *dest, lane_v2f a) { dest->x = a.x.v; dest->y = a.y.v; }
+inline void LaneU32_StoreInterleaved8(u32 *dest, lane_u32 *a) { for (u32 row = 0; row < 8; ++row) dest[row] = a[row].v; }
+
+inline lane_f32 LaneF32_FromBits(lane_u32 a) { union { u32 n; f32 f; } c; c.n = a.v; lane_f32 r; r.v = c.f; return(r); }
+inline lane_u32 LaneU32_FromBits(lane_f32 a) { union { f32 f; u32 n; } c; c.f = a.v; lane_u32 r; r.v = c.n; return(r); }
+inline lane_f32 LaneF32_FromS32(lane_u32 a) { lane_f32 r; r.v = (f32)(s32)a.v; return(r); }
+inline lane_u32 LaneU32_FromF32(lane_f32 a) { lane_u32 r; r.v = (u32)(s32)RoundF32(a.v); return(r); }
+inline lane_u32 LaneU32_Set1(u32 a) { lane_u32 r; r.v = a; return(r); }
+inline lane_u32 LaneU32_Add(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = a.v + b.v; return(r); }
+inline lane_u32 LaneU32_Subtract(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = a.v - b.v; return(r); }
+inline lane_u32 LaneU32_And(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = a.v & b.v; return(r); }
+inline lane_u32 LaneU32_Or(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = a.v | b.v; return(r); }
+inline lane_u32 LaneU32_ShiftLeft(lane_u32 a, u32 shift) { lane_u32 r; r.v = a.v << shift; return(r); }
+inline lane_u32 LaneU32_ShiftRight(lane_u32 a, u32 shift) { lane_u32 r; r.v = a.v >> shift; return(r); }
+inline b32 LaneU32_AnyNonZero(lane_u32 mask) { return(mask.v != 0); }
+inline lane_u32 LaneU32_Load(u32 *a) { lane_u32 r; r.v = *a; return(r); }
+inline void LaneU32_Store(u32 *dest, lane_u32 a) { *dest = a.v; }
+inline lane_u32 LaneU32_Xor(lane_u32 a, lane_u32 b) { lane_u32 r; r.v = a.v ^ b.v; return(r); }
+
+inline lane_u32
+LaneU32_MultiplyWide(lane_u32 a, lane_u32 b, lane_u32 *out_hi)
+{
+    u64 product = (u64)a.v * (u64)b.v;
+    lane_u32 result;
+    result.v = (u32)product;
+    out_hi->v = (u32)(product >> 32);
+    return(result);
+}
+#endif
+
+inline lane_f32
+LaneF32_MulAdd(lane_f32 a, lane_f32 b, lane_f32 c)
+{
+    // NOTE(christian): deliberately not fused, it has to round like the scalar a * b + c.
+    lane_f32 result = LaneF32_Add(LaneF32_Multiply(a, b), c);
+    return(result);
+}
+
+inline lane_f32
+LaneF32_Round(lane_f32 a)
+{
+    lane_f32 magic = LaneF32_Set1(round_magic_F32);
+    lane_f32 result = LaneF32_Subtract(LaneF32_Add(a, magic), magic);
+    return(result);
+}
+
+inline lane_f32
+LaneF32_SqrtApprox(lane_f32 a)
+{
+    lane_f32 result = LaneF32_Multiply(a, LaneF32_RSqrtApprox(a));
+    return(result);
+}
+
+inline lane_f32
+LaneF32_SinApprox(lane_f32 x)
+{
+    lane_f32 k = LaneF32_Round(LaneF32_Multiply(x, LaneF32_Set1(inv_two_pi_F32)));
+    x = LaneF32_Subtract(x, LaneF32_Multiply(k, LaneF32_Set1(two_pi_hi_F32)));
+    x = LaneF32_Subtract(x, LaneF32_Multiply(k, LaneF32_Set1(two_pi_lo_F32)));
+    
+    lane_f32 half_pi = LaneF32_Set1(half_pi_F32);
+    lane_f32 negative_half_pi = LaneF32_Set1(-half_pi_F32);
+    x = LaneF32_Select(LaneF32_GreaterThan(x, half_pi), LaneF32_Subtract(LaneF32_Set1(pi_F32), x), x);
+    x = LaneF32_Select(LaneF32_LessThan(x, negative_half_pi), LaneF32_Subtract(LaneF32_Set1(-pi_F32), x), x);
+    
+    lane_f32 x2 = LaneF32_Multiply(x, x);
+    lane_f32 p = LaneF32_Set1(sin_c11_F32);
+    p = LaneF32_MulAdd(p, x2, LaneF32_Set1(sin_c9_F32));
+    p = LaneF32_MulAdd(p, x2, LaneF32_Set1(sin_c7_F32));
+    p = LaneF32_MulAdd(p, x2, LaneF32_Set1(sin_c5_F32));
+    p = LaneF32_MulAdd(p, x2, LaneF32_Set1(sin_c3_F32));
+    lane_f32 result = LaneF32_MulAdd(LaneF32_Multiply(x, x2), p, x);
+    return(result);
+}
+
+inline lane_f32
+LaneF32_CosApprox(lane_f32 x)
+{
+    lane_f32 result = LaneF32_SinApprox(LaneF32_Add(x, LaneF32_Set1(half_pi_F32)));
+    return(result);
+}
+
+inline lane_f32
+LaneF32_Abs(lane_f32 a)
+{
+    lane_f32 result = LaneF32_FromBits(LaneU32_And(LaneU32_FromBits(a), LaneU32_Set1(0x7FFFFFFF)));
+    return(result);
+}
+
+inline lane_f32
+LaneF32_Log2Approx(lane_f32 x)
+{
+    lane_u32 bits = LaneU32_FromBits(x);
+    lane_u32 exponent_bits = LaneU32_And(LaneU32_ShiftRight(bits, 23), LaneU32_Set1(0xFF));
+    lane_f32 exponent = LaneF32_FromS32(LaneU32_Subtract(exponent_bits, LaneU32_Set1(float_exponent_bias_U32)));
+    lane_f32 m = LaneF32_FromBits(LaneU32_Or(LaneU32_And(bits, LaneU32_Set1(0x007FFFFF)), LaneU32_Set1(0x3F800000)));
+    
+    lane_u32 above_sqrt2 = LaneF32_GreaterThan(m, LaneF32_Set1(log2_sqrt2_F32));
+    m = LaneF32_Select(above_sqrt2, LaneF32_Multiply(m, LaneF32_Set1(0.5f)), m);
+    exponent = LaneF32_Select(above_sqrt2, LaneF32_Add(exponent, LaneF32_Set1(1.0f)), exponent);
+    
+    lane_f32 one = LaneF32_Set1(1.0f);
+    lane_f32 t = LaneF32_Divide(LaneF32_Subtract(m, one), LaneF32_Add(m, one));
+    lane_f32 t2 = LaneF32_Multiply(t, t);
+    lane_f32 p = LaneF32_Set1(1.0f / 7.0f);
+    p = LaneF32_MulAdd(p, t2, LaneF32_Set1(1.0f / 5.0f));
+    p = LaneF32_MulAdd(p, t2, LaneF32_Set1(1.0f / 3.0f));
+    p = LaneF32_MulAdd(p, t2, one);
+    lane_f32 result = LaneF32_MulAdd(LaneF32_Multiply(t, p), LaneF32_Set1(log2_scale_F32), exponent);
+    return(result);
+}
+
+inline lane_f32
+LaneF32_Exp2Approx(lane_f32 x)
+{
+    x = LaneF32_Max(x, LaneF32_Set1(exp2_min_F32));
+    x = LaneF32_Min(x, LaneF32_Set1(exp2_max_F32));
+    
+    lane_f32 magic = LaneF32_Set1(round_magic_F32);
+    lane_f32 biased = LaneF32_Add(x, magic);
+    lane_f32 k = LaneF32_Subtract(biased, magic);
+    lane_f32 g = LaneF32_Multiply(LaneF32_Subtract(x, k), LaneF32_Set1(exp2_ln2_F32));
+    
+    lane_f32 one = LaneF32_Set1(1.0f);
+    lane_f32 p = LaneF32_Set1(1.0f / 720.0f);
+    p = LaneF32_MulAdd(p, g, LaneF32_Set1(1.0f / 120.0f));
+    p = LaneF32_MulAdd(p, g, LaneF32_Set1(1.0f / 24.0f));
+    p = LaneF32_MulAdd(p, g, LaneF32_Set1(1.0f / 6.0f));
+    p = LaneF32_MulAdd(p, g, LaneF32_Set1(0.5f));
+    p = LaneF32_MulAdd(p, g, one);
+    p = LaneF32_MulAdd(p, g, one);
+    
+    lane_u32 k_bits = LaneU32_Subtract(LaneU32_FromBits(biased), LaneU32_Set1(round_magic_bits_U32));
+    lane_f32 scale = LaneF32_FromBits(LaneU32_ShiftLeft(LaneU32_Add(k_bits, LaneU32_Set1(float_exponent_bias_U32)), 23));
+    lane_f32 result = LaneF32_Multiply(p, scale);
+    return(result);
+}
+
+inline lane_f32
+LaneF32_PowApprox(lane_f32 x, lane_f32 y)
+{
+    lane_f32 zero = LaneF32_Set1(0.0f);
+    lane_u32 positive = LaneF32_GreaterThan(x, zero);
+    
+    // NOTE(christian): feed 1 to the log for lanes that end up masked, keeps them out of denormal land.
+    lane_f32 safe_x = LaneF32_Select(positive, x, LaneF32_Set1(1.0f));
+    lane_f32 result = LaneF32_Exp2Approx(LaneF32_Multiply(y, LaneF32_Log2Approx(safe_x)));
+    result = LaneF32_Select(positive, result, zero);
+    return(result);
+}
+
+inline lane_f32
+LaneF32_EaseOutQuart(lane_f32 t)
+{
+    lane_f32 one = LaneF32_Set1(1.0f);
+    lane_f32 u = LaneF32_Subtract(one, t);
+    u = LaneF32_Multiply(u, u);
+    lane_f32 result = LaneF32_Subtract(one, LaneF32_Multiply(u, u));
+    return(result);
+}
+
+inline lane_f32
+LaneF32_EaseInQuart(lane_f32 t)
+{
+    lane_f32 result = LaneF32_Multiply(LaneF32_Multiply(LaneF32_Multiply(t, t), t), t);
+    return(result);
+}
+
+inline lane_v2f
+LaneV2F_Load(f32 *x, f32 *y)
+{
+    lane_v2f result;
+    result.x = LaneF32_Load(x);
+    result.y = LaneF32_Load(y);
+    return(result);
+}
+
+inline void
+LaneV2F_Store(f32 *x, f32 *y, lane_v2f a)
+{
+    LaneF32_Store(x, a.x);
+    LaneF32_Store(y, a.y);
+}
+
+inline lane_v2f
+LaneV2F_Add(lane_v2f a, lane_v2f b)
+{
+    lane_v2f result;
+    result.x = LaneF32_Add(a.x, b.x);
+    result.y = LaneF32_Add(a.y, b.y);
+    return(result);
+}
+
+inline lane_v2f
+LaneV2F_Subtract(lane_v2f a, lane_v2f b)
+{
+    lane_v2f result;
+    result.x = LaneF32_Subtract(a.x, b.x);
+    result.y = LaneF32_Subtract(a.y, b.y);
+    return(result);
+}
+
+inline lane_v2f
+LaneV2F_Scale(lane_v2f a, lane_f32 scale)
+{
+    lane_v2f result;
+    result.x = LaneF32_Multiply(a.x, scale);
+    result.y = LaneF32_Multiply(a.y, scale);
+    return(result);
+}
+
+inline lane_v2f
+LaneV2F_MulAdd(lane_v2f a, lane_f32 scale, lane_v2f b)
+{
+    lane_v2f result;
+    result.x = LaneF32_MulAdd(a.x, scale, b.x);
+    result.y = LaneF32_MulAdd(a.y, scale, b.y);
+    return(result);
+}
+
+inline lane_f32
+LaneV2F_LengthSquared(lane_v2f a)
+{
+    lane_f32 result = LaneF32_MulAdd(a.x, a.x, LaneF32_Multiply(a.y, a.y));
+    return(result);
+}
+
+//~ NOTE(christian): batches
+function void
+BatchF32_EaseOutQuart(f32 *out, f32 *t, u32 count)
+{
+    u32 index = 0;
+    for (; (index + lane_width) <= count; index += lane_width)
+    {
+        LaneF32_Store(out + index, LaneF32_EaseOutQuart(LaneF32_Load(t + index)));
+    }
+    
+    for (; index < count; ++index)
+    {
+        out[index] = EaseOutQuart(t[index]);
+    }
+}
+
+function void
+BatchF32_EaseInQuart(f32 *out, f32 *t, u32 count)
+{
+    u32 index = 0;
+    for (; (index + lane_width) <= count; index += lane_width)
+    {
+        LaneF32_Store(out + index, LaneF32_EaseInQuart(LaneF32_Load(t + index)));
+    }
+    
+    for (; index < count; ++index)
+    {
+        out[index] = EaseInQuart(t[index]);
+    }
+}
+
+function void
+BatchF32_SinCosApprox(f32 *out_sin, f32 *out_cos, f32 *angles, u32 count)
+{
+    u32 index = 0;
+    for (; (index + lane_width) <= count; index += lane_width)
+    {
+        lane_f32 angle = LaneF32_Load(angles + index);
+        LaneF32_Store(out_sin + index, LaneF32_SinApprox(angle));
+        LaneF32_Store(out_cos + index, LaneF32_CosApprox(angle));
+    }
+    
+    for (; index < count; ++index)
+    {
+        out_sin[index] = SinApproxF32(angles[index]);
+        out_cos[index] = CosApproxF32(angles[index]);
+    }
+}
+
+// NOTE(christian): x += dx * scale, y += dy * scale
+function void
+BatchV2F_MulAdd(f32 *x, f32 *y, f32 *dx, f32 *dy, f32 scale, u32 count)
+{
+    lane_f32 scale_wide = LaneF32_Set1(scale);
+    u32 index = 0;
+    for (; (index + lane_width) <= count; index += lane_width)
+    {
+        lane_v2f p = LaneV2F_Load(x + index, y + index);
+        lane_v2f dp = LaneV2F_Load(dx + index, dy + index);
+        LaneV2F_Store(x + index, y + index, LaneV2F_MulAdd(dp, scale_wide, p));
+    }
+    
+    for (; index < count; ++index)
+    {
+        x[index] = dx[index] * scale + x[index];
+        y[index] = dy[index] * scale + y[index];
+    }
+}
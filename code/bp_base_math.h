@@ -39,18 +39,46 @@ typedef union m44
     f32 m[4][4];
 } m44;
 
+// NOTE(christian): the instance every batch holds and every backend reads. positions and axes are
+// two s12.4 fixed point halves per u32 (x low, y high), which covers +-2048 pixels in sixteenths.
+// style is roundness and thickness as u10.4 in bits 0-13 and 14-27, and the QuadFlags in bits
+// 28-31. colours are rgba8, r in the low byte, ordered top left, top right, bottom left, bottom right.
+//
+// it's 32 bytes on purpose, not less. the four corner colours are half of it and gradients need all
+// four, so anything smaller gives up gradients or position precision. 32 is two to a cache line,
+// and eight u32s is one LaneU32_StoreInterleaved8, which is how the particle kernel writes them.
+//
+// with QuadFlag_UniformColour set only colours[0] is read, and colours[1] and colours[2] hold the
+// glyph atlas rect the quad spans as unorm16 pairs. the colour is multiplied by the texel, and an
+// all zero rect samples the atlas's white texel, which is every quad that isn't text. so a quad
+// is either a gradient or textured, never both. the Quad_Pack / Quad_Unpack helpers in bp_render
+// go to and from floats.
 typedef struct Quad
 {
-    v2f origin;
-    v2f x_axis;
-    v2f y_axis;
-    v4f colours[4];
-    
-    f32 side_roundness;
-    f32 side_thickness;
+    u32 origin;
+    u32 x_axis;
+    u32 y_axis;
+    u32 style;
+    u32 colours[4];
 } Quad;
 
+typedef enum Quad_Flags
+{
+    QuadFlag_UniformColour = (1 << 0),
+} Quad_Flags;
+
+#define quad_position_scale 16.0f
+#define quad_position_min -2048.0f
+#define quad_position_max 2047.9375f
+#define quad_style_scale 16.0f
+#define quad_style_max 1023.9375f
+#define quad_style_thickness_shift 14
+#define quad_style_flags_shift 28
+#define quad_uv_scale 65535.0f
+
 #define two_pi_F32 6.28318531f
+#define pi_F32 3.14159265f
+#define half_pi_F32 1.57079633f
 
 #define V2F(x,y) (v2f){x,y}
 #define V4F(x,y,z,w) (v4f){x,y,z,w}
@@ -62,6 +90,17 @@ inline f32 EaseInQuart(f32 t);
 inline f32 AbsoluteValueF32(f32 x);
 inline f32 ToRadians(f32 x);
 
+// NOTE(christian): approximations built only from mul/add/compare so the wide versions below
+// produce bit-identical results lane for lane.
+inline f32 RoundF32(f32 x);
+inline f32 SinApproxF32(f32 x);
+inline f32 CosApproxF32(f32 x);
+inline f32 RSqrtApproxF32(f32 x);
+inline f32 SqrtApproxF32(f32 x);
+inline f32 Log2ApproxF32(f32 x);
+inline f32 Exp2ApproxF32(f32 x);
+inline f32 PowApproxF32(f32 x, f32 y);
+
 //~ NOTE(christian): V2F
 inline v2f V2F_Scale(v2f a, f32 scale);
 inline v2f V2F_Add(v2f a, v2f b);
@@ -70,4 +109,97 @@ inline v2f V2F_Subtract(v2f a, v2f b);
 //~ NOTE(christian): matrices
 inline m44 Matrix4x4_Orthographic_LH_RM_Z01(f32 left, f32 right, f32 top, f32 bottom, f32 near, f32 far);
 inline m44 Matrix4x4_Orthographic_LH_CM_Z01(f32 left, f32 right, f32 top, f32 bottom, f32 near, f32 far);
+
+// NOTE(christian): rows times column vectors, like the _CM_ matrices above.
+inline m44 Matrix4x4_Multiply(m44 a, m44 b);
+inline v4f Matrix4x4_TransformV4F(m44 m, v4f v);
+function void Matrix4x4_TransformPointsV2F(m44 m, v2f *points, v2f *out, u32 count);
+
+//~ NOTE(christian): wide lanes
+// NOTE(christian): lane_width floats per op: 8 with AVX2, 4 with SSE2, 1 for the scalar fallback.
+// every op is plain IEEE mul/add (never fused), so all three give identical results per element.
+#if SIMD_AVX2
+# define lane_width 8
+typedef struct lane_f32 { __m256 v; } lane_f32;
+typedef struct lane_u32 { __m256i v; } lane_u32;
+#elif SIMD_SSE2
+# define lane_width 4
+typedef struct lane_f32 { __m128 v; } lane_f32;
+typedef struct lane_u32 { __m128i v; } lane_u32;
+#else
+# define lane_width 1
+typedef struct lane_f32 { f32 v; } lane_f32;
+typedef struct lane_u32 { u32 v; } lane_u32;
+#endif
+
+// NOTE(christian): structure of arrays, lane_width points at a time.
+typedef struct lane_v2f
+{
+    lane_f32 x;
+    lane_f32 y;
+} lane_v2f;
+
+inline lane_f32 LaneF32_Set1(f32 a);
+inline lane_f32 LaneF32_Load(f32 *a);
+inline void LaneF32_Store(f32 *dest, lane_f32 a);
+inline lane_f32 LaneF32_Add(lane_f32 a, lane_f32 b);
+inline lane_f32 LaneF32_Subtract(lane_f32 a, lane_f32 b);
+inline lane_f32 LaneF32_Multiply(lane_f32 a, lane_f32 b);
+inline lane_f32 LaneF32_Divide(lane_f32 a, lane_f32 b);
+inline lane_f32 LaneF32_MulAdd(lane_f32 a, lane_f32 b, lane_f32 c);
+inline lane_f32 LaneF32_Min(lane_f32 a, lane_f32 b);
+inline lane_f32 LaneF32_Max(lane_f32 a, lane_f32 b);
+inline lane_f32 LaneF32_Sqrt(lane_f32 a);
+inline lane_u32 LaneF32_GreaterThan(lane_f32 a, lane_f32 b);
+inline lane_u32 LaneF32_LessThan(lane_f32 a, lane_f32 b);
+inline lane_u32 LaneF32_GreaterEqual(lane_f32 a, lane_f32 b);
+inline lane_f32 LaneF32_Select(lane_u32 mask, lane_f32 a, lane_f32 b);
+inline lane_f32 LaneF32_Round(lane_f32 a);
+inline lane_f32 LaneF32_RSqrtApprox(lane_f32 a);
+inline lane_f32 LaneF32_SqrtApprox(lane_f32 a);
+inline lane_f32 LaneF32_SinApprox(lane_f32 a);
+inline lane_f32 LaneF32_CosApprox(lane_f32 a);
+inline lane_f32 LaneF32_Log2Approx(lane_f32 a);
+inline lane_f32 LaneF32_Exp2Approx(lane_f32 a);
+inline lane_f32 LaneF32_PowApprox(lane_f32 a, lane_f32 b);
+inline lane_f32 LaneF32_Abs(lane_f32 a);
+inline lane_f32 LaneF32_EaseOutQuart(lane_f32 t);
+inline lane_f32 LaneF32_EaseInQuart(lane_f32 t);
+
+// NOTE(christian): bit casts between the two, signed int to float, and plain integer ops for masks and exponents.
+inline lane_f32 LaneF32_FromBits(lane_u32 a);
+inline lane_u32 LaneU32_FromBits(lane_f32 a);
+inline lane_f32 LaneF32_FromS32(lane_u32 a);
+// NOTE(christian): float to signed int, rounded to nearest even. the lanes only agree for |a| < 2^22.
+inline lane_u32 LaneU32_FromF32(lane_f32 a);
+inline lane_u32 LaneU32_Set1(u32 a);
+inline lane_u32 LaneU32_Add(lane_u32 a, lane_u32 b);
+inline lane_u32 LaneU32_Subtract(lane_u32 a, lane_u32 b);
+inline lane_u32 LaneU32_And(lane_u32 a, lane_u32 b);
+inline lane_u32 LaneU32_Or(lane_u32 a, lane_u32 b);
+inline lane_u32 LaneU32_ShiftLeft(lane_u32 a, u32 shift);
+inline lane_u32 LaneU32_ShiftRight(lane_u32 a, u32 shift);
+inline b32 LaneU32_AnyNonZero(lane_u32 mask);
+inline lane_u32 LaneU32_Load(u32 *a);
+inline void LaneU32_Store(u32 *dest, lane_u32 a);
+inline lane_u32 LaneU32_Xor(lane_u32 a, lane_u32 b);
+// NOTE(christian): full 32x32 -> 64 bit product per lane. returns the low halves, the high ones go to out_hi.
+inline lane_u32 LaneU32_MultiplyWide(lane_u32 a, lane_u32 b, lane_u32 *out_hi);
+
+inline lane_v2f LaneV2F_Load(f32 *x, f32 *y);
+inline void LaneV2F_Store(f32 *x, f32 *y, lane_v2f a);
+inline void LaneV2F_StoreInterleaved(v2f *dest, lane_v2f a);
+// NOTE(christian): lane i of a[0..7] goes to dest[8 * i .. 8 * i + 7]. lane_width runs of 8 u32, a Quad each.
+inline void LaneU32_StoreInterleaved8(u32 *dest, lane_u32 *a);
+inline lane_v2f LaneV2F_Add(lane_v2f a, lane_v2f b);
+inline lane_v2f LaneV2F_Subtract(lane_v2f a, lane_v2f b);
+inline lane_v2f LaneV2F_Scale(lane_v2f a, lane_f32 scale);
+inline lane_v2f LaneV2F_MulAdd(lane_v2f a, lane_f32 scale, lane_v2f b);
+inline lane_f32 LaneV2F_LengthSquared(lane_v2f a);
+
+//~ NOTE(christian): batches over arrays. tails run the scalar versions, which match the lanes.
+function void BatchF32_EaseOutQuart(f32 *out, f32 *t, u32 count);
+function void BatchF32_EaseInQuart(f32 *out, f32 *t, u32 count);
+function void BatchF32_SinCosApprox(f32 *out_sin, f32 *out_cos, f32 *angles, u32 count);
+function void BatchV2F_MulAdd(f32 *x, f32 *y, f32 *dx, f32 *dy, f32 scale, u32 count);
 #endif //BP_BASE_MATH_H
@@ -1,98 +1,565 @@
-global u32 g_random_u32_state = 17624813;
-global u64 g_random_u64_state = 17624813;
+#define random_philox_m0 0xD2511F53
+#define random_philox_m1 0xCD9E8D57
+#define random_philox_w0 0x9E3779B9
+#define random_philox_w1 0xBB67AE85
 
+// NOTE(christian): added to the key when deriving child stream ids, so those never equal a word the
+// parent stream hands out.
+#define random_split_key_tweak 0x6A09E667
+
+// NOTE(christian): 24 random bits are all an f32 in [0, 1) can hold.
+#define random_f32_unit_scale (1.0f / 16777216.0f)
+
+#define random_fill_chunk_words 256
+
+inline void
+Random_Philox4x32(u32 *counter, u32 *key, u32 *out)
+{
+    u32 c0 = counter[0];
+    u32 c1 = counter[1];
+    u32 c2 = counter[2];
+    u32 c3 = counter[3];
+    u32 k0 = key[0];
+    u32 k1 = key[1];
+    for (u32 round = 0; round < random_philox_rounds; ++round)
+    {
+        u64 product0 = (u64)random_philox_m0 * (u64)c0;
+        u64 product1 = (u64)random_philox_m1 * (u64)c2;
+        c0 = (u32)(product1 >> 32) ^ c1 ^ k0;
+        c1 = (u32)product1;
+        c2 = (u32)(product0 >> 32) ^ c3 ^ k1;
+        c3 = (u32)product0;
+        k0 += random_philox_w0;
+        k1 += random_philox_w1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+// NOTE(christian): writes block_count whole blocks starting at stream->block. lane_width blocks go
+// through the rounds side by side (one counter per lane) and get transposed back into stream order.
+// groups where the low counter word would wrap inside the group take the scalar path.
 function void
-SeedRandom_U32(u32 seed)
+RandomStream_GenerateBlocks(Random_Stream *stream, u32 *out, u64 block_count)
+{
+    local u32 lane_offsets[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    while (block_count)
+    {
+        u32 block_lo = (u32)stream->block;
+        u32 block_hi = (u32)(stream->block >> 32);
+        if ((lane_width > 1) && (block_count >= lane_width) && (block_lo <= (0xFFFFFFFF - (lane_width - 1))))
+        {
+            lane_u32 c0 = LaneU32_Add(LaneU32_Set1(block_lo), LaneU32_Load(lane_offsets));
+            lane_u32 c1 = LaneU32_Set1(block_hi);
+            lane_u32 c2 = LaneU32_Set1(stream->stream_id[0]);
+            lane_u32 c3 = LaneU32_Set1(stream->stream_id[1]);
+            lane_u32 m0 = LaneU32_Set1(random_philox_m0);
+            lane_u32 m1 = LaneU32_Set1(random_philox_m1);
+            u32 k0 = stream->key[0];
+            u32 k1 = stream->key[1];
+            for (u32 round = 0; round < random_philox_rounds; ++round)
+            {
+                lane_u32 hi0;
+                lane_u32 hi1;
+                lane_u32 lo0 = LaneU32_MultiplyWide(c0, m0, &hi0);
+                lane_u32 lo1 = LaneU32_MultiplyWide(c2, m1, &hi1);
+                c0 = LaneU32_Xor(LaneU32_Xor(hi1, c1), LaneU32_Set1(k0));
+                c1 = lo1;
+                c2 = LaneU32_Xor(LaneU32_Xor(hi0, c3), LaneU32_Set1(k1));
+                c3 = lo0;
+                k0 += random_philox_w0;
+                k1 += random_philox_w1;
+            }
+            
+            u32 words[random_block_words][lane_width];
+            LaneU32_Store(words[0], c0);
+            LaneU32_Store(words[1], c1);
+            LaneU32_Store(words[2], c2);
+            LaneU32_Store(words[3], c3);
+            for (u32 lane_index = 0; lane_index < lane_width; ++lane_index)
+            {
+                out[0] = words[0][lane_index];
+                out[1] = words[1][lane_index];
+                out[2] = words[2][lane_index];
+                out[3] = words[3][lane_index];
+                out += random_block_words;
+            }
+            stream->block += lane_width;
+            block_count -= lane_width;
+        }
+        else
+        {
+            u32 counter[4] = { block_lo, block_hi, stream->stream_id[0], stream->stream_id[1] };
+            Random_Philox4x32(counter, stream->key, out);
+            out += random_block_words;
+            ++stream->block;
+            --block_count;
+        }
+    }
+}
+
+function Random_Stream
+RandomStream_Make(u64 seed, u64 stream_id)
+{
+    Random_Stream result = {0};
+    result.key[0] = (u32)seed;
+    result.key[1] = (u32)(seed >> 32);
+    result.stream_id[0] = (u32)stream_id;
+    result.stream_id[1] = (u32)(stream_id >> 32);
+    result.buffer_index = random_buffer_words;
+    return(result);
+}
+
+// NOTE(christian): same seed, a stream id hashed from the parent's id and child_index. the same
+// parent and index always give the same child, however many numbers either has handed out.
+function Random_Stream
+RandomStream_Split(Random_Stream *stream, u64 child_index)
+{
+    u32 counter[4] = { (u32)child_index, (u32)(child_index >> 32), stream->stream_id[0], stream->stream_id[1] };
+    u32 key[2] = { stream->key[0] + random_split_key_tweak, stream->key[1] };
+    u32 words[random_block_words];
+    Random_Philox4x32(counter, key, words);
+    
+    Random_Stream result = *stream;
+    result.stream_id[0] = words[0];
+    result.stream_id[1] = words[1];
+    result.block = 0;
+    result.buffer_index = random_buffer_words;
+    return(result);
+}
+
+// NOTE(christian): positions count u32s from the start of the stream. a u64 or f32 takes one or two of them.
+function void
+RandomStream_Seek(Random_Stream *stream, u64 word_position)
+{
+    stream->block = word_position / random_block_words;
+    stream->buffer_index = random_buffer_words;
+    u32 word_in_block = (u32)(word_position % random_block_words);
+    if (word_in_block)
+    {
+        RandomStream_GenerateBlocks(stream, stream->buffer, random_buffer_blocks);
+        stream->buffer_index = word_in_block;
+    }
+}
+
+inline u64
+RandomStream_Tell(Random_Stream *stream)
+{
+    u64 result = stream->block * random_block_words - (random_buffer_words - stream->buffer_index);
+    return(result);
+}
+
+inline u32
+RandomStream_U32(Random_Stream *stream)
+{
+    if (stream->buffer_index == random_buffer_words)
+    {
+        RandomStream_GenerateBlocks(stream, stream->buffer, random_buffer_blocks);
+        stream->buffer_index = 0;
+    }
+    return(stream->buffer[stream->buffer_index++]);
+}
+
+inline u64
+RandomStream_U64(Random_Stream *stream)
+{
+    u64 lo = RandomStream_U32(stream);
+    u64 hi = RandomStream_U32(stream);
+    return((hi << 32) | lo);
+}
+
+// NOTE(christian): uniform in [0, bound). Lemire's multiply and shift, with the rejection step that
+// removes the bias. bound 0 returns 0.
+function u32
+RandomStream_U32Below(Random_Stream *stream, u32 bound)
+{
+    u64 product = (u64)RandomStream_U32(stream) * (u64)bound;
+    if ((u32)product < bound)
+    {
+        u32 threshold = (0u - bound) % bound;
+        while ((u32)product < threshold)
+        {
+            product = (u64)RandomStream_U32(stream) * (u64)bound;
+        }
+    }
+    return((u32)(product >> 32));
+}
+
+// NOTE(christian): [0, 1)
+inline f32
+RandomStream_F32(Random_Stream *stream)
+{
+    return((f32)(RandomStream_U32(stream) >> 8) * random_f32_unit_scale);
+}
+
+// NOTE(christian): [min, max). written as min + (max - min) * t so the lanes in FillF32Range round the same.
+inline f32
+RandomStream_F32Range(Random_Stream *stream, f32 min, f32 max)
+{
+    f32 t = RandomStream_F32(stream);
+    return(min + (max - min) * t);
+}
+
+// NOTE(christian): [-1, 1)
+inline f32
+RandomStream_F32Bilateral(Random_Stream *stream)
+{
+    return(RandomStream_F32Range(stream, -1.0f, 1.0f));
+}
+
+// NOTE(christian): uses the approximations, so FillUnitV2F matches it exactly.
+inline v2f
+RandomStream_UnitV2F(Random_Stream *stream)
+{
+    f32 angle = RandomStream_F32Range(stream, 0.0f, two_pi_F32);
+    v2f result = { CosApproxF32(angle), SinApproxF32(angle) };
+    return(result);
+}
+
+function void
+RandomStream_FillU32(Random_Stream *stream, u32 *out, u32 count)
+{
+    while (count && (stream->buffer_index < random_buffer_words))
+    {
+        *out++ = stream->buffer[stream->buffer_index++];
+        --count;
+    }
+    
+    u32 block_count = count / random_block_words;
+    RandomStream_GenerateBlocks(stream, out, block_count);
+    out += block_count * random_block_words;
+    count -= block_count * random_block_words;
+    
+    if (count)
+    {
+        RandomStream_GenerateBlocks(stream, stream->buffer, random_buffer_blocks);
+        stream->buffer_index = 0;
+        while (count--)
+        {
+            *out++ = stream->buffer[stream->buffer_index++];
+        }
+    }
+}
+
+function void
+RandomStream_FillF32Range(Random_Stream *stream, f32 *out, u32 count, f32 min, f32 max)
+{
+    u32 words[random_fill_chunk_words];
+    lane_f32 scale = LaneF32_Set1(random_f32_unit_scale);
+    lane_f32 min_wide = LaneF32_Set1(min);
+    lane_f32 range_wide = LaneF32_Set1(max - min);
+    while (count)
+    {
+        u32 chunk_count = Min(count, random_fill_chunk_words);
+        RandomStream_FillU32(stream, words, chunk_count);
+        
+        u32 index = 0;
+        for (; (index + lane_width) <= chunk_count; index += lane_width)
+        {
+            lane_f32 t = LaneF32_Multiply(LaneF32_FromS32(LaneU32_ShiftRight(LaneU32_Load(words + index), 8)), scale);
+            LaneF32_Store(out + index, LaneF32_Add(min_wide, LaneF32_Multiply(range_wide, t)));
+        }
+        
+        for (; index < chunk_count; ++index)
+        {
+            f32 t = (f32)(words[index] >> 8) * random_f32_unit_scale;
+            out[index] = min + (max - min) * t;
+        }
+        
+        out += chunk_count;
+        count -= chunk_count;
+    }
+}
+
+function void
+RandomStream_FillF32(Random_Stream *stream, f32 *out, u32 count)
+{
+    RandomStream_FillF32Range(stream, out, count, 0.0f, 1.0f);
+}
+
+function void
+RandomStream_FillUnitV2F(Random_Stream *stream, v2f *out, u32 count)
 {
-    g_random_u32_state = seed;
+    f32 angles[random_fill_chunk_words];
+    f32 sines[random_fill_chunk_words];
+    f32 cosines[random_fill_chunk_words];
+    while (count)
+    {
+        u32 chunk_count = Min(count, random_fill_chunk_words);
+        RandomStream_FillF32Range(stream, angles, chunk_count, 0.0f, two_pi_F32);
+        BatchF32_SinCosApprox(sines, cosines, angles, chunk_count);
+        for (u32 index = 0; index < chunk_count; ++index)
+        {
+            out[index].x = cosines[index];
+            out[index].y = sines[index];
+        }
+        
+        out += chunk_count;
+        count -= chunk_count;
+    }
+}
+
+//~ NOTE(christian): per thread streams
+// NOTE(christian): the seed is two words behind a sequence count. the count is odd while
+// SeedRandom_U64 is writing, and every finished seed leaves it even and higher, so each thread
+// rekeys its stream on its next number. a thread that reads the same even count before and after
+// both words has a whole seed. seed from one thread at a time.
+global volatile u32 g_random_seed_lo = 17624813;
+global volatile u32 g_random_seed_hi = 0;
+global volatile u32 g_random_seed_sequence = 2;
+global u32 g_random_thread_count;
+
+global per_thread Random_Stream tl_random_stream;
+global per_thread u32 tl_random_seed_sequence;
+global per_thread u32 tl_random_thread_number;
+
+function Random_Stream *
+Random_ThreadStream(void)
+{
+    u32 sequence = AtomicLoadU32(&g_random_seed_sequence);
+    if (tl_random_seed_sequence != sequence)
+    {
+        u64 seed;
+        for (;;)
+        {
+            sequence = AtomicLoadU32(&g_random_seed_sequence);
+            seed = ((u64)AtomicLoadU32(&g_random_seed_hi) << 32) | AtomicLoadU32(&g_random_seed_lo);
+            if (!(sequence & 1) && (AtomicLoadU32(&g_random_seed_sequence) == sequence))
+            {
+                break;
+            }
+            SpinPause();
+        }
+        
+        if (!tl_random_thread_number)
+        {
+            tl_random_thread_number = AtomicIncrementU32(&g_random_thread_count);
+        }
+        tl_random_stream = RandomStream_Make(seed, tl_random_thread_number - 1);
+        tl_random_seed_sequence = sequence;
+    }
+    return(&tl_random_stream);
 }
 
 function void
 SeedRandom_U64(u64 seed)
 {
-    g_random_u64_state = seed;
+    AtomicIncrementU32(&g_random_seed_sequence);
+    AtomicStoreU32(&g_random_seed_lo, (u32)seed);
+    AtomicStoreU32(&g_random_seed_hi, (u32)(seed >> 32));
+    AtomicIncrementU32(&g_random_seed_sequence);
+}
+
+function void
+SeedRandom_U32(u32 seed)
+{
+    SeedRandom_U64(seed);
 }
 
 function u32
 Random_U32(void)
 {
-    u32 result = g_random_u32_state;
-    result ^= result << 13u;
-    result ^= result << 17u;
-    result ^= result << 5u;
-    return g_random_u32_state = result;
+    return(RandomStream_U32(Random_ThreadStream()));
 }
 
 function u64
 Random_U64(void)
 {
-    u64 result = g_random_u64_state;
-    result ^= result << 13u;
-    result ^= result << 17u;
-    result ^= result << 5u;
-    return g_random_u64_state = result;
+    return(RandomStream_U64(Random_ThreadStream()));
 }
 
-// TODO(christian): UTF-16 variant
+//~ NOTE(christian): unicode
+#define utf8_table_byte(x) ((char)(x))
+
+// NOTE(christian): value can't be 0.
+inline u32
+String_CountTrailingZeros(u32 value)
+{
+#if COMPILER_MSVC
+    unsigned long index;
+    _BitScanForward(&index, value);
+    u32 result = (u32)index;
+#else
+    u32 result = (u32)__builtin_ctz(value);
+#endif
+    return(result);
+}
+
+// NOTE(christian): how many of the string_wide_block bytes at str are ascii before the first that isn't.
+inline u32
+String_ASCIIPrefix(u8 *str)
+{
+    u32 result = string_wide_block;
+#if SIMD_AVX2
+    u32 mask = (u32)_mm256_movemask_epi8(_mm256_loadu_si256((__m256i *)str));
+    if (mask)
+    {
+        result = String_CountTrailingZeros(mask);
+    }
+#elif SIMD_SSE2
+    u32 mask = (u32)_mm_movemask_epi8(_mm_loadu_si128((__m128i *)str));
+    if (mask)
+    {
+        result = String_CountTrailingZeros(mask);
+    }
+#else
+    u64 word;
+    MemoryCopy(&word, str, sizeof(word));
+    u64 mask = word & 0x8080808080808080llu;
+    if (mask)
+    {
+        u32 low = (u32)mask;
+        result = low ? (String_CountTrailingZeros(low) / 8) : (4 + String_CountTrailingZeros((u32)(mask >> 32)) / 8);
+    }
+#endif
+    return(result);
+}
+
+inline void
+String_WidenASCIIBlockU32(u32 *dest, u8 *str)
+{
+#if SIMD_AVX2
+    for (u32 offset = 0; offset < string_wide_block; offset += 8)
+    {
+        __m128i bytes = _mm_loadl_epi64((__m128i *)(str + offset));
+        _mm256_storeu_si256((__m256i *)(dest + offset), _mm256_cvtepu8_epi32(bytes));
+    }
+#elif SIMD_SSE2
+    __m128i zero = _mm_setzero_si128();
+    __m128i bytes = _mm_loadu_si128((__m128i *)str);
+    __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+    __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+    _mm_storeu_si128((__m128i *)(dest + 0), _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128((__m128i *)(dest + 4), _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128((__m128i *)(dest + 8), _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128((__m128i *)(dest + 12), _mm_unpackhi_epi16(hi, zero));
+#else
+    for (u32 index = 0; index < string_wide_block; ++index)
+    {
+        dest[index] = str[index];
+    }
+#endif
+}
+
+inline void
+String_WidenASCIIBlockU16(u16 *dest, u8 *str)
+{
+#if SIMD_AVX2
+    for (u32 offset = 0; offset < string_wide_block; offset += 16)
+    {
+        __m128i bytes = _mm_loadu_si128((__m128i *)(str + offset));
+        _mm256_storeu_si256((__m256i *)(dest + offset), _mm256_cvtepu8_epi16(bytes));
+    }
+#elif SIMD_SSE2
+    __m128i zero = _mm_setzero_si128();
+    __m128i bytes = _mm_loadu_si128((__m128i *)str);
+    _mm_storeu_si128((__m128i *)(dest + 0), _mm_unpacklo_epi8(bytes, zero));
+    _mm_storeu_si128((__m128i *)(dest + 8), _mm_unpackhi_epi8(bytes, zero));
+#else
+    for (u32 index = 0; index < string_wide_block; ++index)
+    {
+        dest[index] = str[index];
+    }
+#endif
+}
+
+// NOTE(christian): reads at most capacity bytes. a well formed sequence gives its codepoint and
+// byte_count. anything else gives U+FFFD with byte_count 0, and next_in_str skips the maximal
+// subpart of the bad sequence (the lead plus whatever continuation bytes were still allowed after
+// it, the same replacement the WHATWG decoder makes). overlongs, surrogates and anything past
+// U+10FFFF are ill formed. capacity 0 gives codepoint 0, byte_count 0 and doesn't move.
 function String_Decode
 StringDecode_UTF8(u8 *str, u32 capacity)
 {
-    String_Decode result = { 0, 0 };
-    
-    local const u8 lengths_table[] = 
+    String_Decode result = { 0, 0, str };
+    if (!capacity)
     {
-        1, 1, 1, 1, 1, 1, 1, 1,
-        1, 1, 1, 1, 1, 1, 1, 1,
-        0, 0, 0, 0, 0, 0, 0, 0,
-        2, 2, 2, 2, 3, 3, 4, 0
-    };
+        return(result);
+    }
     
-    local const u8 masks_table_based_on_length[] =
+    u8 lead = str[0];
+    u32 length = 0;
+    u32 codepoint = 0;
+    u8 second_min = 0x80;
+    u8 second_max = 0xBF;
+    if (lead < 0x80)
     {
-        0x00, 0x7F, 0x1F, 0x0F, 0x07,
-    };
-    
-    local const u8 shifts_back_table_based_on_length[] =
+        length = 1;
+        codepoint = lead;
+    }
+    else if (lead < 0xC2)
     {
-        0, 18, 12, 6, 0
-    };
-    
-    result.byte_count = lengths_table[str[0] >> 3];
-    result.next_in_str = str + result.byte_count + !result.byte_count;
+        // NOTE(christian): stray continuation byte, or a two byte lead that can only be overlong.
+    }
+    else if (lead < 0xE0)
+    {
+        length = 2;
+        codepoint = lead & 0x1F;
+    }
+    else if (lead < 0xF0)
+    {
+        length = 3;
+        codepoint = lead & 0x0F;
+        second_min = (lead == 0xE0) ? 0xA0 : 0x80;
+        second_max = (lead == 0xED) ? 0x9F : 0xBF;
+    }
+    else if (lead < 0xF5)
+    {
+        length = 4;
+        codepoint = lead & 0x07;
+        second_min = (lead == 0xF0) ? 0x90 : 0x80;
+        second_max = (lead == 0xF4) ? 0x8F : 0xBF;
+    }
     
-    result.codepoint = (u32)(str[0] & masks_table_based_on_length[result.byte_count]) << 18u;
-    result.codepoint |= (u32)(str[1] & 0x3F) << 12u;
-    result.codepoint |= (u32)(str[2] & 0x3F) << 6u;
-    result.codepoint |= (u32)(str[3] & 0x3F) << 0u;
-    result.codepoint >>= shifts_back_table_based_on_length[result.byte_count];
+    u32 consumed = 1;
+    b32 valid = (length != 0);
+    for (u32 byte_index = 1; valid && (byte_index < length); ++byte_index)
+    {
+        u8 byte_min = (byte_index == 1) ? second_min : 0x80;
+        u8 byte_max = (byte_index == 1) ? second_max : 0xBF;
+        valid = (byte_index < capacity) && (str[byte_index] >= byte_min) && (str[byte_index] <= byte_max);
+        if (valid)
+        {
+            codepoint = (codepoint << 6) | (str[byte_index] & 0x3F);
+            ++consumed;
+        }
+    }
     
+    result.codepoint = valid ? codepoint : utf_replacement_codepoint;
+    result.byte_count = valid ? (u8)length : 0;
+    result.next_in_str = str + consumed;
     return(result);
 }
 
-// TODO(christian): UTF-16 variant
+// NOTE(christian): writes nothing and returns 0 for surrogates and anything past U+10FFFF.
 function u32
 StringEncode_UTF8(u8 *dest, u32 codepoint)
 {
     u32 byte_count_result = 0;
     
-    if (codepoint < 0xFFu)
+    if (codepoint < 0x80u)
     {
         dest[0] = (u8)codepoint;
         byte_count_result = 1;
     }
-    else if (codepoint < (0xFFFu))
+    else if (codepoint < 0x800u)
     {
         dest[0] = (u8)((codepoint >> 6) | 0xC0);
         dest[1] = (u8)((codepoint & 0x3F) | 0x80);
         byte_count_result = 2;
     }
-    else if (codepoint < 0xFFFFu)
+    else if (codepoint < 0x10000u)
     {
-        dest[0] = (u8)((codepoint >> 12) | 0xE0);
-        dest[1] = (u8)(((codepoint >> 6) & 0x3F) | 0x80);
-        dest[2] = (u8)(((codepoint >> 0) & 0x3F) | 0x80);
-        byte_count_result = 3;
-    } else if (codepoint < 0x200000u)
+        if ((codepoint < 0xD800u) || (codepoint > 0xDFFFu))
+        {
+            dest[0] = (u8)((codepoint >> 12) | 0xE0);
+            dest[1] = (u8)(((codepoint >> 6) & 0x3F) | 0x80);
+            dest[2] = (u8)(((codepoint >> 0) & 0x3F) | 0x80);
+            byte_count_result = 3;
+        }
+    } else if (codepoint < 0x110000u)
     {
         dest[0] = (u8)((codepoint >> 18) | 0xF0);
         dest[1] = (u8)(((codepoint >> 12) & 0x3F) | 0x80);
@@ -102,4 +569,407 @@ StringEncode_UTF8(u8 *dest, u32 codepoint)
     }
     
     return(byte_count_result);
-}
\ No newline at end of file
+}
+
+// NOTE(christian): one unit below U+10000, a surrogate pair above. same 0 for what UTF-16 can't hold.
+function u32
+StringEncode_UTF16(u16 *dest, u32 codepoint)
+{
+    u32 unit_count_result = 0;
+    
+    if (codepoint < 0x10000u)
+    {
+        if ((codepoint < 0xD800u) || (codepoint > 0xDFFFu))
+        {
+            dest[0] = (u16)codepoint;
+            unit_count_result = 1;
+        }
+    }
+    else if (codepoint < 0x110000u)
+    {
+        u32 offset = codepoint - 0x10000u;
+        dest[0] = (u16)(0xD800u | (offset >> 10));
+        dest[1] = (u16)(0xDC00u | (offset & 0x3FF));
+        unit_count_result = 2;
+    }
+    
+    return(unit_count_result);
+}
+
+#if SIMD_AVX2 || SIMD_SSE2
+// NOTE(christian): Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte". every
+// byte is checked against the one to three before it with three 16 entry table lookups (pshufb) on
+// the nibbles, which flags all the two byte errors at once. three and four byte sequences are
+// checked by whether the byte two or three back was a 3 or 4 byte lead. the tail goes through a zero
+// padded block, which also catches a sequence cut off by the end of the string.
+//
+// AVX2 builds do 32 bytes a step. pshufb is SSSE3, which x64 doesn't promise, so SSE2 builds compile
+// a 16 byte version for it on its own and only take it when the cpu has it.
+//
+// both return count when the string is valid. otherwise a character boundary at or before the first
+// error, the block that failed is rechecked from there with StringDecode_UTF8 to find the exact spot.
+#define utf8_too_short (1 << 0)
+#define utf8_too_long (1 << 1)
+#define utf8_overlong_3 (1 << 2)
+#define utf8_too_large (1 << 3)
+#define utf8_surrogate (1 << 4)
+#define utf8_overlong_2 (1 << 5)
+#define utf8_too_large_1000 (1 << 6)
+#define utf8_overlong_4 (1 << 6)
+#define utf8_two_continuations (1 << 7)
+#define utf8_carry (utf8_too_short | utf8_too_long | utf8_two_continuations)
+
+global u8 utf8_byte_1_high_table[16] =
+{
+    utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+    utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+    utf8_two_continuations, utf8_two_continuations, utf8_two_continuations, utf8_two_continuations,
+    utf8_too_short | utf8_overlong_2,
+    utf8_too_short,
+    utf8_too_short | utf8_overlong_3 | utf8_surrogate,
+    utf8_too_short | utf8_too_large | utf8_too_large_1000 | utf8_overlong_4,
+};
+
+global u8 utf8_byte_1_low_table[16] =
+{
+    utf8_carry | utf8_overlong_3 | utf8_overlong_2 | utf8_overlong_4,
+    utf8_carry | utf8_overlong_2,
+    utf8_carry,
+    utf8_carry,
+    utf8_carry | utf8_too_large,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000 | utf8_surrogate,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+};
+
+global u8 utf8_byte_2_high_table[16] =
+{
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+    utf8_too_long | utf8_overlong_2 | utf8_two_continuations | utf8_overlong_3 | utf8_too_large_1000 | utf8_overlong_4,
+    utf8_too_long | utf8_overlong_2 | utf8_two_continuations | utf8_overlong_3 | utf8_too_large,
+    utf8_too_long | utf8_overlong_2 | utf8_two_continuations | utf8_surrogate | utf8_too_large,
+    utf8_too_long | utf8_overlong_2 | utf8_two_continuations | utf8_surrogate | utf8_too_large,
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+};
+
+// NOTE(christian): a block may only end in the middle of a sequence if the next one carries on. the
+// last 16 bytes of a block are checked against this.
+global u8 utf8_incomplete_max[16] =
+{
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+
+// NOTE(christian): an error can involve up to 3 bytes of the block before. back up past them, then
+// to the lead of the character we landed in.
+inline u32
+StringValidate_ErrorBoundary(u8 *str, u32 position)
+{
+    u32 result = (position > 3) ? (position - 3) : 0;
+    for (u32 back = 0; (back < 3) && result && ((str[result] & 0xC0) == 0x80); ++back)
+    {
+        --result;
+    }
+    return(result);
+}
+#endif
+
+#if SIMD_AVX2
+inline __m256i
+StringValidate_Previous(__m256i input, __m256i previous_input, s32 shift)
+{
+    // NOTE(christian): the byte shift has to cross the 128 bit halves, so the halves before each of
+    // input's halves are lined up first.
+    __m256i before = _mm256_permute2x128_si256(previous_input, input, 0x21);
+    __m256i result;
+    switch (shift)
+    {
+        case 1: result = _mm256_alignr_epi8(input, before, 15); break;
+        case 2: result = _mm256_alignr_epi8(input, before, 14); break;
+        default: result = _mm256_alignr_epi8(input, before, 13); break;
+    }
+    return(result);
+}
+
+function u32
+StringValidate_UTF8Wide(u8 *str, u32 count)
+{
+    __m256i byte_1_high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)utf8_byte_1_high_table));
+    __m256i byte_1_low_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)utf8_byte_1_low_table));
+    __m256i byte_2_high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)utf8_byte_2_high_table));
+    __m256i incomplete_max = _mm256_inserti128_si256(_mm256_set1_epi8(-1), _mm_loadu_si128((__m128i *)utf8_incomplete_max), 1);
+    
+    __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    __m256i previous_input = _mm256_setzero_si256();
+    __m256i previous_incomplete = _mm256_setzero_si256();
+    u32 position = 0;
+    for (;;)
+    {
+        u32 block_size = Min(count - position, 32);
+        __m256i input;
+        if (block_size == 32)
+        {
+            input = _mm256_loadu_si256((__m256i *)(str + position));
+        }
+        else
+        {
+            u8 padded[32] = {0};
+            MemoryCopy(padded, str + position, block_size);
+            input = _mm256_loadu_si256((__m256i *)padded);
+        }
+        
+        __m256i error;
+        if (!_mm256_movemask_epi8(input))
+        {
+            error = previous_incomplete;
+            previous_incomplete = _mm256_setzero_si256();
+        }
+        else
+        {
+            __m256i previous_1 = StringValidate_Previous(input, previous_input, 1);
+            __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(previous_1, 4), nibble_mask));
+            __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(previous_1, nibble_mask));
+            __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask));
+            __m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+            
+            __m256i previous_2 = StringValidate_Previous(input, previous_input, 2);
+            __m256i previous_3 = StringValidate_Previous(input, previous_input, 3);
+            __m256i is_third_byte = _mm256_subs_epu8(previous_2, _mm256_set1_epi8(utf8_table_byte(0xE0 - 0x80)));
+            __m256i is_fourth_byte = _mm256_subs_epu8(previous_3, _mm256_set1_epi8(utf8_table_byte(0xF0 - 0x80)));
+            __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte),
+                                                            _mm256_set1_epi8(utf8_table_byte(0x80)));
+            error = _mm256_xor_si256(must_be_continuation, special_cases);
+            previous_incomplete = _mm256_subs_epu8(input, incomplete_max);
+        }
+        
+        if (!_mm256_testz_si256(error, error))
+        {
+            return(StringValidate_ErrorBoundary(str, position));
+        }
+        
+        if (block_size < 32)
+        {
+            break;
+        }
+        previous_input = input;
+        position += 32;
+    }
+    return(count);
+}
+#elif SIMD_SSE2
+// NOTE(christian): cpuid leaf 1, ecx bit 9. asked once, the answer doesn't change.
+function b32
+CPU_HasSSSE3(void)
+{
+    local volatile u32 known;
+    u32 result = AtomicLoadU32(&known);
+    if (!result)
+    {
+#if COMPILER_MSVC
+        int registers[4];
+        __cpuid(registers, 1);
+        result = ((registers[2] >> 9) & 1) ? 2 : 1;
+#else
+        result = __builtin_cpu_supports("ssse3") ? 2 : 1;
+#endif
+        AtomicStoreU32(&known, result);
+    }
+    return(result == 2);
+}
+
+// NOTE(christian): the AVX2 version 16 bytes at a time. palignr doesn't have the 128 bit halves to
+// cross, so the previous bytes are a single alignr.
+function SIMD_TARGET_SSSE3 u32
+StringValidate_UTF8SSSE3(u8 *str, u32 count)
+{
+    __m128i byte_1_high_table = _mm_loadu_si128((__m128i *)utf8_byte_1_high_table);
+    __m128i byte_1_low_table = _mm_loadu_si128((__m128i *)utf8_byte_1_low_table);
+    __m128i byte_2_high_table = _mm_loadu_si128((__m128i *)utf8_byte_2_high_table);
+    __m128i incomplete_max = _mm_loadu_si128((__m128i *)utf8_incomplete_max);
+    
+    __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    __m128i zero = _mm_setzero_si128();
+    __m128i previous_input = zero;
+    __m128i previous_incomplete = zero;
+    u32 position = 0;
+    for (;;)
+    {
+        u32 block_size = Min(count - position, 16);
+        __m128i input;
+        if (block_size == 16)
+        {
+            input = _mm_loadu_si128((__m128i *)(str + position));
+        }
+        else
+        {
+            u8 padded[16] = {0};
+            MemoryCopy(padded, str + position, block_size);
+            input = _mm_loadu_si128((__m128i *)padded);
+        }
+        
+        __m128i error;
+        if (!_mm_movemask_epi8(input))
+        {
+            error = previous_incomplete;
+            previous_incomplete = zero;
+        }
+        else
+        {
+            __m128i previous_1 = _mm_alignr_epi8(input, previous_input, 15);
+            __m128i byte_1_high = _mm_shuffle_epi8(byte_1_high_table, _mm_and_si128(_mm_srli_epi16(previous_1, 4), nibble_mask));
+            __m128i byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(previous_1, nibble_mask));
+            __m128i byte_2_high = _mm_shuffle_epi8(byte_2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask));
+            __m128i special_cases = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+            
+            __m128i previous_2 = _mm_alignr_epi8(input, previous_input, 14);
+            __m128i previous_3 = _mm_alignr_epi8(input, previous_input, 13);
+            __m128i is_third_byte = _mm_subs_epu8(previous_2, _mm_set1_epi8(utf8_table_byte(0xE0 - 0x80)));
+            __m128i is_fourth_byte = _mm_subs_epu8(previous_3, _mm_set1_epi8(utf8_table_byte(0xF0 - 0x80)));
+            __m128i must_be_continuation = _mm_and_si128(_mm_or_si128(is_third_byte, is_fourth_byte),
+                                                         _mm_set1_epi8(utf8_table_byte(0x80)));
+            error = _mm_xor_si128(must_be_continuation, special_cases);
+            previous_incomplete = _mm_subs_epu8(input, incomplete_max);
+        }
+        
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, zero)) != 0xFFFF)
+        {
+            return(StringValidate_ErrorBoundary(str, position));
+        }
+        
+        if (block_size < 16)
+        {
+            break;
+        }
+        previous_input = input;
+        position += 16;
+    }
+    return(count);
+}
+#endif
+
+// NOTE(christian): the length of the longest valid prefix, count if the whole string is valid.
+function u32
+StringValidate_UTF8(u8 *str, u32 count)
+{
+    u32 position = 0;
+#if SIMD_AVX2
+    position = StringValidate_UTF8Wide(str, count);
+#elif SIMD_SSE2
+    if (CPU_HasSSSE3())
+    {
+        position = StringValidate_UTF8SSSE3(str, count);
+    }
+#endif
+    while (position < count)
+    {
+        if ((count - position) >= string_wide_block)
+        {
+            u32 ascii_count = String_ASCIIPrefix(str + position);
+            position += ascii_count;
+            if (ascii_count == string_wide_block)
+            {
+                continue;
+            }
+        }
+        
+        if (position < count)
+        {
+            String_Decode decode = StringDecode_UTF8(str + position, count - position);
+            if (!decode.byte_count)
+            {
+                break;
+            }
+            position += decode.byte_count;
+        }
+    }
+    return(position);
+}
+
+function String_Transcode
+StringTranscode_UTF8ToUTF32(u32 *dest, u32 dest_capacity, u8 *str, u32 count)
+{
+    String_Transcode result = {0};
+    while ((result.consumed < count) && (result.written < dest_capacity))
+    {
+        u32 bytes_left = count - result.consumed;
+        if ((bytes_left >= string_wide_block) && ((dest_capacity - result.written) >= string_wide_block))
+        {
+            u8 *at = str + result.consumed;
+            u32 ascii_count = String_ASCIIPrefix(at);
+            if (ascii_count == string_wide_block)
+            {
+                String_WidenASCIIBlockU32(dest + result.written, at);
+            }
+            else
+            {
+                for (u32 index = 0; index < ascii_count; ++index)
+                {
+                    dest[result.written + index] = at[index];
+                }
+            }
+            result.written += ascii_count;
+            result.consumed += ascii_count;
+            if (ascii_count == string_wide_block)
+            {
+                continue;
+            }
+        }
+        
+        String_Decode decode = StringDecode_UTF8(str + result.consumed, count - result.consumed);
+        dest[result.written++] = decode.codepoint;
+        result.consumed = (u32)(decode.next_in_str - str);
+        result.invalid_count += !decode.byte_count;
+    }
+    return(result);
+}
+
+function String_Transcode
+StringTranscode_UTF8ToUTF16(u16 *dest, u32 dest_capacity, u8 *str, u32 count)
+{
+    String_Transcode result = {0};
+    while ((result.consumed < count) && (result.written < dest_capacity))
+    {
+        u32 bytes_left = count - result.consumed;
+        if ((bytes_left >= string_wide_block) && ((dest_capacity - result.written) >= string_wide_block))
+        {
+            u8 *at = str + result.consumed;
+            u32 ascii_count = String_ASCIIPrefix(at);
+            if (ascii_count == string_wide_block)
+            {
+                String_WidenASCIIBlockU16(dest + result.written, at);
+            }
+            else
+            {
+                for (u32 index = 0; index < ascii_count; ++index)
+                {
+                    dest[result.written + index] = at[index];
+                }
+            }
+            result.written += ascii_count;
+            result.consumed += ascii_count;
+            if (ascii_count == string_wide_block)
+            {
+                continue;
+            }
+        }
+        
+        String_Decode decode = StringDecode_UTF8(str + result.consumed, count - result.consumed);
+        if ((decode.codepoint >= 0x10000u) && ((dest_capacity - result.written) < 2))
+        {
+            break;
+        }
+        result.written += StringEncode_UTF16(dest + result.written, decode.codepoint);
+        result.consumed = (u32)(decode.next_in_str - str);
+        result.invalid_count += !decode.byte_count;
+    }
+    return(result);
+}
@@ -4,12 +4,94 @@
 #define BP_BASE_UTIL_H
 
 //~ NOTE(christian): prngs
+// NOTE(christian): Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3").
+// a keyed hash of a 128 bit counter into 4 random words. nothing is carried from one block to the
+// next, so any position of any stream can be computed directly, streams never overlap, and a
+// stream can be cut into pieces that different threads fill in parallel with the same result.
+//
+// a stream is a key (the seed) plus the top half of the counter (the stream id). the bottom half
+// counts blocks. splitting derives a new stream id, seeking moves the block counter. a stream is
+// plain data and owned by whoever uses it, nothing here is shared between threads.
 #define seed_random_u32_max 0xFFFFFFFF
 #define seed_random_u64_max 0xFFFFFFFFFFFFFFFF
 
+#define random_philox_rounds 10
+#define random_block_words 4
+// NOTE(christian): single numbers come out of a buffer this many blocks deep, refilled with the wide path.
+#define random_buffer_blocks 8
+#define random_buffer_words (random_block_words*random_buffer_blocks)
+
+typedef struct Random_Stream
+{
+    u32 key[2];
+    u32 stream_id[2];
+    // NOTE(christian): the next block to generate. buffer holds the blocks right before it, words below
+    // buffer_index are already handed out.
+    u64 block;
+    u32 buffer[random_buffer_words];
+    u32 buffer_index;
+} Random_Stream;
+
+inline void Random_Philox4x32(u32 *counter, u32 *key, u32 *out);
+
+function Random_Stream RandomStream_Make(u64 seed, u64 stream_id);
+function Random_Stream RandomStream_Split(Random_Stream *stream, u64 child_index);
+function void RandomStream_Seek(Random_Stream *stream, u64 word_position);
+inline u64 RandomStream_Tell(Random_Stream *stream);
+
+inline u32 RandomStream_U32(Random_Stream *stream);
+inline u64 RandomStream_U64(Random_Stream *stream);
+function u32 RandomStream_U32Below(Random_Stream *stream, u32 bound);
+inline f32 RandomStream_F32(Random_Stream *stream);
+inline f32 RandomStream_F32Range(Random_Stream *stream, f32 min, f32 max);
+inline f32 RandomStream_F32Bilateral(Random_Stream *stream);
+inline v2f RandomStream_UnitV2F(Random_Stream *stream);
+
+// NOTE(christian): bulk versions. they hand out exactly what the same number of single calls would.
+function void RandomStream_FillU32(Random_Stream *stream, u32 *out, u32 count);
+function void RandomStream_FillF32(Random_Stream *stream, f32 *out, u32 count);
+function void RandomStream_FillF32Range(Random_Stream *stream, f32 *out, u32 count, f32 min, f32 max);
+function void RandomStream_FillUnitV2F(Random_Stream *stream, v2f *out, u32 count);
+
+// NOTE(christian): the calling thread's own stream. threads get stream ids in the order they first
+// ask for a number, so use a Random_Stream of your own for anything that has to replay. seeding is
+// safe while other threads draw, they pick the new seed up on their next number, but only one
+// thread may seed at a time.
 function void SeedRandom_U32(u32 seed);
 function void SeedRandom_U64(u64 seed);
 function u32 Random_U32(void);
 function u64 Random_U64(void);
 
+//~ NOTE(christian): unicode
+// NOTE(christian): decoding never reads past the count it's given and never fails. ill formed input
+// comes out as U+FFFD and is counted. a decode to UTF-32 or UTF-16 writes at most one unit per input
+// byte, so a dest as long as the input always has room. the bulk functions run ascii through
+// string_wide_block bytes at a time. validation checks 32 bytes a step whatever they are with AVX2,
+// and 16 with SSSE3, which SSE2 builds check the cpu for. without either only the ascii runs go wide.
+#define utf_replacement_codepoint 0xFFFD
+
+#if SIMD_AVX2
+# define string_wide_block 32
+#elif SIMD_SSE2
+# define string_wide_block 16
+#else
+# define string_wide_block 8
+#endif
+
+// NOTE(christian): consumed is how far into the input the transcode got. it stops early when dest is full.
+typedef struct String_Transcode
+{
+    u32 written;
+    u32 consumed;
+    u32 invalid_count;
+} String_Transcode;
+
+function String_Decode StringDecode_UTF8(u8 *str, u32 capacity);
+function u32 StringEncode_UTF8(u8 *dest, u32 codepoint);
+function u32 StringEncode_UTF16(u16 *dest, u32 codepoint);
+
+function u32 StringValidate_UTF8(u8 *str, u32 count);
+function String_Transcode StringTranscode_UTF8ToUTF32(u32 *dest, u32 dest_capacity, u8 *str, u32 count);
+function String_Transcode StringTranscode_UTF8ToUTF16(u16 *dest, u32 dest_capacity, u8 *str, u32 count);
+
 #endif //BP_BASE_UTIL_H
@@ -0,0 +1,1493 @@
+// NOTE(christian): microbenchmarks. a second unity build of the same modules, built optimized and
+// without BP_DEBUG by build.sh / build.bat as bytepath_bench. every case runs a fixed number of
+// ops per repetition (calibrated so one repetition takes about -min-ms), and reports ns/op over
+// the repetitions. -out writes a baseline, -compare reads one back and exits non-zero when a case
+// got slower by more than the threshold and its own noise. self-checks run before the timings and
+// a failing one makes the exit code 3.
+#if defined(_WIN32)
+# define WIN32_LEAN_AND_MEAN
+# define NOMINMAX
+# include <windows.h>
+# include <timeapi.h>
+# undef far
+# undef near
+#else
+# include <sys/mman.h>
+# include <pthread.h>
+# include <semaphore.h>
+# include <signal.h>
+# include <errno.h>
+# include <unistd.h>
+# include <poll.h>
+# include <dirent.h>
+# include <sys/stat.h>
+# include <sys/inotify.h>
+# include <sys/eventfd.h>
+#endif
+
+#include <time.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// NOTE(christian): the profiler is compiled in, so profiler_zone_overhead has zones to measure. the
+// other cases pay for the zones they already had: a few per frame and one per job.
+#if !defined(BP_PROFILER)
+# define BP_PROFILER 1
+#endif
+
+#include "bp_base.h"
+#include "bp_base.c"
+
+#include "bp_os.h"
+#include "bp_os.c"
+#if OS_WINDOWS
+# include "bp_os_win32.c"
+#elif OS_LINUX
+# include "bp_os_linux.c"
+#endif
+
+#include "bp_memory.h"
+#include "bp_memory.c"
+
+#include "bp_profiler.h"
+#include "bp_profiler.c"
+
+#include "bp_job.h"
+#include "bp_job.c"
+
+#include "bp_render.h"
+#include "bp_text.h"
+#include "bp_render.c"
+#include "bp_text.c"
+#include "bp_render_software.c"
+
+#include "bp_entity.h"
+#include "bp_entity.c"
+#include "bp_spatial.h"
+#include "bp_spatial.c"
+#include "bp_particle.h"
+#include "bp_particle.c"
+
+#include "bp_game.h"
+#include "bp_game.c"
+
+#define bench_max_repetitions 256
+#define bench_max_cases 64
+#define bench_name_capacity 64
+#define bench_default_repetitions 15
+#define bench_default_min_ms 10.0
+#define bench_default_threshold_percent 5.0
+// NOTE(christian): cases slower than this print ms/op instead of millions of ops a second.
+#define bench_ms_per_op_threshold_ns 10000.0
+
+#define bench_utf8_codepoint_count (16*1024)
+#define bench_array_count 4096
+#define bench_matrix_count 64
+#define bench_quads_per_reset (64*1024)
+#define bench_circles_per_reset 4096
+
+// NOTE(christian): the synthetic game frame. pickups and enemies sit still so the scene is the same every frame.
+#define bench_frame_pickup_count 4096
+#define bench_frame_enemy_count 2048
+#define bench_frame_quad_count 4096
+
+// NOTE(christian): a dense bullet hell. projectiles spread over the whole field, queried with enemy sized circles.
+#define bench_spatial_item_count 20000
+#define bench_spatial_item_radius 2.5f
+#define bench_spatial_query_radius 8.0f
+#define bench_spatial_query_count 2048
+
+// NOTE(christian): a screen full of explosion streaks. lifetimes are long enough that none die mid run.
+#define bench_particle_count (200*1024)
+
+// NOTE(christian): the software rasterizer draws the synthetic game frame, one case per job thread
+// count. 1 is the untiled reference path, the rest bin into tiles if there is more than one processor.
+#define bench_sw_scaling_count 5
+global u32 bench_sw_thread_counts[bench_sw_scaling_count] = { 1, 2, 4, 8, 16 };
+
+// NOTE(christian): a hud line's worth of text, one op per glyph quad.
+#define bench_text "score 1234567  hp 87/100  ammo 12  boost 0.75"
+
+typedef struct Bench_State
+{
+    Memory_Arena arena;
+    Job_System *jobs;
+    
+    Random_Stream random_stream;
+    u32 *random_words;
+    f32 *random_floats;
+    
+    u8 *utf8_text;
+    u32 utf8_byte_count;
+    u8 *ascii_text;
+    u32 *codepoints;
+    u8 *encode_buffer;
+    u32 *decode_buffer;
+    u16 *decode_buffer_utf16;
+    
+    v2f *points_a;
+    v2f *points_b;
+    v2f *points_out;
+    m44 *matrices;
+    v4f *vectors;
+    
+    Glyph_Atlas *glyph_atlas;
+    Text_Layout text_layout;
+    
+    Spatial_Grid spatial_grid;
+    f32 *spatial_x;
+    f32 *spatial_y;
+    f32 *spatial_radius;
+    u32 *spatial_overlaps;
+    
+    Particle_System *particles;
+    
+    Quad_Render_Batch *quad_render_batch;
+    Render_Batch *render_batch;
+    Render_Shards *render_shards;
+    Game_State *game;
+    
+    Quad_Render_Batch *sw_quad_render_batch;
+    Render_Batch *sw_render_batch;
+    Job_System *sw_jobs[bench_sw_scaling_count];
+    SW_Renderer *sw_renderers[bench_sw_scaling_count];
+} Bench_State;
+
+typedef void Bench_Proc(Bench_State *state, u64 op_count);
+
+typedef struct Bench_Case
+{
+    char *name;
+    Bench_Proc *proc;
+    // NOTE(christian): 0 when throughput in bytes means nothing for the case.
+    f64 bytes_per_op;
+} Bench_Case;
+
+typedef struct Bench_Result
+{
+    char name[bench_name_capacity];
+    u64 ops_per_repetition;
+    u32 repetition_count;
+    f64 min_ns;
+    f64 median_ns;
+    f64 mean_ns;
+    f64 stddev_ns;
+    f64 bytes_per_op;
+} Bench_Result;
+
+// NOTE(christian): every case folds what it computed in here, so the optimizer can't drop the work.
+global volatile u64 g_bench_sink;
+
+inline u64
+Bench_FoldF32(f32 value)
+{
+    u32 bits;
+    MemoryCopy(&bits, &value, sizeof(bits));
+    return(bits);
+}
+
+//~ NOTE(christian): cases
+function void
+Bench_RandomU32(Bench_State *state, u64 op_count)
+{
+    Unused(state);
+    u64 accumulator = 0;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        accumulator += Random_U32();
+    }
+    g_bench_sink += accumulator;
+}
+
+function void
+Bench_RandomU64(Bench_State *state, u64 op_count)
+{
+    Unused(state);
+    u64 accumulator = 0;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        accumulator += Random_U64();
+    }
+    g_bench_sink += accumulator;
+}
+
+function void
+Bench_RandomStreamU32(Bench_State *state, u64 op_count)
+{
+    Random_Stream *stream = &state->random_stream;
+    u64 accumulator = 0;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        accumulator += RandomStream_U32(stream);
+    }
+    g_bench_sink += accumulator;
+}
+
+// NOTE(christian): the fills count one op per number, filled bench_array_count at a time.
+function void
+Bench_RandomFillU32(Bench_State *state, u64 op_count)
+{
+    while (op_count)
+    {
+        u32 count = (u32)Min(op_count, bench_array_count);
+        RandomStream_FillU32(&state->random_stream, state->random_words, count);
+        op_count -= count;
+    }
+    g_bench_sink += state->random_words[0];
+}
+
+function void
+Bench_RandomFillF32(Bench_State *state, u64 op_count)
+{
+    while (op_count)
+    {
+        u32 count = (u32)Min(op_count, bench_array_count);
+        RandomStream_FillF32Range(&state->random_stream, state->random_floats, count, -1.0f, 1.0f);
+        op_count -= count;
+    }
+    g_bench_sink += Bench_FoldF32(state->random_floats[0]);
+}
+
+function void
+Bench_RandomFillUnitV2F(Bench_State *state, u64 op_count)
+{
+    while (op_count)
+    {
+        u32 count = (u32)Min(op_count, bench_array_count);
+        RandomStream_FillUnitV2F(&state->random_stream, state->points_out, count);
+        op_count -= count;
+    }
+    g_bench_sink += Bench_FoldF32(state->points_out[0].x);
+}
+
+// NOTE(christian): one op is one codepoint. the text wraps around.
+function void
+Bench_DecodeUTF8(Bench_State *state, u64 op_count)
+{
+    u8 *at = state->utf8_text;
+    u8 *end = state->utf8_text + state->utf8_byte_count;
+    u64 accumulator = 0;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        String_Decode decode = StringDecode_UTF8(at, (u32)(end - at));
+        accumulator += decode.codepoint;
+        at = decode.next_in_str;
+        if (at >= end)
+        {
+            at = state->utf8_text;
+        }
+    }
+    g_bench_sink += accumulator;
+}
+
+function void
+Bench_EncodeUTF8(Bench_State *state, u64 op_count)
+{
+    u8 *dest = state->encode_buffer;
+    u64 accumulator = 0;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        u32 codepoint_index = (u32)(op_index & (bench_utf8_codepoint_count - 1));
+        if (!codepoint_index)
+        {
+            dest = state->encode_buffer;
+        }
+        u32 byte_count = StringEncode_UTF8(dest, state->codepoints[codepoint_index]);
+        dest += byte_count;
+        accumulator += byte_count;
+    }
+    g_bench_sink += accumulator + state->encode_buffer[0];
+}
+
+// NOTE(christian): the bulk ones. one op is a pass over the whole text.
+function void
+Bench_ValidateUTF8(Bench_State *state, u64 op_count)
+{
+    u64 accumulator = 0;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        accumulator += StringValidate_UTF8(state->utf8_text, state->utf8_byte_count);
+    }
+    g_bench_sink += accumulator;
+}
+
+function void
+Bench_TranscodeUTF32(Bench_State *state, u64 op_count)
+{
+    u64 accumulator = 0;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        String_Transcode transcode = StringTranscode_UTF8ToUTF32(state->decode_buffer, state->utf8_byte_count,
+                                                                 state->utf8_text, state->utf8_byte_count);
+        accumulator += transcode.written + state->decode_buffer[transcode.written - 1];
+    }
+    g_bench_sink += accumulator;
+}
+
+function void
+Bench_TranscodeUTF16(Bench_State *state, u64 op_count)
+{
+    u64 accumulator = 0;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        String_Transcode transcode = StringTranscode_UTF8ToUTF16(state->decode_buffer_utf16, state->utf8_byte_count,
+                                                                 state->utf8_text, state->utf8_byte_count);
+        accumulator += transcode.written + state->decode_buffer_utf16[transcode.written - 1];
+    }
+    g_bench_sink += accumulator;
+}
+
+function void
+Bench_TranscodeASCII(Bench_State *state, u64 op_count)
+{
+    u64 accumulator = 0;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        String_Transcode transcode = StringTranscode_UTF8ToUTF32(state->decode_buffer, state->utf8_byte_count,
+                                                                 state->ascii_text, state->utf8_byte_count);
+        accumulator += transcode.written + state->decode_buffer[transcode.written - 1];
+    }
+    g_bench_sink += accumulator;
+}
+
+// NOTE(christian): one op is out = a + (b - a) * 0.5 on one element.
+function void
+Bench_V2FOps(Bench_State *state, u64 op_count)
+{
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        u32 index = (u32)(op_index & (bench_array_count - 1));
+        v2f a = state->points_a[index];
+        v2f b = state->points_b[index];
+        state->points_out[index] = V2F_Add(a, V2F_Scale(V2F_Subtract(b, a), 0.5f));
+    }
+    g_bench_sink += Bench_FoldF32(state->points_out[0].x);
+}
+
+function void
+Bench_MatrixMultiply(Bench_State *state, u64 op_count)
+{
+    f32 accumulator = 0.0f;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        u32 index = (u32)(op_index & (bench_matrix_count - 1));
+        m44 result = Matrix4x4_Multiply(state->matrices[index], state->matrices[(index + 1) & (bench_matrix_count - 1)]);
+        accumulator += result.m[(index >> 2) & 3][index & 3];
+    }
+    g_bench_sink += Bench_FoldF32(accumulator);
+}
+
+function void
+Bench_MatrixTransformV4F(Bench_State *state, u64 op_count)
+{
+    m44 m = state->matrices[0];
+    f32 accumulator = 0.0f;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        v4f result = Matrix4x4_TransformV4F(m, state->vectors[op_index & (bench_array_count - 1)]);
+        accumulator += result.x;
+    }
+    g_bench_sink += Bench_FoldF32(accumulator);
+}
+
+// NOTE(christian): one op is one point, pushed through in arrays of bench_array_count.
+function void
+Bench_MatrixTransformPoints(Bench_State *state, u64 op_count)
+{
+    m44 m = state->matrices[0];
+    while (op_count)
+    {
+        u32 count = (u32)Min(op_count, bench_array_count);
+        Matrix4x4_TransformPointsV2F(m, state->points_a, state->points_out, count);
+        op_count -= count;
+    }
+    g_bench_sink += Bench_FoldF32(state->points_out[0].x);
+}
+
+// NOTE(christian): one op is a begin / end pair, what wrapping a zone costs the code inside it.
+function void
+Bench_ProfilerZone(Bench_State *state, u64 op_count)
+{
+    (void)state;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        ProfileBegin("bench zone");
+        ProfileEnd("bench zone");
+    }
+    g_bench_sink += tl_profile_thread->event_count;
+}
+
+function void
+Bench_QuadPushRectFilled(Bench_State *state, u64 op_count)
+{
+    Quad_Render_Batch *batch = state->quad_render_batch;
+    QuadRenderBatch_Reset(batch);
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        if (batch->quads_drawn == bench_quads_per_reset)
+        {
+            QuadRenderBatch_Reset(batch);
+        }
+        v2f p = state->points_a[op_index & (bench_array_count - 1)];
+        QuadRenderBatch_PushRectFilled(batch, p, V2F(8.0f, 8.0f), RGBA(1.0f, 0.5f, 0.25f, 1.0f), 2.0f);
+    }
+    g_bench_sink += batch->quads_drawn;
+}
+
+function void
+Bench_QuadPushCircleOutline(Bench_State *state, u64 op_count)
+{
+    Quad_Render_Batch *batch = state->quad_render_batch;
+    QuadRenderBatch_Reset(batch);
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        if (batch->quads_drawn == bench_quads_per_reset)
+        {
+            QuadRenderBatch_Reset(batch);
+        }
+        v2f p = state->points_a[op_index & (bench_array_count - 1)];
+        QuadRenderBatch_PushCircleOutline(batch, p, RGBA(1.0f, 1.0f, 1.0f, 1.0f), 6.0f, 1.0f);
+    }
+    g_bench_sink += batch->quads_drawn;
+}
+
+// NOTE(christian): one op is one glyph. the first lays the string out every push, the second copies a cached layout.
+function void
+Bench_TextPush(Bench_State *state, u64 op_count)
+{
+    Quad_Render_Batch *batch = state->quad_render_batch;
+    String_Const_U8 text = Str8Lit(bench_text);
+    u64 glyphs_per_push = state->text_layout.glyph_count;
+    QuadRenderBatch_Reset(batch);
+    for (u64 glyph_count = 0; glyph_count < op_count; glyph_count += glyphs_per_push)
+    {
+        if ((batch->quads_drawn + glyphs_per_push) > bench_quads_per_reset)
+        {
+            QuadRenderBatch_Reset(batch);
+        }
+        v2f p = state->points_a[glyph_count & (bench_array_count - 1)];
+        QuadRenderBatch_PushText(batch, state->glyph_atlas, p, RGBA(1.0f, 1.0f, 1.0f, 1.0f), 1.0f, text);
+    }
+    g_bench_sink += batch->quads_drawn;
+}
+
+function void
+Bench_TextPushLayout(Bench_State *state, u64 op_count)
+{
+    Quad_Render_Batch *batch = state->quad_render_batch;
+    u64 glyphs_per_push = state->text_layout.glyph_count;
+    QuadRenderBatch_Reset(batch);
+    for (u64 glyph_count = 0; glyph_count < op_count; glyph_count += glyphs_per_push)
+    {
+        if ((batch->quads_drawn + glyphs_per_push) > bench_quads_per_reset)
+        {
+            QuadRenderBatch_Reset(batch);
+        }
+        v2f p = state->points_a[glyph_count & (bench_array_count - 1)];
+        QuadRenderBatch_PushTextLayout(batch, &state->text_layout, p, RGBA(1.0f, 1.0f, 1.0f, 1.0f));
+    }
+    g_bench_sink += batch->quads_drawn;
+}
+
+// NOTE(christian): one op is a whole grid rebuilt over bench_spatial_item_count items.
+function void
+Bench_SpatialBuild(Bench_State *state, u64 op_count)
+{
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        SpatialGrid_Build(&state->spatial_grid, state->spatial_x, state->spatial_y, state->spatial_radius,
+                          bench_spatial_item_count);
+    }
+    g_bench_sink += state->spatial_grid.items[0];
+}
+
+function void
+Bench_SpatialBuildParallel(Bench_State *state, u64 op_count)
+{
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        SpatialGrid_BuildParallel(&state->spatial_grid, state->jobs, state->spatial_x, state->spatial_y,
+                                  state->spatial_radius, bench_spatial_item_count);
+    }
+    g_bench_sink += state->spatial_grid.items[0];
+}
+
+function void
+Bench_SpatialQueryCircle(Bench_State *state, u64 op_count)
+{
+    SpatialGrid_Build(&state->spatial_grid, state->spatial_x, state->spatial_y, state->spatial_radius,
+                      bench_spatial_item_count);
+    u64 overlap_count = 0;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        v2f p = state->points_a[op_index & (bench_array_count - 1)];
+        overlap_count += SpatialGrid_QueryCircle(&state->spatial_grid, p, bench_spatial_query_radius,
+                                                 state->spatial_overlaps, bench_spatial_item_count);
+    }
+    g_bench_sink += overlap_count;
+}
+
+function void
+Bench_SpatialRaycast(Bench_State *state, u64 op_count)
+{
+    SpatialGrid_Build(&state->spatial_grid, state->spatial_x, state->spatial_y, state->spatial_radius,
+                      bench_spatial_item_count);
+    u64 hit_count = 0;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        v2f p = state->points_a[op_index & (bench_array_count - 1)];
+        v2f direction = V2F_Subtract(state->points_b[op_index & (bench_array_count - 1)], p);
+        hit_count += SpatialGrid_Raycast(&state->spatial_grid, p, direction, 1000.0f, null) != spatial_invalid_index;
+    }
+    g_bench_sink += hit_count;
+}
+
+// NOTE(christian): one op is a whole tick of broad-phase, the rebuild plus a query per enemy.
+function void
+Bench_SpatialCollide(Bench_State *state, u64 op_count)
+{
+    u64 overlap_count = 0;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        SpatialGrid_BuildParallel(&state->spatial_grid, state->jobs, state->spatial_x, state->spatial_y,
+                                  state->spatial_radius, bench_spatial_item_count);
+        for (u32 query_index = 0; query_index < bench_spatial_query_count; ++query_index)
+        {
+            v2f p = state->points_b[query_index & (bench_array_count - 1)];
+            overlap_count += SpatialGrid_QueryCircle(&state->spatial_grid, p, bench_spatial_query_radius,
+                                                     state->spatial_overlaps, bench_spatial_item_count);
+        }
+    }
+    g_bench_sink += overlap_count;
+}
+
+// NOTE(christian): one op is a whole tick / frame of bench_particle_count particles.
+function void
+Bench_ParticleUpdate(Bench_State *state, u64 op_count)
+{
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        ParticleSystem_Update(state->particles, state->jobs, 1.0f / (f32)game_default_tick_rate);
+    }
+    g_bench_sink += ParticleSystem_Count(state->particles);
+}
+
+function void
+Bench_ParticleRender(Bench_State *state, u64 op_count)
+{
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        QuadRenderBatch_Reset(state->quad_render_batch);
+        Job_Counter render_counter = {0};
+        ParticleSystem_Render(state->particles, state->jobs, &render_counter, state->quad_render_batch, 0.5f);
+        JobSystem_Wait(state->jobs, &render_counter);
+    }
+    g_bench_sink += state->quad_render_batch->quads_drawn;
+}
+
+// NOTE(christian): update, render into the frame's batch and the (empty) merge, what a frame of particles costs before the backend.
+// this is the one the 2 ms budget in bp_particle.h is held to.
+function void
+Bench_ParticleFrame(Bench_State *state, u64 op_count)
+{
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        QuadRenderBatch_Reset(state->quad_render_batch);
+        RenderBatch_Reset(state->render_batch);
+        RenderShards_Reset(state->render_shards);
+        
+        ParticleSystem_Update(state->particles, state->jobs, 1.0f / (f32)game_default_tick_rate);
+        Job_Counter render_counter = {0};
+        ParticleSystem_Render(state->particles, state->jobs, &render_counter, state->quad_render_batch, 0.5f);
+        JobSystem_Wait(state->jobs, &render_counter);
+        RenderShards_Merge(state->render_shards, state->quad_render_batch, state->render_batch);
+    }
+    g_bench_sink += state->quad_render_batch->quads_drawn;
+}
+
+function void
+Bench_CircleOutline(Bench_State *state, u64 op_count, f32 radius)
+{
+    Render_Batch *batch = state->render_batch;
+    RenderBatch_Reset(batch);
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        if (!((op_index + 1) % bench_circles_per_reset))
+        {
+            RenderBatch_Reset(batch);
+        }
+        v2f p = state->points_a[op_index & (bench_array_count - 1)];
+        RenderBatch_PushCircleOutline(batch, p, RGBA(1.0f, 1.0f, 1.0f, 1.0f), radius);
+    }
+    g_bench_sink += batch->vertex_count;
+}
+
+function void
+Bench_CircleOutlineSmall(Bench_State *state, u64 op_count)
+{
+    Bench_CircleOutline(state, op_count, 6.0f);
+}
+
+function void
+Bench_CircleOutlineLarge(Bench_State *state, u64 op_count)
+{
+    Bench_CircleOutline(state, op_count, 96.0f);
+}
+
+// NOTE(christian): one op is a whole frame of quads, built straight into the batch.
+function void
+Bench_FrameQuads(Bench_State *state, u64 op_count)
+{
+    Quad_Render_Batch *batch = state->quad_render_batch;
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        QuadRenderBatch_Reset(batch);
+        for (u32 quad_index = 0; quad_index < bench_frame_quad_count; ++quad_index)
+        {
+            v2f p = state->points_a[quad_index & (bench_array_count - 1)];
+            if (quad_index & 1)
+            {
+                QuadRenderBatch_PushCircleOutline(batch, p, RGBA(1.0f, 1.0f, 1.0f, 1.0f), 6.0f, 1.0f);
+            }
+            else
+            {
+                QuadRenderBatch_PushRectFilled(batch, p, V2F(4.0f, 4.0f), RGBA(0.5f, 0.5f, 1.0f, 1.0f), 0.0f);
+            }
+        }
+    }
+    g_bench_sink += batch->quads_drawn;
+}
+
+// NOTE(christian): one op is what main does for a frame up to the backend: reset, one sim tick,
+// entities emitted through the shards, merged into the frame's batches.
+function void
+Bench_FrameGame(Bench_State *state, u64 op_count)
+{
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        QuadRenderBatch_Reset(state->quad_render_batch);
+        RenderBatch_Reset(state->render_batch);
+        RenderShards_Reset(state->render_shards);
+        
+        Game_Update(state->game, 1.0f / (f32)game_default_tick_rate);
+        Game_Render(state->game, 0.5f, state->render_shards, state->quad_render_batch);
+        RenderShards_Merge(state->render_shards, state->quad_render_batch, state->render_batch);
+    }
+    g_bench_sink += state->render_batch->vertex_count;
+}
+
+// NOTE(christian): one op is a whole software frame of the same scene: bin, draw and resolve.
+// NOTE(christian): the job systems behind these start 31 threads between them, so they're only made
+// once a software case runs. a run that filters those out doesn't have the threads around at all.
+function SW_Renderer *
+Bench_GetSoftwareRenderer(Bench_State *state, u32 scaling_index)
+{
+    SW_Renderer *result = state->sw_renderers[scaling_index];
+    if (!result)
+    {
+        Job_System *jobs = MemoryArena_PushStruct(&state->arena, Job_System);
+        SW_Renderer *renderer = MemoryArena_PushStruct(&state->arena, SW_Renderer);
+        if (jobs && renderer &&
+            JobSystem_Init(jobs, &state->arena, bench_sw_thread_counts[scaling_index]) &&
+            SW_RendererInit(renderer, &state->arena, render_target_width, render_target_height, jobs, state->glyph_atlas))
+        {
+            state->sw_jobs[scaling_index] = jobs;
+            state->sw_renderers[scaling_index] = renderer;
+            result = renderer;
+        }
+    }
+    return(result);
+}
+
+function void
+Bench_SoftwareFrame(Bench_State *state, u64 op_count, u32 scaling_index)
+{
+    SW_Renderer *renderer = Bench_GetSoftwareRenderer(state, scaling_index);
+    Assert(renderer != null);
+    for (u64 op_index = 0; op_index < op_count; ++op_index)
+    {
+        SW_RendererSubmit(renderer, state->sw_quad_render_batch, state->sw_render_batch);
+    }
+    g_bench_sink += renderer->pixels[0];
+}
+
+function void
+Bench_SoftwareFrame1(Bench_State *state, u64 op_count)
+{
+    Bench_SoftwareFrame(state, op_count, 0);
+}
+
+function void
+Bench_SoftwareFrame2(Bench_State *state, u64 op_count)
+{
+    Bench_SoftwareFrame(state, op_count, 1);
+}
+
+function void
+Bench_SoftwareFrame4(Bench_State *state, u64 op_count)
+{
+    Bench_SoftwareFrame(state, op_count, 2);
+}
+
+function void
+Bench_SoftwareFrame8(Bench_State *state, u64 op_count)
+{
+    Bench_SoftwareFrame(state, op_count, 3);
+}
+
+function void
+Bench_SoftwareFrame16(Bench_State *state, u64 op_count)
+{
+    Bench_SoftwareFrame(state, op_count, 4);
+}
+
+//~ NOTE(christian): self-checks
+// NOTE(christian): cheap correctness checks that run before the timings, so a fast but wrong change
+// can't pass as a speedup. a failed check makes the run exit with 3.
+typedef b32 Bench_Check_Proc(Bench_State *state);
+
+typedef struct Bench_Check
+{
+    char *name;
+    Bench_Check_Proc *proc;
+} Bench_Check;
+
+typedef struct Bench_Philox_Vector
+{
+    u32 counter[4];
+    u32 key[2];
+    u32 expected[4];
+} Bench_Philox_Vector;
+
+// NOTE(christian): the philox4x32_10 known answers from Random123's kat_vectors. the single block
+// function has to match them, and a stream at the same key, id and block has to hand out the same
+// words through the fills. a long fill starting just below a low counter word wrap has to match the
+// single block function block for block, which covers the wide groups and the scalar fallback.
+function b32
+Bench_CheckPhiloxKnownAnswers(Bench_State *state)
+{
+    local Bench_Philox_Vector vectors[] =
+    {
+        { { 0x00000000, 0x00000000, 0x00000000, 0x00000000 }, { 0x00000000, 0x00000000 },
+          { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } },
+        { { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff },
+          { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } },
+        { { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 },
+          { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } },
+    };
+    
+    b32 result = True;
+    for (u32 vector_index = 0; vector_index < ArrayCount(vectors); ++vector_index)
+    {
+        Bench_Philox_Vector *vector = vectors + vector_index;
+        u32 words[random_block_words];
+        Random_Philox4x32(vector->counter, vector->key, words);
+        result = result && !memcmp(words, vector->expected, sizeof(words));
+        
+        u64 seed = ((u64)vector->key[1] << 32) | vector->key[0];
+        u64 stream_id = ((u64)vector->counter[3] << 32) | vector->counter[2];
+        u64 block = ((u64)vector->counter[1] << 32) | vector->counter[0];
+        // NOTE(christian): the vectors' blocks are past what a u64 word position can seek to, so the block is set directly.
+        Random_Stream stream = RandomStream_Make(seed, stream_id);
+        stream.block = block;
+        RandomStream_FillU32(&stream, words, random_block_words);
+        result = result && !memcmp(words, vector->expected, sizeof(words));
+    }
+    
+    u32 key[2] = { 0x9E3779B9, 0x7F4A7C15 };
+    u64 first_block = 0xFFFFFFF0llu;
+    Random_Stream stream = RandomStream_Make(((u64)key[1] << 32) | key[0], 0x0123456789ABCDEFllu);
+    RandomStream_Seek(&stream, first_block * random_block_words);
+    u32 *words = state->random_words;
+    RandomStream_FillU32(&stream, words, bench_array_count);
+    for (u32 block_index = 0; result && (block_index < bench_array_count / random_block_words); ++block_index)
+    {
+        u64 block = first_block + block_index;
+        u32 counter[4] = { (u32)block, (u32)(block >> 32), stream.stream_id[0], stream.stream_id[1] };
+        u32 expected[random_block_words];
+        Random_Philox4x32(counter, key, expected);
+        result = !memcmp(words + block_index * random_block_words, expected, sizeof(expected));
+    }
+    return(result);
+}
+
+// NOTE(christian): every lane op with a scalar twin, over inputs in the range it's meant for.
+typedef enum Bench_Lane_Op
+{
+    BenchLaneOp_Round,
+    BenchLaneOp_RSqrt,
+    BenchLaneOp_Sqrt,
+    BenchLaneOp_Sin,
+    BenchLaneOp_Cos,
+    BenchLaneOp_Log2,
+    BenchLaneOp_Exp2,
+    BenchLaneOp_Pow,
+    BenchLaneOp_EaseOutQuart,
+    BenchLaneOp_EaseInQuart,
+    BenchLaneOp_Count
+} Bench_Lane_Op;
+
+typedef struct Bench_Lane_Op_Range
+{
+    f32 a_min;
+    f32 a_max;
+    f32 b_min;
+    f32 b_max;
+} Bench_Lane_Op_Range;
+
+inline f32
+Bench_ScalarOp(Bench_Lane_Op op, f32 a, f32 b)
+{
+    f32 result = 0.0f;
+    switch (op)
+    {
+        case BenchLaneOp_Round: { result = RoundF32(a); } break;
+        case BenchLaneOp_RSqrt: { result = RSqrtApproxF32(a); } break;
+        case BenchLaneOp_Sqrt: { result = SqrtApproxF32(a); } break;
+        case BenchLaneOp_Sin: { result = SinApproxF32(a); } break;
+        case BenchLaneOp_Cos: { result = CosApproxF32(a); } break;
+        case BenchLaneOp_Log2: { result = Log2ApproxF32(a); } break;
+        case BenchLaneOp_Exp2: { result = Exp2ApproxF32(a); } break;
+        case BenchLaneOp_Pow: { result = PowApproxF32(a, b); } break;
+        case BenchLaneOp_EaseOutQuart: { result = EaseOutQuart(a); } break;
+        case BenchLaneOp_EaseInQuart: { result = EaseInQuart(a); } break;
+        default: break;
+    }
+    return(result);
+}
+
+inline lane_f32
+Bench_LaneOp(Bench_Lane_Op op, lane_f32 a, lane_f32 b)
+{
+    lane_f32 result = LaneF32_Set1(0.0f);
+    switch (op)
+    {
+        case BenchLaneOp_Round: { result = LaneF32_Round(a); } break;
+        case BenchLaneOp_RSqrt: { result = LaneF32_RSqrtApprox(a); } break;
+        case BenchLaneOp_Sqrt: { result = LaneF32_SqrtApprox(a); } break;
+        case BenchLaneOp_Sin: { result = LaneF32_SinApprox(a); } break;
+        case BenchLaneOp_Cos: { result = LaneF32_CosApprox(a); } break;
+        case BenchLaneOp_Log2: { result = LaneF32_Log2Approx(a); } break;
+        case BenchLaneOp_Exp2: { result = LaneF32_Exp2Approx(a); } break;
+        case BenchLaneOp_Pow: { result = LaneF32_PowApprox(a, b); } break;
+        case BenchLaneOp_EaseOutQuart: { result = LaneF32_EaseOutQuart(a); } break;
+        case BenchLaneOp_EaseInQuart: { result = LaneF32_EaseInQuart(a); } break;
+        default: break;
+    }
+    return(result);
+}
+
+// NOTE(christian): the lanes promise bit-identical results to the scalar versions at every width.
+// each lane op runs against its scalar twin element by element, and each batch function over a
+// whole array runs against itself one element at a time, which only takes the scalar tail.
+function b32
+Bench_CheckLanesMatchScalar(Bench_State *state)
+{
+    (void)state;
+    local Bench_Lane_Op_Range ranges[BenchLaneOp_Count] =
+    {
+        { -1.0e6f, 1.0e6f, 0.0f, 0.0f },
+        { 1.0e-6f, 1.0e6f, 0.0f, 0.0f },
+        { 1.0e-6f, 1.0e6f, 0.0f, 0.0f },
+        { -1000.0f, 1000.0f, 0.0f, 0.0f },
+        { -1000.0f, 1000.0f, 0.0f, 0.0f },
+        { 1.0e-6f, 1.0e6f, 0.0f, 0.0f },
+        { -140.0f, 140.0f, 0.0f, 0.0f },
+        { -1.0f, 100.0f, -4.0f, 4.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+    };
+    
+    Temporary_Memory scratch = Scratch_Begin(null, 0);
+    u32 count = bench_array_count;
+    f32 *a = MemoryArena_PushArray(scratch.arena, f32, count);
+    f32 *b = MemoryArena_PushArray(scratch.arena, f32, count);
+    f32 *wide = MemoryArena_PushArray(scratch.arena, f32, count);
+    f32 *narrow = MemoryArena_PushArray(scratch.arena, f32, count);
+    f32 *wide_2 = MemoryArena_PushArray(scratch.arena, f32, count);
+    f32 *narrow_2 = MemoryArena_PushArray(scratch.arena, f32, count);
+    Random_Stream stream = RandomStream_Make(0x5EED5EED, 7);
+    
+    b32 result = True;
+    for (u32 op = 0; op < BenchLaneOp_Count; ++op)
+    {
+        RandomStream_FillF32Range(&stream, a, count, ranges[op].a_min, ranges[op].a_max);
+        RandomStream_FillF32Range(&stream, b, count, ranges[op].b_min, ranges[op].b_max);
+        for (u32 index = 0; index < count; index += lane_width)
+        {
+            LaneF32_Store(wide + index, Bench_LaneOp((Bench_Lane_Op)op, LaneF32_Load(a + index), LaneF32_Load(b + index)));
+        }
+        for (u32 index = 0; index < count; ++index)
+        {
+            narrow[index] = Bench_ScalarOp((Bench_Lane_Op)op, a[index], b[index]);
+        }
+        result = result && !memcmp(wide, narrow, sizeof(f32) * count);
+    }
+    
+    RandomStream_FillF32Range(&stream, a, count, 0.0f, 1.0f);
+    BatchF32_EaseOutQuart(wide, a, count);
+    BatchF32_EaseInQuart(wide_2, a, count);
+    for (u32 index = 0; index < count; ++index)
+    {
+        BatchF32_EaseOutQuart(narrow + index, a + index, 1);
+        BatchF32_EaseInQuart(narrow_2 + index, a + index, 1);
+    }
+    result = result && !memcmp(wide, narrow, sizeof(f32) * count) && !memcmp(wide_2, narrow_2, sizeof(f32) * count);
+    
+    RandomStream_FillF32Range(&stream, a, count, -1000.0f, 1000.0f);
+    BatchF32_SinCosApprox(wide, wide_2, a, count);
+    for (u32 index = 0; index < count; ++index)
+    {
+        BatchF32_SinCosApprox(narrow + index, narrow_2 + index, a + index, 1);
+    }
+    result = result && !memcmp(wide, narrow, sizeof(f32) * count) && !memcmp(wide_2, narrow_2, sizeof(f32) * count);
+    
+    RandomStream_FillF32Range(&stream, wide, count, -500.0f, 500.0f);
+    RandomStream_FillF32Range(&stream, wide_2, count, -500.0f, 500.0f);
+    RandomStream_FillF32Range(&stream, a, count, -50.0f, 50.0f);
+    RandomStream_FillF32Range(&stream, b, count, -50.0f, 50.0f);
+    MemoryCopy(narrow, wide, sizeof(f32) * count);
+    MemoryCopy(narrow_2, wide_2, sizeof(f32) * count);
+    BatchV2F_MulAdd(wide, wide_2, a, b, 0.37f, count);
+    for (u32 index = 0; index < count; ++index)
+    {
+        BatchV2F_MulAdd(narrow + index, narrow_2 + index, a + index, b + index, 0.37f, 1);
+    }
+    result = result && !memcmp(wide, narrow, sizeof(f32) * count) && !memcmp(wide_2, narrow_2, sizeof(f32) * count);
+    
+    m44 m = Matrix4x4_Orthographic_LH_CM_Z01(0.0f, (f32)render_target_width, 0.0f, (f32)render_target_height, 0.0f, 1.0f);
+    u32 point_count = count / 2;
+    RandomStream_FillF32Range(&stream, a, count, -100.0f, 600.0f);
+    Matrix4x4_TransformPointsV2F(m, (v2f *)a, (v2f *)wide, point_count);
+    for (u32 point_index = 0; point_index < point_count; ++point_index)
+    {
+        Matrix4x4_TransformPointsV2F(m, (v2f *)a + point_index, (v2f *)narrow + point_index, 1);
+    }
+    result = result && !memcmp(wide, narrow, sizeof(v2f) * point_count);
+    
+    Scratch_End(scratch);
+    return(result);
+}
+
+//~ NOTE(christian): setup
+function b32
+Bench_InitState(Bench_State *state, u32 thread_count)
+{
+    MemoryZero(state, sizeof(Bench_State));
+    b32 result = MemoryArena_Init(&state->arena, GB(4));
+    if (!result)
+    {
+        return(result);
+    }
+    
+    Memory_Arena *arena = &state->arena;
+    state->jobs = MemoryArena_PushStruct(arena, Job_System);
+    result = JobSystem_Init(state->jobs, arena, thread_count);
+    
+    // NOTE(christian): fixed seed so every run sees the same inputs. the mix is mostly ascii with some
+    // of every longer encoding, all valid (no surrogates).
+    SeedRandom_U32(0x9E3779B9);
+    state->random_stream = RandomStream_Make(0x9E3779B9, 0);
+    state->random_words = MemoryArena_PushArray(arena, u32, bench_array_count);
+    state->random_floats = MemoryArena_PushArray(arena, f32, bench_array_count);
+    
+    state->codepoints = MemoryArena_PushArray(arena, u32, bench_utf8_codepoint_count);
+    for (u32 codepoint_index = 0; codepoint_index < bench_utf8_codepoint_count; ++codepoint_index)
+    {
+        u32 roll = Random_U32() % 100;
+        u32 codepoint = 0x20 + (Random_U32() % 0x5F);
+        if (roll >= 95)
+        {
+            codepoint = 0x10000 + (Random_U32() % 0xF0000);
+        }
+        else if (roll >= 85)
+        {
+            codepoint = 0x1000 + (Random_U32() % 0xC000);
+        }
+        else if (roll >= 70)
+        {
+            codepoint = 0x100 + (Random_U32() % 0x700);
+        }
+        state->codepoints[codepoint_index] = codepoint;
+    }
+    
+    state->utf8_text = MemoryArena_PushArrayZero(arena, u8, bench_utf8_codepoint_count * 4 + 4);
+    state->encode_buffer = MemoryArena_PushArrayZero(arena, u8, bench_utf8_codepoint_count * 4 + 4);
+    for (u32 codepoint_index = 0; codepoint_index < bench_utf8_codepoint_count; ++codepoint_index)
+    {
+        state->utf8_byte_count += StringEncode_UTF8(state->utf8_text + state->utf8_byte_count, state->codepoints[codepoint_index]);
+    }
+    
+    state->ascii_text = MemoryArena_PushArray(arena, u8, state->utf8_byte_count);
+    state->decode_buffer = MemoryArena_PushArray(arena, u32, state->utf8_byte_count);
+    state->decode_buffer_utf16 = MemoryArena_PushArray(arena, u16, state->utf8_byte_count);
+    for (u32 byte_index = 0; byte_index < state->utf8_byte_count; ++byte_index)
+    {
+        state->ascii_text[byte_index] = (u8)(0x20 + (byte_index % 0x5F));
+    }
+    
+    state->points_a = MemoryArena_PushArray(arena, v2f, bench_array_count);
+    state->points_b = MemoryArena_PushArray(arena, v2f, bench_array_count);
+    state->points_out = MemoryArena_PushArray(arena, v2f, bench_array_count);
+    state->vectors = MemoryArena_PushArray(arena, v4f, bench_array_count);
+    for (u32 point_index = 0; point_index < bench_array_count; ++point_index)
+    {
+        state->points_a[point_index] = V2F((f32)(Random_U32() % render_target_width), (f32)(Random_U32() % render_target_height));
+        state->points_b[point_index] = V2F((f32)(Random_U32() % render_target_width), (f32)(Random_U32() % render_target_height));
+        state->vectors[point_index] = V4F(state->points_a[point_index].x, state->points_a[point_index].y, 0.0f, 1.0f);
+    }
+    
+    state->matrices = MemoryArena_PushArray(arena, m44, bench_matrix_count);
+    for (u32 matrix_index = 0; matrix_index < bench_matrix_count; ++matrix_index)
+    {
+        f32 size = 1.0f + (f32)matrix_index;
+        state->matrices[matrix_index] = Matrix4x4_Orthographic_LH_CM_Z01(0.0f, size * 16.0f, 0.0f, size * 9.0f, 0.0f, 1.0f);
+    }
+    
+    state->glyph_atlas = MemoryArena_PushStruct(arena, Glyph_Atlas);
+    result = result && GlyphAtlas_Bake(state->glyph_atlas, arena);
+    state->text_layout = TextLayout_Build(state->glyph_atlas, arena, Str8Lit(bench_text), 1.0f);
+    
+    Random_Stream spatial_stream = RandomStream_Make(0x9E3779B9, 1);
+    state->spatial_x = MemoryArena_PushArray(arena, f32, bench_spatial_item_count);
+    state->spatial_y = MemoryArena_PushArray(arena, f32, bench_spatial_item_count);
+    state->spatial_radius = MemoryArena_PushArray(arena, f32, bench_spatial_item_count);
+    state->spatial_overlaps = MemoryArena_PushArray(arena, u32, bench_spatial_item_count);
+    RandomStream_FillF32Range(&spatial_stream, state->spatial_x, bench_spatial_item_count, 0.0f, (f32)render_target_width);
+    RandomStream_FillF32Range(&spatial_stream, state->spatial_y, bench_spatial_item_count, 0.0f, (f32)render_target_height);
+    for (u32 item_index = 0; item_index < bench_spatial_item_count; ++item_index)
+    {
+        state->spatial_radius[item_index] = bench_spatial_item_radius;
+    }
+    result = result && SpatialGrid_Init(&state->spatial_grid, arena, V2F(0.0f, 0.0f),
+                                        V2F((f32)render_target_width, (f32)render_target_height),
+                                        game_collision_cell_size, bench_spatial_item_count);
+    
+    Particle_Style particle_style = {0};
+    particle_style.colour_start = RGBA(1.0f, 1.0f, 1.0f, 1.0f);
+    particle_style.colour_end = RGBA(1.0f, 0.3f, 0.3f, 0.0f);
+    particle_style.colour_ease = ParticleEase_InQuart;
+    particle_style.size_start = 1.0f;
+    particle_style.size_ease = ParticleEase_OutQuart;
+    particle_style.drag = 0.1f;
+    particle_style.stretch = 0.05f;
+    
+    state->particles = MemoryArena_PushStruct(arena, Particle_System);
+    ParticleSystem_Init(state->particles, 0x9E3779B9);
+    Particle_Emitter particle_emitter = {0};
+    particle_emitter.pool_index = ParticleSystem_AddPool(state->particles, arena, &particle_style, bench_particle_count);
+    particle_emitter.p = V2F(0.5f * (f32)render_target_width, 0.5f * (f32)render_target_height);
+    particle_emitter.spread = pi_F32;
+    particle_emitter.speed_min = 10.0f;
+    particle_emitter.speed_max = 200.0f;
+    particle_emitter.lifetime_min = 1.0e6f;
+    particle_emitter.lifetime_max = 2.0e6f;
+    particle_emitter.size_min = 1.5f;
+    particle_emitter.size_max = 2.5f;
+    ParticleSystem_Emit(state->particles, &particle_emitter, bench_particle_count);
+    
+    state->quad_render_batch = MemoryArena_PushStruct(arena, Quad_Render_Batch);
+    state->render_batch = MemoryArena_PushStruct(arena, Render_Batch);
+    state->render_shards = MemoryArena_PushStruct(arena, Render_Shards);
+    result = result && QuadRenderBatch_Init(state->quad_render_batch);
+    result = result && RenderBatch_Init(state->render_batch);
+    result = result && RenderShards_Init(state->render_shards, arena, state->jobs);
+    
+    state->game = MemoryArena_PushStruct(arena, Game_State);
+    Game_Init(state->game, V2F((f32)render_target_width, (f32)render_target_height), state->jobs, state->glyph_atlas);
+    for (u32 entity_index = 0; entity_index < bench_frame_pickup_count; ++entity_index)
+    {
+        EntityWorld_Spawn(&state->game->entities, EntityKind_Pickup, state->points_a[entity_index % bench_array_count],
+                          0.0f, 0.0f, 1.0e9f, 3.0f);
+    }
+    for (u32 entity_index = 0; entity_index < bench_frame_enemy_count; ++entity_index)
+    {
+        EntityWorld_Spawn(&state->game->entities, EntityKind_Enemy, state->points_b[entity_index % bench_array_count],
+                          0.0f, 0.0f, 0.0f, 8.0f);
+    }
+    
+    // NOTE(christian): the software scene is built once, every software case draws the same batches.
+    state->sw_quad_render_batch = MemoryArena_PushStruct(arena, Quad_Render_Batch);
+    state->sw_render_batch = MemoryArena_PushStruct(arena, Render_Batch);
+    result = result && QuadRenderBatch_Init(state->sw_quad_render_batch);
+    result = result && RenderBatch_Init(state->sw_render_batch);
+    if (result)
+    {
+        RenderShards_Reset(state->render_shards);
+        Game_Render(state->game, 0.5f, state->render_shards, state->sw_quad_render_batch);
+        RenderShards_Merge(state->render_shards, state->sw_quad_render_batch, state->sw_render_batch);
+    }
+    return(result);
+}
+
+//~ NOTE(christian): harness
+function f64
+Bench_TimeRepetition(Bench_State *state, Bench_Proc *proc, u64 op_count)
+{
+    u64 begin_ticks = OS_GetTicks();
+    proc(state, op_count);
+    u64 end_ticks = OS_GetTicks();
+    f64 result = OS_SecondsBetweenTicksF64(begin_ticks, end_ticks) * 1.0e9;
+    return(result);
+}
+
+function int
+Bench_CompareF64(const void *a, const void *b)
+{
+    f64 left = *(f64 *)a;
+    f64 right = *(f64 *)b;
+    return((left > right) - (left < right));
+}
+
+// NOTE(christian): doubles the op count until a repetition takes min_ms, which also serves as warm up.
+function Bench_Result
+Bench_Run(Bench_State *state, Bench_Case *bench_case, u32 repetition_count, f64 min_ms)
+{
+    Bench_Result result = {0};
+    snprintf(result.name, sizeof(result.name), "%s", bench_case->name);
+    result.bytes_per_op = bench_case->bytes_per_op;
+    
+    u64 op_count = 1;
+    while ((Bench_TimeRepetition(state, bench_case->proc, op_count) < (min_ms * 1.0e6)) && (op_count < (1llu << 40)))
+    {
+        op_count *= 2;
+    }
+    
+    f64 samples[bench_max_repetitions];
+    repetition_count = Clamp(1, repetition_count, bench_max_repetitions);
+    for (u32 repetition_index = 0; repetition_index < repetition_count; ++repetition_index)
+    {
+        samples[repetition_index] = Bench_TimeRepetition(state, bench_case->proc, op_count) / (f64)op_count;
+        result.mean_ns += samples[repetition_index];
+    }
+    result.mean_ns /= (f64)repetition_count;
+    
+    for (u32 repetition_index = 0; repetition_index < repetition_count; ++repetition_index)
+    {
+        f64 delta = samples[repetition_index] - result.mean_ns;
+        result.stddev_ns += delta * delta;
+    }
+    result.stddev_ns = (repetition_count > 1) ? sqrt(result.stddev_ns / (f64)(repetition_count - 1)) : 0.0;
+    
+    qsort(samples, repetition_count, sizeof(f64), &Bench_CompareF64);
+    result.min_ns = samples[0];
+    result.median_ns = (repetition_count & 1) ? samples[repetition_count / 2] :
+        (0.5 * (samples[repetition_count / 2 - 1] + samples[repetition_count / 2]));
+    result.ops_per_repetition = op_count;
+    result.repetition_count = repetition_count;
+    return(result);
+}
+
+function void
+Bench_PrintResult(Bench_Result *result)
+{
+    f64 ops_per_second = (result->median_ns > 0.0) ? (1.0e9 / result->median_ns) : 0.0;
+    printf("%-28s %12.3f %12.3f %7.2f%% %12.3f ",
+           result->name, result->median_ns, result->mean_ns,
+           (result->mean_ns > 0.0) ? (100.0 * result->stddev_ns / result->mean_ns) : 0.0,
+           result->min_ns);
+    
+    // NOTE(christian): whole frames and the like are a small fraction of a million a second, those read better as ms/op.
+    if (result->median_ns >= bench_ms_per_op_threshold_ns)
+    {
+        printf("%12.3f ms/op", result->median_ns / 1.0e6);
+    }
+    else
+    {
+        printf("%12.3f M/s", ops_per_second / 1.0e6);
+    }
+    if (result->bytes_per_op > 0.0)
+    {
+        printf(" %10.1f MB/s", ops_per_second * result->bytes_per_op / (1024.0 * 1024.0));
+    }
+    printf("\n");
+}
+
+// NOTE(christian): the baseline is plain text, a comment line and then one case per line with
+// whitespace separated fields, so it diffs well and any script can read it.
+function b32
+Bench_WriteBaseline(char *path, Bench_Result *results, u32 result_count)
+{
+    b32 result = False;
+    FILE *file = fopen(path, "wb");
+    if (file)
+    {
+        fprintf(file, "# name median_ns mean_ns stddev_ns min_ns repetitions ops_per_repetition\n");
+        for (u32 result_index = 0; result_index < result_count; ++result_index)
+        {
+            Bench_Result *bench = results + result_index;
+            fprintf(file, "%s %.4f %.4f %.4f %.4f %u %llu\n", bench->name, bench->median_ns, bench->mean_ns,
+                    bench->stddev_ns, bench->min_ns, bench->repetition_count,
+                    (unsigned long long)bench->ops_per_repetition);
+        }
+        result = ferror(file) == 0;
+        fclose(file);
+    }
+    return(result);
+}
+
+function u32
+Bench_ReadBaseline(char *path, Bench_Result *results, u32 result_capacity)
+{
+    u32 result = 0;
+    FILE *file = fopen(path, "rb");
+    if (file)
+    {
+        char line[256];
+        while ((result < result_capacity) && fgets(line, sizeof(line), file))
+        {
+            Bench_Result *bench = results + result;
+            MemoryZero(bench, sizeof(Bench_Result));
+            unsigned long long ops_per_repetition = 0;
+            if ((line[0] != '#') &&
+                (sscanf(line, "%63s %lf %lf %lf %lf %u %llu", bench->name, &bench->median_ns, &bench->mean_ns,
+                        &bench->stddev_ns, &bench->min_ns, &bench->repetition_count, &ops_per_repetition) == 7))
+            {
+                bench->ops_per_repetition = ops_per_repetition;
+                ++result;
+            }
+        }
+        fclose(file);
+    }
+    return(result);
+}
+
+// NOTE(christian): a case regresses when its median moved up by more than threshold_percent and by
+// more than three times the noise of the two runs. returns how many did.
+function u32
+Bench_CompareBaseline(Bench_Result *baseline, u32 baseline_count, Bench_Result *results, u32 result_count, f64 threshold_percent)
+{
+    u32 result = 0;
+    printf("\n%-28s %12s %12s %9s\n", "vs baseline", "old ns/op", "new ns/op", "change");
+    for (u32 result_index = 0; result_index < result_count; ++result_index)
+    {
+        Bench_Result *current = results + result_index;
+        Bench_Result *old = null;
+        for (u32 baseline_index = 0; baseline_index < baseline_count; ++baseline_index)
+        {
+            if (!strcmp(baseline[baseline_index].name, current->name))
+            {
+                old = baseline + baseline_index;
+                break;
+            }
+        }
+        
+        if (!old || (old->median_ns <= 0.0))
+        {
+            printf("%-28s %12s %12.3f %9s\n", current->name, "-", current->median_ns, "new");
+            continue;
+        }
+        
+        f64 change_percent = 100.0 * (current->median_ns - old->median_ns) / old->median_ns;
+        f64 noise_ns = 3.0 * sqrt(old->stddev_ns * old->stddev_ns + current->stddev_ns * current->stddev_ns);
+        b32 regressed = (change_percent > threshold_percent) && ((current->median_ns - old->median_ns) > noise_ns);
+        b32 improved = (change_percent < -threshold_percent) && ((old->median_ns - current->median_ns) > noise_ns);
+        printf("%-28s %12.3f %12.3f %+8.2f%% %s\n", current->name, old->median_ns, current->median_ns, change_percent,
+               regressed ? "SLOWER" : (improved ? "faster" : ""));
+        result += regressed;
+    }
+    return(result);
+}
+
+// NOTE(christian): speedup of every sw_frame_t* case that ran over sw_frame_t1, and how much of a
+// perfect speedup that is. threads past the processor count can't add anything.
+function void
+Bench_PrintSoftwareScaling(Bench_Result *results, u32 result_count, u32 processor_count)
+{
+    Bench_Result *reference = null;
+    for (u32 result_index = 0; result_index < result_count; ++result_index)
+    {
+        if (!strcmp(results[result_index].name, "sw_frame_t1"))
+        {
+            reference = results + result_index;
+        }
+    }
+    
+    if (reference && (reference->median_ns > 0.0))
+    {
+        printf("\nsw scaling over sw_frame_t1, %u processors\n", processor_count);
+        for (u32 scaling_index = 0; scaling_index < bench_sw_scaling_count; ++scaling_index)
+        {
+            char name[bench_name_capacity];
+            snprintf(name, sizeof(name), "sw_frame_t%u", bench_sw_thread_counts[scaling_index]);
+            for (u32 result_index = 0; result_index < result_count; ++result_index)
+            {
+                Bench_Result *result = results + result_index;
+                if (!strcmp(result->name, name) && (result->median_ns > 0.0))
+                {
+                    f64 speedup = reference->median_ns / result->median_ns;
+                    u32 usable_threads = Min(bench_sw_thread_counts[scaling_index], Max(processor_count, 1));
+                    printf("  %2u threads %9.3f ms %6.2fx %6.1f%% of linear\n", bench_sw_thread_counts[scaling_index],
+                           result->median_ns / 1.0e6, speedup, 100.0 * speedup / (f64)usable_threads);
+                }
+            }
+        }
+    }
+}
+
+s32 main(s32 argument_count, char **arguments)
+{
+    OS_Init();
+    Profiler_Init();
+    
+    u32 repetition_count = bench_default_repetitions;
+    f64 min_ms = bench_default_min_ms;
+    f64 threshold_percent = bench_default_threshold_percent;
+    u32 thread_count = 1;
+    char *filter = null;
+    char *out_path = null;
+    char *compare_path = null;
+    for (s32 argument_index = 1; argument_index < argument_count; ++argument_index)
+    {
+        if (!strcmp(arguments[argument_index], "-reps") && ((argument_index + 1) < argument_count))
+        {
+            repetition_count = (u32)strtoul(arguments[++argument_index], null, 10);
+        }
+        else if (!strcmp(arguments[argument_index], "-min-ms") && ((argument_index + 1) < argument_count))
+        {
+            min_ms = strtod(arguments[++argument_index], null);
+        }
+        else if (!strcmp(arguments[argument_index], "-threshold") && ((argument_index + 1) < argument_count))
+        {
+            threshold_percent = strtod(arguments[++argument_index], null);
+        }
+        else if (!strcmp(arguments[argument_index], "-threads") && ((argument_index + 1) < argument_count))
+        {
+            // NOTE(christian): job threads for the frame cases. 1 by default so numbers compare across machines.
+            thread_count = (u32)strtoul(arguments[++argument_index], null, 10);
+        }
+        else if (!strcmp(arguments[argument_index], "-filter") && ((argument_index + 1) < argument_count))
+        {
+            // NOTE(christian): only cases whose name contains this.
+            filter = arguments[++argument_index];
+        }
+        else if (!strcmp(arguments[argument_index], "-out") && ((argument_index + 1) < argument_count))
+        {
+            out_path = arguments[++argument_index];
+        }
+        else if (!strcmp(arguments[argument_index], "-compare") && ((argument_index + 1) < argument_count))
+        {
+            compare_path = arguments[++argument_index];
+        }
+    }
+    
+    Bench_State *state = (Bench_State *)malloc(sizeof(Bench_State));
+    if (!state || !Bench_InitState(state, thread_count))
+    {
+        printf("failed to set up the benchmarks\n");
+        OS_Shutdown();
+        return(1);
+    }
+    
+    Bench_Case cases[] =
+    {
+        { "random_u32", &Bench_RandomU32, 4.0 },
+        { "random_u64", &Bench_RandomU64, 8.0 },
+        { "random_stream_u32", &Bench_RandomStreamU32, 4.0 },
+        { "random_fill_u32", &Bench_RandomFillU32, 4.0 },
+        { "random_fill_f32_range", &Bench_RandomFillF32, 4.0 },
+        { "random_fill_unit_v2f", &Bench_RandomFillUnitV2F, 8.0 },
+        { "utf8_decode", &Bench_DecodeUTF8, (f64)state->utf8_byte_count / (f64)bench_utf8_codepoint_count },
+        { "utf8_encode", &Bench_EncodeUTF8, (f64)state->utf8_byte_count / (f64)bench_utf8_codepoint_count },
+        { "utf8_validate", &Bench_ValidateUTF8, (f64)state->utf8_byte_count },
+        { "utf8_to_utf32", &Bench_TranscodeUTF32, (f64)state->utf8_byte_count },
+        { "utf8_to_utf16", &Bench_TranscodeUTF16, (f64)state->utf8_byte_count },
+        { "utf8_to_utf32_ascii", &Bench_TranscodeASCII, (f64)state->utf8_byte_count },
+        { "v2f_lerp_half", &Bench_V2FOps, 0.0 },
+        { "m44_multiply", &Bench_MatrixMultiply, 0.0 },
+        { "m44_transform_v4f", &Bench_MatrixTransformV4F, 0.0 },
+        { "m44_transform_points_v2f", &Bench_MatrixTransformPoints, 0.0 },
+        { "profiler_zone_overhead", &Bench_ProfilerZone, 2.0 * sizeof(Profile_Event) },
+        { "quad_push_rect_filled", &Bench_QuadPushRectFilled, sizeof(Quad) },
+        { "quad_push_circle_outline", &Bench_QuadPushCircleOutline, sizeof(Quad) },
+        { "text_push", &Bench_TextPush, sizeof(Quad) },
+        { "text_push_layout", &Bench_TextPushLayout, sizeof(Quad) },
+        { "spatial_build_20k", &Bench_SpatialBuild, 0.0 },
+        { "spatial_build_20k_parallel", &Bench_SpatialBuildParallel, 0.0 },
+        { "spatial_query_circle", &Bench_SpatialQueryCircle, 0.0 },
+        { "spatial_raycast", &Bench_SpatialRaycast, 0.0 },
+        { "spatial_collide_20k_2k", &Bench_SpatialCollide, 0.0 },
+        { "particles_update_200k", &Bench_ParticleUpdate, 0.0 },
+        { "particles_render_200k", &Bench_ParticleRender, 0.0 },
+        { "particles_frame_200k", &Bench_ParticleFrame, 0.0 },
+        { "batch_circle_outline_r6", &Bench_CircleOutlineSmall, 0.0 },
+        { "batch_circle_outline_r96", &Bench_CircleOutlineLarge, 0.0 },
+        { "frame_quads_4k", &Bench_FrameQuads, 0.0 },
+        { "frame_game_6k", &Bench_FrameGame, 0.0 },
+        { "sw_frame_t1", &Bench_SoftwareFrame1, 0.0 },
+        { "sw_frame_t2", &Bench_SoftwareFrame2, 0.0 },
+        { "sw_frame_t4", &Bench_SoftwareFrame4, 0.0 },
+        { "sw_frame_t8", &Bench_SoftwareFrame8, 0.0 },
+        { "sw_frame_t16", &Bench_SoftwareFrame16, 0.0 },
+    };
+    
+    Bench_Check checks[] =
+    {
+        { "check_philox_known_answers", &Bench_CheckPhiloxKnownAnswers },
+        { "check_lanes_match_scalar", &Bench_CheckLanesMatchScalar },
+    };
+    
+    s32 exit_code = 0;
+    u32 check_count = 0;
+    for (u32 check_index = 0; check_index < ArrayCount(checks); ++check_index)
+    {
+        if (filter && !strstr(checks[check_index].name, filter))
+        {
+            continue;
+        }
+        
+        b32 passed = checks[check_index].proc(state);
+        printf("%-28s %s\n", checks[check_index].name, passed ? "ok" : "FAILED");
+        exit_code = passed ? exit_code : 3;
+        ++check_count;
+    }
+    if (check_count)
+    {
+        printf("\n");
+    }
+    
+    printf("%u repetitions, >= %.1f ms each, %u job threads, lane width %u\n\n",
+           repetition_count, min_ms, state->jobs->thread_count, lane_width);
+    printf("%-28s %12s %12s %8s %12s %16s\n", "case", "median ns/op", "mean ns/op", "stddev", "min ns/op", "throughput");
+    
+    Bench_Result results[bench_max_cases];
+    u32 result_count = 0;
+    for (u32 case_index = 0; (case_index < ArrayCount(cases)) && (result_count < bench_max_cases); ++case_index)
+    {
+        if (filter && !strstr(cases[case_index].name, filter))
+        {
+            continue;
+        }
+        
+        Bench_Result *result = results + result_count++;
+        *result = Bench_Run(state, cases + case_index, repetition_count, min_ms);
+        Bench_PrintResult(result);
+    }
+    
+    Bench_PrintSoftwareScaling(results, result_count, OS_GetProcessorCount());
+    
+    if (out_path && !Bench_WriteBaseline(out_path, results, result_count))
+    {
+        printf("failed to write %s\n", out_path);
+        exit_code = 1;
+    }
+    
+    if (compare_path)
+    {
+        Bench_Result baseline[bench_max_cases];
+        u32 baseline_count = Bench_ReadBaseline(compare_path, baseline, bench_max_cases);
+        if (!baseline_count)
+        {
+            printf("failed to read %s\n", compare_path);
+            exit_code = 1;
+        }
+        else if (Bench_CompareBaseline(baseline, baseline_count, results, result_count, threshold_percent))
+        {
+            exit_code = 2;
+        }
+    }
+    
+    OS_Shutdown();
+    return(exit_code);
+}
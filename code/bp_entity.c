@@ -0,0 +1,309 @@
+function void
+EntityPool_Init(Entity_Pool *pool, Memory_Arena *arena, Entity_Kind kind, u32 capacity, u32 flags)
+{
+    pool->kind = kind;
+    pool->flags = flags;
+    pool->capacity = capacity;
+    pool->count = 0;
+    
+    pool->x = MemoryArena_PushArray(arena, f32, capacity);
+    pool->y = MemoryArena_PushArray(arena, f32, capacity);
+    pool->dx = MemoryArena_PushArray(arena, f32, capacity);
+    pool->dy = MemoryArena_PushArray(arena, f32, capacity);
+    pool->angle = MemoryArena_PushArray(arena, f32, capacity);
+    pool->speed = MemoryArena_PushArray(arena, f32, capacity);
+    pool->lifetime = MemoryArena_PushArray(arena, f32, capacity);
+    pool->radius = MemoryArena_PushArray(arena, f32, capacity);
+    pool->dense_to_slot = MemoryArena_PushArray(arena, u32, capacity);
+    pool->previous_x = MemoryArena_PushArray(arena, f32, capacity);
+    pool->previous_y = MemoryArena_PushArray(arena, f32, capacity);
+    
+    pool->slot_to_dense = MemoryArena_PushArray(arena, u32, capacity);
+    pool->slot_generation = MemoryArena_PushArray(arena, u32, capacity);
+    pool->free_slots = MemoryArena_PushArray(arena, u32, capacity);
+    pool->free_slot_count = capacity;
+    
+    // NOTE(christian): generations start at 1 so a zeroed handle never resolves.
+    // free slots are stacked in reverse so slot 0 comes out first.
+    for (u32 slot_index = 0; slot_index < capacity; ++slot_index)
+    {
+        pool->slot_to_dense[slot_index] = entity_invalid_index;
+        pool->slot_generation[slot_index] = 1;
+        pool->free_slots[slot_index] = capacity - slot_index - 1;
+    }
+}
+
+function Entity_Handle
+EntityPool_Spawn(Entity_Pool *pool, v2f p, f32 angle, f32 speed, f32 lifetime, f32 radius)
+{
+    Entity_Handle result = {0};
+    if (pool->free_slot_count)
+    {
+        u32 slot = pool->free_slots[--pool->free_slot_count];
+        u32 dense_index = pool->count++;
+        
+        pool->x[dense_index] = p.x;
+        pool->y[dense_index] = p.y;
+        pool->dx[dense_index] = 0.0f;
+        pool->dy[dense_index] = 0.0f;
+        pool->angle[dense_index] = angle;
+        pool->speed[dense_index] = speed;
+        pool->lifetime[dense_index] = lifetime;
+        pool->radius[dense_index] = radius;
+        pool->dense_to_slot[dense_index] = slot;
+        pool->previous_x[dense_index] = p.x;
+        pool->previous_y[dense_index] = p.y;
+        pool->slot_to_dense[slot] = dense_index;
+        
+        result.kind = pool->kind;
+        result.slot = slot;
+        result.generation = pool->slot_generation[slot];
+    }
+    
+    return(result);
+}
+
+// NOTE(christian): swap-remove. the last entity moves into dense_index, so callers walking the
+// arrays front to back have to look at dense_index again.
+function void
+EntityPool_RemoveAt(Entity_Pool *pool, u32 dense_index)
+{
+    Assert(dense_index < pool->count);
+    
+    u32 slot = pool->dense_to_slot[dense_index];
+    u32 last_index = --pool->count;
+    if (dense_index != last_index)
+    {
+        pool->x[dense_index] = pool->x[last_index];
+        pool->y[dense_index] = pool->y[last_index];
+        pool->dx[dense_index] = pool->dx[last_index];
+        pool->dy[dense_index] = pool->dy[last_index];
+        pool->angle[dense_index] = pool->angle[last_index];
+        pool->speed[dense_index] = pool->speed[last_index];
+        pool->lifetime[dense_index] = pool->lifetime[last_index];
+        pool->radius[dense_index] = pool->radius[last_index];
+        pool->previous_x[dense_index] = pool->previous_x[last_index];
+        pool->previous_y[dense_index] = pool->previous_y[last_index];
+        
+        u32 moved_slot = pool->dense_to_slot[last_index];
+        pool->dense_to_slot[dense_index] = moved_slot;
+        pool->slot_to_dense[moved_slot] = dense_index;
+    }
+    
+    pool->slot_to_dense[slot] = entity_invalid_index;
+    pool->slot_generation[slot] += 1;
+    pool->free_slots[pool->free_slot_count++] = slot;
+}
+
+inline u32
+EntityPool_IndexFromHandle(Entity_Pool *pool, Entity_Handle handle)
+{
+    u32 result = entity_invalid_index;
+    if ((handle.slot < pool->capacity) && (pool->slot_generation[handle.slot] == handle.generation))
+    {
+        result = pool->slot_to_dense[handle.slot];
+    }
+    return(result);
+}
+
+inline v2f
+EntityPool_InterpolatedP(Entity_Pool *pool, u32 dense_index, f32 interpolation)
+{
+    f32 previous_x = pool->previous_x[dense_index];
+    f32 previous_y = pool->previous_y[dense_index];
+    v2f result = V2F((pool->x[dense_index] - previous_x) * interpolation + previous_x,
+                     (pool->y[dense_index] - previous_y) * interpolation + previous_y);
+    return(result);
+}
+
+function void
+EntityWorld_Init(Entity_World *world, Memory_Arena *arena)
+{
+    EntityPool_Init(world->pools + EntityKind_Ship, arena, EntityKind_Ship, 4, 0);
+    EntityPool_Init(world->pools + EntityKind_Projectile, arena, EntityKind_Projectile, 65536,
+                    EntityPoolFlag_SteerFromAngle | EntityPoolFlag_Ages | EntityPoolFlag_DespawnOutside);
+    EntityPool_Init(world->pools + EntityKind_Enemy, arena, EntityKind_Enemy, 16384,
+                    EntityPoolFlag_SteerFromAngle | EntityPoolFlag_DespawnOutside);
+    EntityPool_Init(world->pools + EntityKind_Pickup, arena, EntityKind_Pickup, 4096,
+                    EntityPoolFlag_SteerFromAngle | EntityPoolFlag_Ages);
+}
+
+inline Entity_Handle
+EntityWorld_Spawn(Entity_World *world, Entity_Kind kind, v2f p, f32 angle, f32 speed, f32 lifetime, f32 radius)
+{
+    Entity_Handle result = EntityPool_Spawn(world->pools + kind, p, angle, speed, lifetime, radius);
+    return(result);
+}
+
+inline void
+EntityWorld_Despawn(Entity_World *world, Entity_Handle handle)
+{
+    if (handle.kind < EntityKind_Count)
+    {
+        Entity_Pool *pool = world->pools + handle.kind;
+        u32 dense_index = EntityPool_IndexFromHandle(pool, handle);
+        if (dense_index != entity_invalid_index)
+        {
+            EntityPool_RemoveAt(pool, dense_index);
+        }
+    }
+}
+
+inline b32
+EntityWorld_IsAlive(Entity_World *world, Entity_Handle handle)
+{
+    b32 result = False;
+    if (handle.kind < EntityKind_Count)
+    {
+        result = EntityPool_IndexFromHandle(world->pools + handle.kind, handle) != entity_invalid_index;
+    }
+    return(result);
+}
+
+//~ NOTE(christian): batch kernels
+function void
+EntityPool_SavePrevious(Entity_Pool *pool)
+{
+    MemoryCopy(pool->previous_x, pool->x, sizeof(f32) * pool->count);
+    MemoryCopy(pool->previous_y, pool->y, sizeof(f32) * pool->count);
+}
+
+function void
+EntityPool_SteerFromAngles(Entity_Pool *pool, u32 first, u32 one_past_last)
+{
+    u32 count = one_past_last;
+    u32 index = first;
+    for (; (index + lane_width) <= count; index += lane_width)
+    {
+        lane_f32 angle = LaneF32_Load(pool->angle + index);
+        lane_f32 speed = LaneF32_Load(pool->speed + index);
+        LaneF32_Store(pool->dx + index, LaneF32_Multiply(LaneF32_CosApprox(angle), speed));
+        LaneF32_Store(pool->dy + index, LaneF32_Multiply(LaneF32_SinApprox(angle), speed));
+    }
+    
+    for (; index < count; ++index)
+    {
+        pool->dx[index] = CosApproxF32(pool->angle[index]) * pool->speed[index];
+        pool->dy[index] = SinApproxF32(pool->angle[index]) * pool->speed[index];
+    }
+}
+
+function void
+EntityPool_Move(Entity_Pool *pool, u32 first, u32 one_past_last, f32 delta_time)
+{
+    BatchV2F_MulAdd(pool->x + first, pool->y + first, pool->dx + first, pool->dy + first,
+                    delta_time, one_past_last - first);
+}
+
+function void
+EntityPool_Age(Entity_Pool *pool, u32 first, u32 one_past_last, f32 delta_time)
+{
+    u32 count = one_past_last;
+    lane_f32 delta_time_wide = LaneF32_Set1(delta_time);
+    u32 index = first;
+    for (; (index + lane_width) <= count; index += lane_width)
+    {
+        LaneF32_Store(pool->lifetime + index, LaneF32_Subtract(LaneF32_Load(pool->lifetime + index), delta_time_wide));
+    }
+    
+    for (; index < count; ++index)
+    {
+        pool->lifetime[index] -= delta_time;
+    }
+}
+
+function void
+EntityPool_RemoveDead(Entity_Pool *pool, v2f play_field_dims)
+{
+    b32 ages = pool->flags & EntityPoolFlag_Ages;
+    b32 despawn_outside = pool->flags & EntityPoolFlag_DespawnOutside;
+    if (ages || despawn_outside)
+    {
+        // NOTE(christian): walk backwards so whatever swap-remove pulls in was already checked.
+        for (u32 index = pool->count; index > 0; --index)
+        {
+            u32 dense_index = index - 1;
+            f32 x = pool->x[dense_index];
+            f32 y = pool->y[dense_index];
+            f32 radius = pool->radius[dense_index];
+            
+            b32 dead = ages && (pool->lifetime[dense_index] <= 0.0f);
+            dead = dead || (despawn_outside &&
+                            (((x + radius) < 0.0f) || ((x - radius) > play_field_dims.x) ||
+                             ((y + radius) < 0.0f) || ((y - radius) > play_field_dims.y)));
+            if (dead)
+            {
+                EntityPool_RemoveAt(pool, dense_index);
+            }
+        }
+    }
+}
+
+// NOTE(christian): removes every entity whose mark, indexed by dense index, is non-zero.
+function void
+EntityPool_RemoveMarked(Entity_Pool *pool, u32 *marks)
+{
+    for (u32 index = pool->count; index > 0; --index)
+    {
+        u32 dense_index = index - 1;
+        if (marks[dense_index])
+        {
+            EntityPool_RemoveAt(pool, dense_index);
+        }
+    }
+}
+
+function void
+EntityWorld_SavePrevious(Entity_World *world)
+{
+    for (u32 kind = 0; kind < EntityKind_Count; ++kind)
+    {
+        EntityPool_SavePrevious(world->pools + kind);
+    }
+}
+
+typedef struct Entity_Update_Job
+{
+    Entity_Pool *pool;
+    f32 delta_time;
+} Entity_Update_Job;
+
+function void
+EntityPool_UpdateJob(void *data, u32 first, u32 one_past_last)
+{
+    Entity_Update_Job *job = (Entity_Update_Job *)data;
+    Entity_Pool *pool = job->pool;
+    if (pool->flags & EntityPoolFlag_SteerFromAngle)
+    {
+        EntityPool_SteerFromAngles(pool, first, one_past_last);
+    }
+    
+    EntityPool_Move(pool, first, one_past_last, job->delta_time);
+    
+    if (pool->flags & EntityPoolFlag_Ages)
+    {
+        EntityPool_Age(pool, first, one_past_last, job->delta_time);
+    }
+}
+
+// NOTE(christian): the per entity kernels fan out over every pool at once. removal reorders the
+// dense arrays, so it waits for all of them and runs serially.
+function void
+EntityWorld_Update(Entity_World *world, Job_System *jobs, f32 delta_time, v2f play_field_dims)
+{
+    Entity_Update_Job update_jobs[EntityKind_Count];
+    Job_Counter update_counter = {0};
+    for (u32 kind = 0; kind < EntityKind_Count; ++kind)
+    {
+        update_jobs[kind].pool = world->pools + kind;
+        update_jobs[kind].delta_time = delta_time;
+        JobSystem_ParallelFor(jobs, &update_counter, world->pools[kind].count, entity_update_batch_size,
+                              &EntityPool_UpdateJob, update_jobs + kind);
+    }
+    JobSystem_Wait(jobs, &update_counter);
+    
+    for (u32 kind = 0; kind < EntityKind_Count; ++kind)
+    {
+        EntityPool_RemoveDead(world->pools + kind, play_field_dims);
+    }
+}
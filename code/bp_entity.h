@@ -0,0 +1,95 @@
+/* date = October 17th 2026 2:10 pm */
+
+#ifndef BP_ENTITY_H
+#define BP_ENTITY_H
+
+// NOTE(christian): one pool per kind. components live in tight arrays indexed by a dense index
+// in [0, count). handles name a slot instead, which maps to the dense index and survives
+// swap-removes. the slot's generation goes up every time it is freed so stale handles miss.
+typedef enum Entity_Kind
+{
+    EntityKind_Ship,
+    EntityKind_Projectile,
+    EntityKind_Enemy,
+    EntityKind_Pickup,
+    EntityKind_Count,
+} Entity_Kind;
+
+typedef enum Entity_Pool_Flag
+{
+    // NOTE(christian): velocity is recomputed each update from angle and speed.
+    EntityPoolFlag_SteerFromAngle = (1 << 0),
+    // NOTE(christian): lifetime counts down and the entity dies at zero.
+    EntityPoolFlag_Ages = (1 << 1),
+    // NOTE(christian): dies once it is fully outside the play field.
+    EntityPoolFlag_DespawnOutside = (1 << 2),
+} Entity_Pool_Flag;
+
+#define entity_invalid_index 0xFFFFFFFF
+
+// NOTE(christian): entities per update job. a multiple of lane_width so only the last job has a scalar tail.
+#define entity_update_batch_size 4096
+
+typedef struct Entity_Handle
+{
+    u32 kind;
+    u32 slot;
+    u32 generation;
+} Entity_Handle;
+
+typedef struct Entity_Pool
+{
+    Entity_Kind kind;
+    u32 flags;
+    u32 capacity;
+    u32 count;
+    
+    // NOTE(christian): dense components.
+    f32 *x;
+    f32 *y;
+    f32 *dx;
+    f32 *dy;
+    f32 *angle;
+    f32 *speed;
+    f32 *lifetime;
+    f32 *radius;
+    u32 *dense_to_slot;
+    
+    // NOTE(christian): position as of the previous sim tick, for render interpolation.
+    f32 *previous_x;
+    f32 *previous_y;
+    
+    // NOTE(christian): sparse slots.
+    u32 *slot_to_dense;
+    u32 *slot_generation;
+    u32 *free_slots;
+    u32 free_slot_count;
+} Entity_Pool;
+
+typedef struct Entity_World
+{
+    Entity_Pool pools[EntityKind_Count];
+} Entity_World;
+
+function void EntityPool_Init(Entity_Pool *pool, Memory_Arena *arena, Entity_Kind kind, u32 capacity, u32 flags);
+function Entity_Handle EntityPool_Spawn(Entity_Pool *pool, v2f p, f32 angle, f32 speed, f32 lifetime, f32 radius);
+function void EntityPool_RemoveAt(Entity_Pool *pool, u32 dense_index);
+inline u32 EntityPool_IndexFromHandle(Entity_Pool *pool, Entity_Handle handle);
+inline v2f EntityPool_InterpolatedP(Entity_Pool *pool, u32 dense_index, f32 interpolation);
+
+function void EntityWorld_Init(Entity_World *world, Memory_Arena *arena);
+inline Entity_Handle EntityWorld_Spawn(Entity_World *world, Entity_Kind kind, v2f p, f32 angle, f32 speed, f32 lifetime, f32 radius);
+inline void EntityWorld_Despawn(Entity_World *world, Entity_Handle handle);
+inline b32 EntityWorld_IsAlive(Entity_World *world, Entity_Handle handle);
+
+//~ NOTE(christian): batch kernels
+function void EntityPool_SavePrevious(Entity_Pool *pool);
+function void EntityPool_SteerFromAngles(Entity_Pool *pool, u32 first, u32 one_past_last);
+function void EntityPool_Move(Entity_Pool *pool, u32 first, u32 one_past_last, f32 delta_time);
+function void EntityPool_Age(Entity_Pool *pool, u32 first, u32 one_past_last, f32 delta_time);
+function void EntityPool_RemoveDead(Entity_Pool *pool, v2f play_field_dims);
+function void EntityPool_RemoveMarked(Entity_Pool *pool, u32 *marks);
+function void EntityWorld_SavePrevious(Entity_World *world);
+function void EntityWorld_Update(Entity_World *world, Job_System *jobs, f32 delta_time, v2f play_field_dims);
+
+#endif //BP_ENTITY_H
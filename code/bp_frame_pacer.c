@@ -0,0 +1,108 @@
+function void
+FramePacer_Init(Frame_Pacer *pacer, u64 ticks_per_frame)
+{
+    MemoryZero(pacer, sizeof(Frame_Pacer));
+    
+    u64 now_ticks = OS_GetTicks();
+    pacer->ticks_per_frame = ticks_per_frame;
+    pacer->next_deadline_ticks = now_ticks + ticks_per_frame;
+    pacer->last_frame_end_ticks = now_ticks;
+    
+    pacer->min_spin_ticks = OS_TicksFromSecondsF64(frame_pacer_min_spin_seconds);
+    pacer->max_spin_ticks = OS_TicksFromSecondsF64(frame_pacer_max_spin_seconds);
+    pacer->spin_ticks = pacer->max_spin_ticks;
+}
+
+// NOTE(christian): returns the tick the frame ended on, which is where the next one starts.
+function u64
+FramePacer_Wait(Frame_Pacer *pacer)
+{
+    u64 now_ticks = OS_GetTicks();
+    u64 deadline_ticks = pacer->next_deadline_ticks;
+    if (now_ticks < deadline_ticks)
+    {
+        if ((deadline_ticks - now_ticks) > pacer->spin_ticks)
+        {
+            u64 wake_ticks = deadline_ticks - pacer->spin_ticks;
+            OS_SleepUntilTicks(wake_ticks);
+            
+            // NOTE(christian): grow straight to the worst oversleep plus a quarter, shrink 1/32 at a time.
+            u64 woke_ticks = OS_GetTicks();
+            u64 oversleep_ticks = (woke_ticks > wake_ticks) ? (woke_ticks - wake_ticks) : 0;
+            u64 wanted_spin_ticks = oversleep_ticks + oversleep_ticks / 4;
+            if (wanted_spin_ticks > pacer->spin_ticks)
+            {
+                pacer->spin_ticks = wanted_spin_ticks;
+            }
+            else
+            {
+                pacer->spin_ticks -= (pacer->spin_ticks - wanted_spin_ticks) / 32;
+            }
+            
+            pacer->spin_ticks = Clamp(pacer->min_spin_ticks, pacer->spin_ticks, pacer->max_spin_ticks);
+        }
+        
+        while ((now_ticks = OS_GetTicks()) < deadline_ticks)
+        {
+            SpinPause();
+        }
+        
+        pacer->next_deadline_ticks = deadline_ticks + pacer->ticks_per_frame;
+    }
+    else
+    {
+        // NOTE(christian): missed it. start over from now instead of rushing the next frames to catch up.
+        ++pacer->missed_deadline_count;
+        pacer->next_deadline_ticks = now_ticks + pacer->ticks_per_frame;
+    }
+    
+    pacer->frame_ticks[pacer->frame_count % frame_pacer_history_count] = now_ticks - pacer->last_frame_end_ticks;
+    ++pacer->frame_count;
+    pacer->last_frame_end_ticks = now_ticks;
+    return(now_ticks);
+}
+
+function int
+FramePacer_CompareTicks(const void *a, const void *b)
+{
+    u64 ticks_a = *(const u64 *)a;
+    u64 ticks_b = *(const u64 *)b;
+    int result = (ticks_a > ticks_b) - (ticks_a < ticks_b);
+    return(result);
+}
+
+function Frame_Pacer_Stats
+FramePacer_GetStats(Frame_Pacer *pacer)
+{
+    Frame_Pacer_Stats result = {0};
+    result.frame_count = pacer->frame_count;
+    result.missed_deadline_count = pacer->missed_deadline_count;
+    result.target_ms = 1000.0 * OS_SecondsBetweenTicksF64(0, pacer->ticks_per_frame);
+    
+    u32 sample_count = Min(pacer->frame_count, frame_pacer_history_count);
+    if (sample_count)
+    {
+        Temporary_Memory scratch = Scratch_Begin(null, 0);
+        u64 *sorted = MemoryArena_PushArray(scratch.arena, u64, sample_count);
+        u64 *jitter = MemoryArena_PushArray(scratch.arena, u64, sample_count);
+        for (u32 sample_index = 0; sample_index < sample_count; ++sample_index)
+        {
+            u64 frame_ticks = pacer->frame_ticks[sample_index];
+            sorted[sample_index] = frame_ticks;
+            jitter[sample_index] = (frame_ticks > pacer->ticks_per_frame) ?
+                (frame_ticks - pacer->ticks_per_frame) : (pacer->ticks_per_frame - frame_ticks);
+        }
+        
+        qsort(sorted, sample_count, sizeof(u64), &FramePacer_CompareTicks);
+        qsort(jitter, sample_count, sizeof(u64), &FramePacer_CompareTicks);
+        
+        result.p50_ms = 1000.0 * OS_SecondsBetweenTicksF64(0, sorted[((sample_count - 1) * 50) / 100]);
+        result.p90_ms = 1000.0 * OS_SecondsBetweenTicksF64(0, sorted[((sample_count - 1) * 90) / 100]);
+        result.p99_ms = 1000.0 * OS_SecondsBetweenTicksF64(0, sorted[((sample_count - 1) * 99) / 100]);
+        result.max_ms = 1000.0 * OS_SecondsBetweenTicksF64(0, sorted[sample_count - 1]);
+        result.p99_jitter_ms = 1000.0 * OS_SecondsBetweenTicksF64(0, jitter[((sample_count - 1) * 99) / 100]);
+        Scratch_End(scratch);
+    }
+    
+    return(result);
+}
@@ -0,0 +1,47 @@
+/* date = October 17th 2026 3:05 pm */
+
+#ifndef BP_FRAME_PACER_H
+#define BP_FRAME_PACER_H
+
+// NOTE(christian): deadlines are absolute and advance by exactly one frame, so a late wake-up
+// doesn't push every frame after it back. the pacer sleeps until spin_ticks before the deadline
+// and spins the rest. spin_ticks follows the worst oversleep it has seen and decays slowly.
+#define frame_pacer_history_count 4096
+#define frame_pacer_min_spin_seconds 0.0002
+#define frame_pacer_max_spin_seconds 0.004
+
+typedef struct Frame_Pacer
+{
+    u64 ticks_per_frame;
+    u64 next_deadline_ticks;
+    u64 last_frame_end_ticks;
+    
+    u64 spin_ticks;
+    u64 min_spin_ticks;
+    u64 max_spin_ticks;
+    
+    // NOTE(christian): ring of measured frame durations, begin to begin.
+    u64 frame_ticks[frame_pacer_history_count];
+    u32 frame_count;
+    u32 missed_deadline_count;
+} Frame_Pacer;
+
+typedef struct Frame_Pacer_Stats
+{
+    u32 frame_count;
+    u32 missed_deadline_count;
+    f64 target_ms;
+    f64 p50_ms;
+    f64 p90_ms;
+    f64 p99_ms;
+    f64 max_ms;
+    
+    // NOTE(christian): 99th percentile of |frame - target|.
+    f64 p99_jitter_ms;
+} Frame_Pacer_Stats;
+
+function void FramePacer_Init(Frame_Pacer *pacer, u64 ticks_per_frame);
+function u64 FramePacer_Wait(Frame_Pacer *pacer);
+function Frame_Pacer_Stats FramePacer_GetStats(Frame_Pacer *pacer);
+
+#endif //BP_FRAME_PACER_H
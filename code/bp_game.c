@@ -0,0 +1,333 @@
+function void
+Game_InitParticles(Game_State *game)
+{
+    Particle_System *particles = &game->particles;
+    ParticleSystem_Init(particles, game_particle_seed);
+    
+    Particle_Style exhaust_style = {0};
+    exhaust_style.colour_start = RGBA(1.0f, 0.8f, 0.3f, 1.0f);
+    exhaust_style.colour_end = RGBA(1.0f, 0.2f, 0.1f, 0.0f);
+    exhaust_style.colour_ease = ParticleEase_OutQuart;
+    exhaust_style.size_start = 3.0f;
+    exhaust_style.size_end = 0.5f;
+    exhaust_style.size_ease = ParticleEase_Linear;
+    exhaust_style.drag = 2.0f;
+    exhaust_style.roundness = 1.0f;
+    
+    Particle_Emitter *exhaust = &game->exhaust_emitter;
+    MemoryZero(exhaust, sizeof(Particle_Emitter));
+    exhaust->pool_index = ParticleSystem_AddPool(particles, &game->level_arena, &exhaust_style, game_exhaust_particle_capacity);
+    exhaust->spread = 0.35f;
+    exhaust->speed_min = 20.0f;
+    exhaust->speed_max = 40.0f;
+    exhaust->lifetime_min = 0.3f;
+    exhaust->lifetime_max = 0.6f;
+    exhaust->size_min = 0.8f;
+    exhaust->size_max = 1.2f;
+    exhaust->rate = 60.0f;
+    
+    Particle_Style explosion_style = {0};
+    explosion_style.colour_start = RGBA(1.0f, 1.0f, 1.0f, 1.0f);
+    explosion_style.colour_end = RGBA(1.0f, 0.3f, 0.3f, 0.0f);
+    explosion_style.colour_ease = ParticleEase_InQuart;
+    explosion_style.size_start = 1.0f;
+    explosion_style.size_end = 0.0f;
+    explosion_style.size_ease = ParticleEase_OutQuart;
+    explosion_style.drag = 3.0f;
+    explosion_style.stretch = 0.05f;
+    
+    Particle_Emitter *explosion = &game->explosion_emitter;
+    MemoryZero(explosion, sizeof(Particle_Emitter));
+    explosion->pool_index = ParticleSystem_AddPool(particles, &game->level_arena, &explosion_style, game_explosion_particle_capacity);
+    explosion->spread = pi_F32;
+    explosion->speed_min = 60.0f;
+    explosion->speed_max = 180.0f;
+    explosion->lifetime_min = 0.3f;
+    explosion->lifetime_max = 0.7f;
+    explosion->size_min = 1.5f;
+    explosion->size_max = 2.5f;
+}
+
+function void
+Game_BeginLevel(Game_State *game)
+{
+    MemoryArena_Reset(&game->level_arena);
+    
+    EntityWorld_Init(&game->entities, &game->level_arena);
+    
+    v2f play_field_dims = game->play_field_dims;
+    Entity_Pool *projectiles = game->entities.pools + EntityKind_Projectile;
+    Entity_Pool *enemies = game->entities.pools + EntityKind_Enemy;
+    SpatialGrid_Init(&game->projectile_grid, &game->level_arena, V2F(0.0f, 0.0f), play_field_dims,
+                     game_collision_cell_size, projectiles->capacity);
+    game->projectile_hits = MemoryArena_PushArray(&game->level_arena, u32, projectiles->capacity);
+    game->enemy_hits = MemoryArena_PushArray(&game->level_arena, u32, enemies->capacity);
+    Game_InitParticles(game);
+    
+    game->ship = EntityWorld_Spawn(&game->entities, EntityKind_Ship,
+                                   V2F(play_field_dims.x * 0.5f, play_field_dims.y * 0.5f),
+                                   0.0f, 40.0f, 0.0f, 16.0f);
+    
+    if (game->glyph_atlas)
+    {
+        game->title_layout = TextLayout_Build(game->glyph_atlas, &game->level_arena, Str8Lit("BYTEPATH"), game_hud_text_scale);
+    }
+}
+
+function void
+Game_Init(Game_State *game, v2f play_field_dims, Job_System *jobs, Glyph_Atlas *glyph_atlas)
+{
+    game->play_field_dims = play_field_dims;
+    game->jobs = jobs;
+    game->glyph_atlas = glyph_atlas;
+    MemoryArena_Init(&game->level_arena, game_level_arena_reserve);
+    Game_BeginLevel(game);
+}
+
+function void
+Game_CollideEnemiesJob(void *data, u32 first, u32 one_past_last)
+{
+    Game_State *game = (Game_State *)data;
+    Entity_Pool *enemies = game->entities.pools + EntityKind_Enemy;
+    u32 overlaps[game_collision_query_capacity];
+    for (u32 enemy_index = first; enemy_index < one_past_last; ++enemy_index)
+    {
+        u32 overlap_count = SpatialGrid_QueryCircle(&game->projectile_grid, V2F(enemies->x[enemy_index], enemies->y[enemy_index]),
+                                                    enemies->radius[enemy_index], overlaps, ArrayCount(overlaps));
+        game->enemy_hits[enemy_index] = (overlap_count != 0);
+        
+        // NOTE(christian): other jobs can mark the same projectile. they all store 1, so who wins doesn't matter.
+        overlap_count = Min(overlap_count, ArrayCount(overlaps));
+        for (u32 overlap_index = 0; overlap_index < overlap_count; ++overlap_index)
+        {
+            AtomicStoreU32(game->projectile_hits + overlaps[overlap_index], 1);
+        }
+    }
+}
+
+// NOTE(christian): a projectile and an enemy that touch both die. marks first, then removal, so the
+// outcome doesn't depend on the order the jobs ran in.
+function void
+Game_CollideProjectiles(Game_State *game)
+{
+    Entity_Pool *projectiles = game->entities.pools + EntityKind_Projectile;
+    Entity_Pool *enemies = game->entities.pools + EntityKind_Enemy;
+    if (projectiles->count && enemies->count)
+    {
+        SpatialGrid_BuildParallel(&game->projectile_grid, game->jobs, projectiles->x, projectiles->y,
+                                  projectiles->radius, projectiles->count);
+        MemoryZero(game->projectile_hits, sizeof(u32) * projectiles->count);
+        
+        Job_Counter collide_counter = {0};
+        JobSystem_ParallelFor(game->jobs, &collide_counter, enemies->count, game_collision_batch_size,
+                              &Game_CollideEnemiesJob, game);
+        JobSystem_Wait(game->jobs, &collide_counter);
+        
+        for (u32 enemy_index = 0; enemy_index < enemies->count; ++enemy_index)
+        {
+            if (game->enemy_hits[enemy_index])
+            {
+                game->explosion_emitter.p = V2F(enemies->x[enemy_index], enemies->y[enemy_index]);
+                ParticleSystem_Emit(&game->particles, &game->explosion_emitter, game_explosion_particle_count);
+            }
+        }
+        
+        EntityPool_RemoveMarked(projectiles, game->projectile_hits);
+        EntityPool_RemoveMarked(enemies, game->enemy_hits);
+    }
+}
+
+function void
+Game_Update(Game_State *game, f32 delta_time)
+{
+    EntityWorld_SavePrevious(&game->entities);
+    
+    Entity_Pool *ships = game->entities.pools + EntityKind_Ship;
+    u32 ship_index = EntityPool_IndexFromHandle(ships, game->ship);
+    if (ship_index != entity_invalid_index)
+    {
+        f32 *angle = ships->angle + ship_index;
+        v2f dP = V2F(0, 0);
+        
+        if (OS_KeyHeld(KeyCode_UpArrow))
+        {
+            dP.x = cosf(*angle);
+            dP.y = sinf(*angle);
+        }
+        
+        if (OS_KeyHeld(KeyCode_DownArrow))
+        {
+            dP.x = -cosf(*angle);
+            dP.y = -sinf(*angle);
+        }
+        
+        if (OS_KeyHeld(KeyCode_RightArrow))
+        {
+            *angle += delta_time;
+        }
+        
+        if (OS_KeyHeld(KeyCode_LeftArrow))
+        {
+            *angle -= delta_time;
+        }
+        
+        if (*angle >= two_pi_F32)
+        {
+            *angle = 0.0f;
+        }
+        else if (*angle <= 0.0f)
+        {
+            *angle = two_pi_F32;
+        }
+        
+        if (dP.x && dP.y)
+        {
+            dP = V2F_Scale(dP, 0.70710678118f);
+        }
+        
+        ships->dx[ship_index] = dP.x * ships->speed[ship_index];
+        ships->dy[ship_index] = dP.y * ships->speed[ship_index];
+    }
+    
+    ProfileBegin("entity update");
+    EntityWorld_Update(&game->entities, game->jobs, delta_time, game->play_field_dims);
+    ProfileEnd("entity update");
+    
+    ProfileBegin("particle update");
+    ParticleSystem_Update(&game->particles, game->jobs, delta_time);
+    ProfileEnd("particle update");
+    
+    ProfileBegin("collision");
+    Game_CollideProjectiles(game);
+    ProfileEnd("collision");
+    
+    // NOTE(christian): out the back of the ship, after the update so the new ones are drawn where they spawned.
+    ship_index = EntityPool_IndexFromHandle(ships, game->ship);
+    if (ship_index != entity_invalid_index)
+    {
+        f32 angle = ships->angle[ship_index];
+        f32 radius = ships->radius[ship_index];
+        game->exhaust_emitter.p = V2F(ships->x[ship_index] - cosf(angle) * radius, ships->y[ship_index] - sinf(angle) * radius);
+        game->exhaust_emitter.angle = angle + pi_F32;
+        ParticleEmitter_Update(&game->particles, &game->exhaust_emitter, delta_time);
+    }
+}
+
+typedef struct Game_Render_Job
+{
+    Render_Shards *shards;
+    Entity_Pool *pool;
+    f32 interpolation;
+    u32 first_submission_index;
+} Game_Render_Job;
+
+function void
+Game_RenderEntitiesJob(void *data, u32 first, u32 one_past_last)
+{
+    Game_Render_Job *job = (Game_Render_Job *)data;
+    Entity_Pool *pool = job->pool;
+    Render_Shard *shard = RenderShards_BeginSegment(job->shards, GameLayer_Entities,
+                                                    job->first_submission_index + first / game_render_batch_size);
+    for (u32 entity_index = first; entity_index < one_past_last; ++entity_index)
+    {
+        RenderBatch_PushCircleOutline(&shard->immediate, EntityPool_InterpolatedP(pool, entity_index, job->interpolation),
+                                      RGBA(1.0f, 1.0f, 1.0f, 1.0f), pool->radius[entity_index]);
+    }
+    RenderShards_EndSegment(shard);
+}
+
+// NOTE(christian): interpolation in [0, 1) is how far the display is between the last two ticks.
+// entities are emitted by jobs into the shards, everything else on the calling thread. particles are
+// written by jobs straight into quad_render_batch, which has to be merged into after this returns.
+function void
+Game_Render(Game_State *game, f32 interpolation, Render_Shards *shards, Quad_Render_Batch *quad_render_batch)
+{
+    v2f dims = game->play_field_dims;
+    
+    Game_Render_Job render_jobs[EntityKind_Count];
+    Job_Counter render_counter = {0};
+    u32 submission_index = 0;
+    for (u32 kind = EntityKind_Projectile; kind < EntityKind_Count; ++kind)
+    {
+        Game_Render_Job *job = render_jobs + kind;
+        job->shards = shards;
+        job->pool = game->entities.pools + kind;
+        job->interpolation = interpolation;
+        job->first_submission_index = submission_index;
+        submission_index += (job->pool->count + game_render_batch_size - 1) / game_render_batch_size;
+        JobSystem_ParallelFor(game->jobs, &render_counter, job->pool->count, game_render_batch_size,
+                              &Game_RenderEntitiesJob, job);
+    }
+    ParticleSystem_Render(&game->particles, game->jobs, &render_counter, quad_render_batch, interpolation);
+    
+    Render_Shard *shard = RenderShards_BeginSegment(shards, GameLayer_Background, 0);
+    Render_Batch *render_batch = &shard->immediate;
+
+#if 0
+    Quad_Render_Batch *quad_render_batch = &shard->quads;
+    for (f32 gradient_index = 0; gradient_index < 255.0f; gradient_index += 5.0f)
+    {
+        QuadRenderBatch_PushRectFilled(quad_render_batch, V2F(gradient_index, 10.0f), V2F(6.0f, 50.0f),
+                                       RGBA(gradient_index / 255.0f, 0.0f, 0.0f, 1.0f), 0.0f);
+    }
+#endif
+    
+    RenderBatch_BeginPrimitive(render_batch, RenderPrimitiveKind_Triangle, False); {
+        RenderBatch_Colour(render_batch, V4F(1.0f, 0.0f, 0.0f, 1.0f));
+        RenderBatch_Vertex(render_batch, V2F(dims.x * 0.50f, dims.y * 0.25f));
+        RenderBatch_Vertex(render_batch, V2F(dims.x * 0.75f, dims.y * 0.75f));
+        RenderBatch_Vertex(render_batch, V2F(dims.x * 0.25f, dims.y * 0.75f));
+        
+        RenderBatch_Colour(render_batch, V4F(1.0f, 1.0f, 0.0f, 1.0f));
+        RenderBatch_Vertex(render_batch, V2F(dims.x * 0.50f, dims.y * 0.35f));
+        RenderBatch_Vertex(render_batch, V2F(dims.x * 0.65f, dims.y * 0.65f));
+        RenderBatch_Vertex(render_batch, V2F(dims.x * 0.35f, dims.y * 0.65f));
+    } RenderBatch_End(render_batch);
+    RenderShards_EndSegment(shard);
+    
+    Entity_Pool *ships = game->entities.pools + EntityKind_Ship;
+    u32 ship_index = EntityPool_IndexFromHandle(ships, game->ship);
+    if (ship_index != entity_invalid_index)
+    {
+        shard = RenderShards_BeginSegment(shards, GameLayer_Ship, 0);
+        render_batch = &shard->immediate;
+        
+        v2f ship_p = EntityPool_InterpolatedP(ships, ship_index, interpolation);
+        v2f ship_dP = V2F(ships->dx[ship_index], ships->dy[ship_index]);
+        RenderBatch_PushCircleOutline(render_batch, ship_p, RGBA(1.0f, 1.0f, 1.0f, 1.0f), ships->radius[ship_index]);
+        
+        RenderBatch_BeginPrimitive(render_batch, RenderPrimitiveKind_Line, True); {
+            RenderBatch_Colour(render_batch, V4F(1.0f, 1.0f, 1.0f, 1.0f));
+            RenderBatch_Vertex(render_batch, ship_p);
+            RenderBatch_Vertex(render_batch, V2F_Add(ship_p, ship_dP));
+        } RenderBatch_End(render_batch);
+        RenderShards_EndSegment(shard);
+    }
+    
+    // NOTE(christian): bottom left. the title is the cached layout, the counter is laid out every frame.
+    if (game->glyph_atlas)
+    {
+        shard = RenderShards_BeginSegment(shards, GameLayer_HUD, 0);
+        Quad_Render_Batch *hud_batch = &shard->quads;
+        
+        v2f hud_origin = V2F(game_hud_margin, dims.y - game_hud_margin - game->title_layout.dims.y);
+        QuadRenderBatch_PushTextLayout(hud_batch, &game->title_layout, hud_origin, RGBA(1.0f, 1.0f, 1.0f, 1.0f));
+        
+        u32 entity_count = 0;
+        for (u32 kind = 0; kind < EntityKind_Count; ++kind)
+        {
+            entity_count += game->entities.pools[kind].count;
+        }
+        
+        char counter_text[64];
+        s32 counter_length = snprintf(counter_text, sizeof(counter_text), "entities %u  particles %u",
+                                      entity_count, ParticleSystem_Count(&game->particles));
+        String_Const_U8 counter = { (u8 *)counter_text, (u32)Clamp(0, counter_length, (s32)sizeof(counter_text) - 1) };
+        hud_origin.x += game->title_layout.dims.x + (f32)text_glyph_advance * game_hud_text_scale;
+        QuadRenderBatch_PushText(hud_batch, game->glyph_atlas, hud_origin, RGBA(0.6f, 0.6f, 0.6f, 1.0f),
+                                 game_hud_text_scale, counter);
+        RenderShards_EndSegment(shard);
+    }
+    
+    JobSystem_Wait(game->jobs, &render_counter);
+}
@@ -0,0 +1,78 @@
+/* date = October 17th 2026 10:05 am */
+
+#ifndef BP_GAME_H
+#define BP_GAME_H
+
+#define game_level_arena_reserve GB(1)
+
+// NOTE(christian): the simulation always steps at a fixed rate, independent of the display.
+// a frame that falls further behind than game_max_ticks_per_frame drops the excess time
+// (the game slows down) instead of trying to catch up forever.
+#define game_default_tick_rate 60
+#define game_max_ticks_per_frame 8
+
+// NOTE(christian): draw order within each batch. see RenderShards_BeginSegment. particles aren't a
+// layer, they go into the quad batch ahead of the merge, so they draw under every layer's quads.
+typedef enum Game_Layer
+{
+    GameLayer_Background,
+    GameLayer_Entities,
+    GameLayer_Ship,
+    GameLayer_HUD,
+} Game_Layer;
+
+// NOTE(christian): entities per render job.
+#define game_render_batch_size 1024
+
+// NOTE(christian): projectiles against enemies. the grid is built over projectiles, the side that gets
+// into the tens of thousands, and every enemy asks it what it overlaps. an enemy overlapping more than
+// game_collision_query_capacity projectiles takes out the first ones this tick and the rest the next.
+#define game_collision_cell_size 8.0f
+#define game_collision_batch_size 256
+#define game_collision_query_capacity 64
+
+// NOTE(christian): exhaust trails off the ship, explosions are streaks thrown out by dying enemies.
+#define game_particle_seed 0x5EED
+#define game_exhaust_particle_capacity 4096
+#define game_explosion_particle_capacity (256*1024)
+#define game_explosion_particle_count 24
+
+#define game_hud_text_scale 1.0f
+#define game_hud_margin 4.0f
+
+typedef struct Game_State
+{
+    v2f play_field_dims;
+    Job_System *jobs;
+    
+    // NOTE(christian): everything that lives until the level restarts.
+    Memory_Arena level_arena;
+    
+    // NOTE(christian): pools live in level_arena.
+    Entity_World entities;
+    
+    // NOTE(christian): rebuilt every tick. the hit marks are by dense index and only mean anything
+    // during the collision pass.
+    Spatial_Grid projectile_grid;
+    u32 *projectile_hits;
+    u32 *enemy_hits;
+    
+    // NOTE(christian): pools live in level_arena, the emitters are templates we move around and fire.
+    Particle_System particles;
+    Particle_Emitter exhaust_emitter;
+    Particle_Emitter explosion_emitter;
+    
+    // NOTE(christian): our ship has 0 accel. constant velocity.
+    Entity_Handle ship;
+    
+    // NOTE(christian): null draws no hud. labels that never change are laid out once per level.
+    Glyph_Atlas *glyph_atlas;
+    Text_Layout title_layout;
+} Game_State;
+
+function void Game_Init(Game_State *game, v2f play_field_dims, Job_System *jobs, Glyph_Atlas *glyph_atlas);
+function void Game_BeginLevel(Game_State *game);
+function void Game_Update(Game_State *game, f32 delta_time);
+function void Game_Render(Game_State *game, f32 interpolation, Render_Shards *shards, Quad_Render_Batch *quad_render_batch);
+
+#endif //BP_GAME_H
@@ -0,0 +1,237 @@
+global per_thread u32 tl_job_thread_index;
+
+typedef struct Job_Worker_Start
+{
+    Job_System *system;
+    u32 thread_index;
+} Job_Worker_Start;
+
+inline u32
+JobSystem_GetThreadIndex(void)
+{
+    return(tl_job_thread_index);
+}
+
+//~ NOTE(christian): Chase-Lev deque
+// NOTE(christian): indices only ever grow and wrap at 2^32. their difference is the size as long
+// as it stays below 2^31, which job_deque_capacity guarantees. all atomics are seq_cst, which
+// covers the store-load ordering pop needs between bottom and top.
+function b32
+JobDeque_Push(Job_Deque *deque, Job *job)
+{
+    b32 result = False;
+    u32 bottom = deque->bottom;
+    u32 top = AtomicLoadU32(&deque->top);
+    if ((bottom - top) < job_deque_capacity)
+    {
+        deque->jobs[bottom & (job_deque_capacity - 1)] = *job;
+        AtomicStoreU32(&deque->bottom, bottom + 1);
+        result = True;
+    }
+    return(result);
+}
+
+function b32
+JobDeque_Pop(Job_Deque *deque, Job *out)
+{
+    b32 result = False;
+    u32 bottom = deque->bottom - 1;
+    AtomicStoreU32(&deque->bottom, bottom);
+    u32 top = AtomicLoadU32(&deque->top);
+    if ((s32)(bottom - top) >= 0)
+    {
+        *out = deque->jobs[bottom & (job_deque_capacity - 1)];
+        result = True;
+        if (bottom == top)
+        {
+            // NOTE(christian): last one. race the thieves for it through top.
+            result = AtomicCompareExchangeU32(&deque->top, top, top + 1);
+            AtomicStoreU32(&deque->bottom, top + 1);
+        }
+    }
+    else
+    {
+        AtomicStoreU32(&deque->bottom, top);
+    }
+    return(result);
+}
+
+function b32
+JobDeque_Steal(Job_Deque *deque, Job *out)
+{
+    b32 result = False;
+    u32 top = AtomicLoadU32(&deque->top);
+    u32 bottom = AtomicLoadU32(&deque->bottom);
+    if ((s32)(bottom - top) > 0)
+    {
+        // NOTE(christian): the owner can't overwrite this slot before top moves past it, so the copy is
+        // good whenever the exchange succeeds.
+        *out = deque->jobs[top & (job_deque_capacity - 1)];
+        result = AtomicCompareExchangeU32(&deque->top, top, top + 1);
+    }
+    return(result);
+}
+
+//~ NOTE(christian): job system
+function void
+JobSystem_Execute(Job *job)
+{
+    ProfileBegin("job");
+    job->proc(job->data, job->first, job->one_past_last);
+    ProfileEnd("job");
+    if (job->counter)
+    {
+        AtomicDecrementU32(&job->counter->pending);
+    }
+}
+
+// NOTE(christian): own deque first (newest job, still in cache), then steal round-robin starting next door.
+function b32
+JobSystem_RunOne(Job_System *system)
+{
+    u32 thread_index = tl_job_thread_index;
+    Job job;
+    b32 result = JobDeque_Pop(system->deques + thread_index, &job);
+    for (u32 offset = 1; !result && (offset < system->thread_count); ++offset)
+    {
+        u32 victim_index = (thread_index + offset) % system->thread_count;
+        result = JobDeque_Steal(system->deques + victim_index, &job);
+    }
+    
+    if (result)
+    {
+        JobSystem_Execute(&job);
+    }
+    return(result);
+}
+
+function b32
+JobSystem_AnyQueued(Job_System *system)
+{
+    b32 result = False;
+    for (u32 thread_index = 0; !result && (thread_index < system->thread_count); ++thread_index)
+    {
+        Job_Deque *deque = system->deques + thread_index;
+        result = (s32)(AtomicLoadU32(&deque->bottom) - AtomicLoadU32(&deque->top)) > 0;
+    }
+    return(result);
+}
+
+function void
+JobSystem_WorkerThread(void *parameter)
+{
+    Job_Worker_Start *start = (Job_Worker_Start *)parameter;
+    Job_System *system = start->system;
+    tl_job_thread_index = start->thread_index;
+    while (!AtomicLoadU32(&system->started))
+    {
+        SpinPause();
+    }
+    
+    u32 idle_spins = 0;
+    for (;;)
+    {
+        if (JobSystem_RunOne(system))
+        {
+            idle_spins = 0;
+        }
+        else if (++idle_spins < job_idle_spin_count)
+        {
+            SpinPause();
+        }
+        else
+        {
+            // NOTE(christian): announce first, then look once more. a push either sees us
+            // asleep and signals, or we see its job here, so no wake-up gets lost.
+            AtomicIncrementU32(&system->sleeping_count);
+            if (!JobSystem_AnyQueued(system))
+            {
+                OS_SemaphoreWait(&system->wake_semaphore);
+            }
+            AtomicDecrementU32(&system->sleeping_count);
+            idle_spins = 0;
+        }
+    }
+}
+
+function b32
+JobSystem_Init(Job_System *system, Memory_Arena *arena, u32 thread_count)
+{
+    MemoryZero(system, sizeof(Job_System));
+    tl_job_thread_index = 0;
+    
+    thread_count = Clamp(1, thread_count, job_max_thread_count);
+    system->deques = (Job_Deque *)MemoryArena_PushAligned(arena, sizeof(Job_Deque) * thread_count, 64);
+    system->thread_count = 1;
+    b32 result = (system->deques != null) && OS_SemaphoreInit(&system->wake_semaphore, 0);
+    if (result)
+    {
+        MemoryZero(system->deques, sizeof(Job_Deque) * thread_count);
+        
+        // NOTE(christian): if some threads fail to start, go with what we got. the workers hold off
+        // until started is set, which publishes the final thread_count, so none of them ever reads
+        // it while it's still changing.
+        Job_Worker_Start *starts = MemoryArena_PushArray(arena, Job_Worker_Start, thread_count);
+        u32 started_count = 1;
+        for (; started_count < thread_count; ++started_count)
+        {
+            starts[started_count].system = system;
+            starts[started_count].thread_index = started_count;
+            if (!OS_ThreadStart(&JobSystem_WorkerThread, starts + started_count))
+            {
+                break;
+            }
+        }
+        system->thread_count = started_count;
+    }
+    AtomicStoreU32(&system->started, 1);
+    return(result);
+}
+
+function void
+JobSystem_Push(Job_System *system, Job_Counter *counter, Job_Proc *proc, void *data, u32 first, u32 one_past_last)
+{
+    Job job = { proc, data, first, one_past_last, counter };
+    if (counter)
+    {
+        AtomicIncrementU32(&counter->pending);
+    }
+    
+    if (JobDeque_Push(system->deques + tl_job_thread_index, &job))
+    {
+        if (AtomicLoadU32(&system->sleeping_count))
+        {
+            OS_SemaphoreSignal(&system->wake_semaphore, 1);
+        }
+    }
+    else
+    {
+        // NOTE(christian): deque is full. doing it right here is always correct, just not parallel.
+        JobSystem_Execute(&job);
+    }
+}
+
+// NOTE(christian): one job per batch_size indices. [first, one_past_last) of every job but the
+// last is a whole batch, so a batch size that's a multiple of lane_width keeps spans aligned.
+function void
+JobSystem_ParallelFor(Job_System *system, Job_Counter *counter, u32 count, u32 batch_size, Job_Proc *proc, void *data)
+{
+    batch_size = Max(batch_size, 1);
+    for (u32 first = 0; first < count; first += batch_size)
+    {
+        JobSystem_Push(system, counter, proc, data, first, first + Min(batch_size, count - first));
+    }
+}
+
+// NOTE(christian): helps out until the counter drains. never sleeps, the caller is usually the frame.
+function void
+JobSystem_Wait(Job_System *system, Job_Counter *counter)
+{
+    while (AtomicLoadU32(&counter->pending))
+    {
+        if (!JobSystem_RunOne(system))
+        {
+            SpinPause();
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/* date = October 17th 2026 5:40 pm */
+
+#ifndef BP_JOB_H
+#define BP_JOB_H
+
+// NOTE(christian): a fixed pool of threads, each owning a Chase-Lev deque. the owner pushes and
+// pops at the bottom, everyone else steals from the top. thread 0 is the thread that called
+// JobSystem_Init (main). only pool threads may push, which includes jobs pushing more jobs.
+//
+// a job bumps its counter when pushed and drops it when done. waiting on a counter runs other
+// jobs instead of blocking, so a job can fan out and wait on its children, and main keeps working
+// while it waits. a dependency is just a wait on the counter of the jobs it depends on.
+#define job_deque_capacity 4096
+#define job_max_thread_count 64
+
+// NOTE(christian): how long an idle worker spins looking for work before going to sleep.
+#define job_idle_spin_count 256
+
+typedef void Job_Proc(void *data, u32 first, u32 one_past_last);
+
+typedef struct Job_Counter
+{
+    volatile u32 pending;
+} Job_Counter;
+
+typedef struct Job
+{
+    Job_Proc *proc;
+    void *data;
+    u32 first;
+    u32 one_past_last;
+    Job_Counter *counter;
+} Job;
+
+typedef struct Job_Deque
+{
+    // NOTE(christian): top and bottom sit on their own cache lines, thieves hammer top.
+    volatile u32 top;
+    u8 top_padding[60];
+    volatile u32 bottom;
+    u8 bottom_padding[60];
+    Job jobs[job_deque_capacity];
+} Job_Deque;
+
+typedef struct Job_System
+{
+    // NOTE(christian): fixed once JobSystem_Init returns. workers don't read it before started is set.
+    u32 thread_count;
+    volatile u32 started;
+    Job_Deque *deques;
+    
+    // NOTE(christian): workers that found nothing to do sleep here. pushing wakes one if anyone is asleep.
+    OS_Semaphore wake_semaphore;
+    volatile u32 sleeping_count;
+} Job_System;
+
+function b32 JobSystem_Init(Job_System *system, Memory_Arena *arena, u32 thread_count);
+inline u32 JobSystem_GetThreadIndex(void);
+
+function void JobSystem_Push(Job_System *system, Job_Counter *counter, Job_Proc *proc, void *data, u32 first, u32 one_past_last);
+function void JobSystem_ParallelFor(Job_System *system, Job_Counter *counter, u32 count, u32 batch_size, Job_Proc *proc, void *data);
+function b32 JobSystem_RunOne(Job_System *system);
+function void JobSystem_Wait(Job_System *system, Job_Counter *counter);
+
+#endif //BP_JOB_H
@@ -0,0 +1,169 @@
+function b32
+MemoryArena_Init(Memory_Arena *arena, u64 reserve_size)
+{
+    reserve_size = AlignPow2(reserve_size, memory_arena_commit_size);
+    
+    arena->memory = (u8 *)OS_ReserveMemory(reserve_size);
+    arena->capacity = arena->memory ? reserve_size : 0;
+    arena->stack_ptr = 0;
+    arena->commit_ptr = 0;
+    arena->high_water_mark = 0;
+    
+    return(arena->memory != null);
+}
+
+function void
+MemoryArena_Release(Memory_Arena *arena)
+{
+    if (arena->memory)
+    {
+        OS_ReleaseMemory(arena->memory, arena->capacity);
+    }
+    
+    arena->memory = null;
+    arena->capacity = 0;
+    arena->stack_ptr = 0;
+    arena->commit_ptr = 0;
+    arena->high_water_mark = 0;
+}
+
+function void *
+MemoryArena_PushAligned(Memory_Arena *arena, u64 size, u64 alignment)
+{
+    Assert(IsPow2(alignment));
+    
+    void *result = null;
+    u64 base = AlignPow2(arena->stack_ptr, alignment);
+    u64 new_stack_ptr = base + size;
+    
+    if (new_stack_ptr <= arena->capacity)
+    {
+        if (new_stack_ptr > arena->commit_ptr)
+        {
+            u64 new_commit_ptr = Min(AlignPow2(new_stack_ptr, memory_arena_commit_size), arena->capacity);
+            if (OS_CommitMemory(arena->memory + arena->commit_ptr, new_commit_ptr - arena->commit_ptr))
+            {
+                arena->commit_ptr = new_commit_ptr;
+            }
+        }
+        
+        if (new_stack_ptr <= arena->commit_ptr)
+        {
+            result = arena->memory + base;
+            arena->stack_ptr = new_stack_ptr;
+            arena->high_water_mark = Max(arena->high_water_mark, new_stack_ptr);
+        }
+    }
+    
+    Assert(result != null);
+    return(result);
+}
+
+function void *
+MemoryArena_Push(Memory_Arena *arena, u64 size)
+{
+    void *result = MemoryArena_PushAligned(arena, size, memory_arena_default_alignment);
+    return(result);
+}
+
+function void *
+MemoryArena_PushZero(Memory_Arena *arena, u64 size)
+{
+    void *result = MemoryArena_PushAligned(arena, size, memory_arena_default_alignment);
+    if (result)
+    {
+        MemoryZero(result, size);
+    }
+    return(result);
+}
+
+inline u64
+MemoryArena_GetMark(Memory_Arena *arena)
+{
+    return(arena->stack_ptr);
+}
+
+function void
+MemoryArena_PopToMark(Memory_Arena *arena, u64 mark)
+{
+    Assert(mark <= arena->stack_ptr);
+    arena->stack_ptr = Min(mark, arena->stack_ptr);
+}
+
+function void
+MemoryArena_Pop(Memory_Arena *arena, u64 size)
+{
+    Assert(size <= arena->stack_ptr);
+    arena->stack_ptr -= Min(size, arena->stack_ptr);
+}
+
+function void
+MemoryArena_Reset(Memory_Arena *arena)
+{
+    // NOTE(christian): keep what the last cycle actually needed committed, give the rest back.
+    u64 keep_committed = AlignPow2(arena->high_water_mark, memory_arena_commit_size);
+    if (keep_committed < arena->commit_ptr)
+    {
+        if (OS_DecommitMemory(arena->memory + keep_committed, arena->commit_ptr - keep_committed))
+        {
+            arena->commit_ptr = keep_committed;
+        }
+    }
+    
+    arena->stack_ptr = 0;
+    arena->high_water_mark = 0;
+}
+
+inline Temporary_Memory
+TemporaryMemory_Begin(Memory_Arena *arena)
+{
+    Temporary_Memory result;
+    result.arena = arena;
+    result.mark = arena->stack_ptr;
+    return(result);
+}
+
+inline void
+TemporaryMemory_End(Temporary_Memory temp)
+{
+    MemoryArena_PopToMark(temp.arena, temp.mark);
+}
+
+//~ NOTE(christian): scratch
+global per_thread Memory_Arena tl_scratch_arenas[scratch_arena_count];
+
+function Temporary_Memory
+Scratch_Begin(Memory_Arena **conflicts, u32 conflict_count)
+{
+    Memory_Arena *scratch = null;
+    for (u32 scratch_index = 0;
+         scratch_index < scratch_arena_count;
+         ++scratch_index)
+    {
+        Memory_Arena *candidate = tl_scratch_arenas + scratch_index;
+        b32 conflicting = False;
+        for (u32 conflict_index = 0; conflict_index < conflict_count; ++conflict_index)
+        {
+            if (conflicts[conflict_index] == candidate)
+            {
+                conflicting = True;
+                break;
+            }
+        }
+        
+        if (!conflicting)
+        {
+            scratch = candidate;
+            break;
+        }
+    }
+    
+    Assert(scratch != null);
+    if (!scratch->memory)
+    {
+        MemoryArena_Init(scratch, scratch_arena_reserve);
+    }
+    
+    Temporary_Memory result = TemporaryMemory_Begin(scratch);
+    return(result);
+}
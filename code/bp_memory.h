@@ -0,0 +1,56 @@
+/* date = October 17th 2026 11:20 am */
+
+#ifndef BP_MEMORY_H
+#define BP_MEMORY_H
+
+// NOTE(christian): arenas reserve their whole capacity up front and commit it
+// in memory_arena_commit_size steps as the stack pointer grows into it.
+#define memory_arena_commit_size KB(64)
+#define memory_arena_default_alignment 16
+
+typedef struct Memory_Arena
+{
+    u8 *memory;
+    u64 capacity;
+    u64 stack_ptr;
+    u64 commit_ptr;
+    
+    // NOTE(christian): deepest stack_ptr since the last reset. reset decommits everything past it.
+    u64 high_water_mark;
+} Memory_Arena;
+
+typedef struct Temporary_Memory
+{
+    Memory_Arena *arena;
+    u64 mark;
+} Temporary_Memory;
+
+function b32 MemoryArena_Init(Memory_Arena *arena, u64 reserve_size);
+function void MemoryArena_Release(Memory_Arena *arena);
+
+function void *MemoryArena_PushAligned(Memory_Arena *arena, u64 size, u64 alignment);
+function void *MemoryArena_Push(Memory_Arena *arena, u64 size);
+function void *MemoryArena_PushZero(Memory_Arena *arena, u64 size);
+
+inline u64 MemoryArena_GetMark(Memory_Arena *arena);
+function void MemoryArena_PopToMark(Memory_Arena *arena, u64 mark);
+function void MemoryArena_Pop(Memory_Arena *arena, u64 size);
+function void MemoryArena_Reset(Memory_Arena *arena);
+
+#define MemoryArena_PushStruct(arena,T) (T *)MemoryArena_PushZero(arena, sizeof(T))
+#define MemoryArena_PushArray(arena,T,count) (T *)MemoryArena_PushAligned(arena, sizeof(T)*(count), memory_arena_default_alignment)
+#define MemoryArena_PushArrayZero(arena,T,count) (T *)MemoryArena_PushZero(arena, sizeof(T)*(count))
+
+inline Temporary_Memory TemporaryMemory_Begin(Memory_Arena *arena);
+inline void TemporaryMemory_End(Temporary_Memory temp);
+
+//~ NOTE(christian): scratch
+// NOTE(christian): each thread owns a couple of scratch arenas. pass the arenas that are
+// already in use by the caller so the returned one never aliases them.
+#define scratch_arena_count 2
+#define scratch_arena_reserve GB(1)
+
+function Temporary_Memory Scratch_Begin(Memory_Arena **conflicts, u32 conflict_count);
+#define Scratch_End(temp) TemporaryMemory_End(temp)
+
+#endif //BP_MEMORY_H
@@ -0,0 +1,90 @@
+global OS_Input g_os_input;
+
+function b32
+OS_KeyPressed(Key_Code key)
+{
+    b32 result = False;
+    if (key < KeyCode_Total)
+    {
+        result = g_os_input.key_states[key] & InputInteract_Pressed;
+    }
+    return(result);
+}
+
+function b32
+OS_KeyReleased(u32 key)
+{
+    b32 result = False;
+    if (key < KeyCode_Total)
+    {
+        result = g_os_input.key_states[key] & InputInteract_Released;
+    }
+    return(result);
+}
+
+function b32
+OS_KeyHeld(u32 key)
+{
+    b32 result = False;
+    if (key < KeyCode_Total)
+    {
+        result = g_os_input.key_states[key] & InputInteract_Held;
+    }
+    return(result);
+}
+
+function b32
+OS_InputFlagGet(u8 input_flag)
+{
+    b32 result = g_os_input.misc_flags & input_flag;
+    return(result);
+}
+
+function void
+OS_InputFlagSet(u8 input_flag, b32 enabled)
+{
+    if (enabled)
+    {
+        g_os_input.misc_flags |= input_flag;
+    }
+    else
+    {
+        g_os_input.misc_flags &= ~input_flag;
+    }
+}
+
+//~ NOTE(christian): time
+function f64
+OS_SecondsBetweenTicksF64(u64 start, u64 end)
+{
+    u64 ticks_per_second = OS_GetTicksPerSecond();
+    u64 delta_ticks = end - start;
+    f64 result = (f64)(delta_ticks / ticks_per_second) + (f64)(delta_ticks % ticks_per_second) / (f64)ticks_per_second;
+    return(result);
+}
+
+function f32
+OS_SecondsBetweenTicksF32(u64 start, u64 end)
+{
+    f32 result = (f32)OS_SecondsBetweenTicksF64(start, end);
+    return(result);
+}
+
+function u64
+OS_TicksFromSecondsF64(f64 seconds)
+{
+    u64 result = (u64)(seconds * (f64)OS_GetTicksPerSecond() + 0.5);
+    return(result);
+}
+
+// NOTE(christian): called by each platform's OS_FillEvents before pumping.
+function void
+OS_BeginInputFrame(void)
+{
+    for (u32 key_index = 0;
+         key_index < ArrayCount(g_os_input.key_states);
+         ++key_index)
+    {
+        g_os_input.key_states[key_index] &= ~(InputInteract_Released | InputInteract_Pressed);
+    }
+}
@@ -0,0 +1,138 @@
+/* date = October 17th 2026 9:02 am */
+
+#ifndef BP_OS_H
+#define BP_OS_H
+
+//~ NOTE(christian): input
+typedef enum Key_Code
+{
+    KeyCode_Escape,
+    KeyCode_LeftArrow,
+    KeyCode_UpArrow,
+    KeyCode_RightArrow,
+    KeyCode_DownArrow,
+    KeyCode_Total
+} Key_Code;
+
+typedef enum Input_Interact_Type
+{
+    InputInteract_Pressed = 0x1,
+    InputInteract_Released = 0x2,
+    InputInteract_Held = 0x4,
+} Input_Interact_Type;
+
+typedef enum Misc_Input_Flag
+{
+    InputFlag_Quit = 0x1,
+} Misc_Input_Flag;
+
+typedef struct OS_Input
+{
+    u32 key_states[KeyCode_Total];
+    u8 misc_flags;
+} OS_Input;
+
+function b32 OS_KeyPressed(Key_Code key);
+function b32 OS_KeyReleased(u32 key);
+function b32 OS_KeyHeld(u32 key);
+function b32 OS_InputFlagGet(u8 input_flag);
+function void OS_InputFlagSet(u8 input_flag, b32 enabled);
+
+//~ NOTE(christian): time
+// NOTE(christian): tick deltas stay in 64-bit integers until the final divide. a frame worth of
+// nanoseconds already doesn't fit in an f32 mantissa.
+function f64 OS_SecondsBetweenTicksF64(u64 start, u64 end);
+function f32 OS_SecondsBetweenTicksF32(u64 start, u64 end);
+function u64 OS_TicksFromSecondsF64(f64 seconds);
+
+//~ NOTE(christian): implemented per platform (bp_os_win32.c / bp_os_linux.c)
+function void OS_Init(void);
+function void OS_Shutdown(void);
+
+function void *OS_ReserveMemory(u64 size_in_bytes);
+function b32 OS_CommitMemory(void *memory_to_commit, u64 size_in_bytes);
+function b32 OS_DecommitMemory(void *memory_to_decommit, u64 size_in_bytes);
+function b32 OS_ReleaseMemory(void *memory_to_release, u64 size_in_bytes);
+
+function u64 OS_GetTicks(void);
+function u64 OS_GetTicksPerSecond(void);
+function void OS_Sleep(u64 milliseconds);
+
+// NOTE(christian): blocks until OS_GetTicks() is at or past deadline_ticks, or close to it. the wake
+// up can still be late by the scheduler's granularity, the frame pacer spins the rest.
+function void OS_SleepUntilTicks(u64 deadline_ticks);
+
+//~ NOTE(christian): threads
+// NOTE(christian): threads are never joined, they live until the process exits. one that has to be
+// stopped earlier signals a semaphore on its way out, and whoever stops it waits on that.
+typedef void OS_Thread_Proc(void *parameter);
+
+#if OS_WINDOWS
+typedef struct OS_Semaphore { HANDLE handle; } OS_Semaphore;
+#else
+typedef struct OS_Semaphore { sem_t semaphore; } OS_Semaphore;
+#endif
+
+function b32 OS_ThreadStart(OS_Thread_Proc *proc, void *parameter);
+function u32 OS_GetProcessorCount(void);
+function b32 OS_SemaphoreInit(OS_Semaphore *semaphore, u32 initial_count);
+function void OS_SemaphoreSignal(OS_Semaphore *semaphore, u32 count);
+function void OS_SemaphoreWait(OS_Semaphore *semaphore);
+
+//~ NOTE(christian): file watching
+// NOTE(christian): reports files written, created or renamed into place anywhere under a directory,
+// subdirectories created later included. paths come back relative to the directory, with '/'
+// between parts. one save from an editor can show up as a few changes in a row, so callers wait
+// for a quiet spell before acting on them. OS_FileWatchWake is for stopping the thread that waits:
+// it makes the wait that's blocked, and every one after it, return 0 straight away.
+#define os_file_watch_max_path 256
+#define os_file_watch_buffer_size KB(16)
+#define os_wait_infinite 0xFFFFFFFF
+
+#if OS_WINDOWS
+typedef struct OS_File_Watch
+{
+    HANDLE directory;
+    HANDLE event;
+    HANDLE wake_event;
+    OVERLAPPED overlapped;
+    b32 read_pending;
+    u32 buffer_size;
+    u32 buffer_offset;
+    DWORD buffer[os_file_watch_buffer_size / sizeof(DWORD)];
+} OS_File_Watch;
+#else
+// NOTE(christian): inotify watches one directory at a time, so every directory of the tree gets
+// its own watch, and directories[i] is the relative path of directory_watches[i] with a trailing
+// '/' ("" for the root).
+#define os_file_watch_max_directories 64
+
+typedef struct OS_File_Watch
+{
+    s32 fd;
+    s32 wake_fd;
+    char root[os_file_watch_max_path];
+    u32 directory_count;
+    s32 directory_watches[os_file_watch_max_directories];
+    char directories[os_file_watch_max_directories][os_file_watch_max_path];
+    u32 buffer_size;
+    u32 buffer_offset;
+    u32 buffer[os_file_watch_buffer_size / sizeof(u32)];
+} OS_File_Watch;
+#endif
+
+function b32 OS_FileWatchInit(OS_File_Watch *watch, char *directory);
+// NOTE(christian): waits up to timeout_ms (or os_wait_infinite) for the next change and writes its
+// path to out_path. returns the length of the path, 0 when nothing changed in time.
+function u32 OS_FileWatchWait(OS_File_Watch *watch, u32 timeout_ms, char *out_path, u32 out_path_capacity);
+function void OS_FileWatchWake(OS_File_Watch *watch);
+// NOTE(christian): nothing may be waiting on the watch. safe on a watch whose init failed.
+function void OS_FileWatchClose(OS_File_Watch *watch);
+
+// NOTE(christian): 0 when there is no window (headless).
+function s32 OS_GetMonitorRefreshRate(void);
+
+// NOTE(christian): pumps the platform's event queue into the shared OS_Input.
+function void OS_FillEvents(void);
+
+#endif //BP_OS_H
@@ -0,0 +1,370 @@
+typedef struct LNX_State
+{
+    u64 ticks_per_second;
+} LNX_State;
+
+global LNX_State g_lnx_state;
+global volatile sig_atomic_t g_lnx_quit_requested;
+
+//~ NOTE(christian): memory
+function void *
+OS_ReserveMemory(u64 size_in_bytes)
+{
+    void *block = mmap(null, size_in_bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (block == MAP_FAILED)
+    {
+        block = null;
+    }
+    return(block);
+}
+
+function b32
+OS_CommitMemory(void *memory_to_commit, u64 size_in_bytes)
+{
+    b32 success = mprotect(memory_to_commit, size_in_bytes, PROT_READ | PROT_WRITE) == 0;
+    return(success);
+}
+
+function b32
+OS_DecommitMemory(void *memory_to_decommit, u64 size_in_bytes)
+{
+    // NOTE(christian): DONTNEED hands the pages back; the range reads as zero once recommitted,
+    // same as MEM_DECOMMIT.
+    b32 success = madvise(memory_to_decommit, size_in_bytes, MADV_DONTNEED) == 0;
+    success = success && (mprotect(memory_to_decommit, size_in_bytes, PROT_NONE) == 0);
+    return(success);
+}
+
+function b32
+OS_ReleaseMemory(void *memory_to_release, u64 size_in_bytes)
+{
+    b32 success = munmap(memory_to_release, size_in_bytes) == 0;
+    return(success);
+}
+
+//~ NOTE(christian): time
+function void
+OS_Sleep(u64 milliseconds)
+{
+    struct timespec duration;
+    duration.tv_sec = (time_t)(milliseconds / 1000);
+    duration.tv_nsec = (long)((milliseconds % 1000) * 1000000);
+    while (nanosleep(&duration, &duration) == -1 && errno == EINTR);
+}
+
+function u64
+OS_GetTicks(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    
+    u64 result = (u64)now.tv_sec * 1000000000llu + (u64)now.tv_nsec;
+    return(result);
+}
+
+function u64
+OS_GetTicksPerSecond(void)
+{
+    return(g_lnx_state.ticks_per_second);
+}
+
+function void
+OS_SleepUntilTicks(u64 deadline_ticks)
+{
+    // NOTE(christian): ticks are CLOCK_MONOTONIC nanoseconds, so the deadline goes in as is.
+    struct timespec deadline;
+    deadline.tv_sec = (time_t)(deadline_ticks / 1000000000llu);
+    deadline.tv_nsec = (long)(deadline_ticks % 1000000000llu);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, null) == EINTR);
+}
+
+function s32
+OS_GetMonitorRefreshRate(void)
+{
+    // NOTE(christian): no window on this platform yet, always headless.
+    return(0);
+}
+
+//~ NOTE(christian): threads
+typedef struct LNX_Thread_Start
+{
+    OS_Thread_Proc *proc;
+    void *parameter;
+} LNX_Thread_Start;
+
+function void *
+LNX_ThreadEntry(void *parameter)
+{
+    LNX_Thread_Start start = *(LNX_Thread_Start *)parameter;
+    free(parameter);
+    start.proc(start.parameter);
+    return(null);
+}
+
+function b32
+OS_ThreadStart(OS_Thread_Proc *proc, void *parameter)
+{
+    b32 result = False;
+    LNX_Thread_Start *start = (LNX_Thread_Start *)malloc(sizeof(LNX_Thread_Start));
+    if (start)
+    {
+        start->proc = proc;
+        start->parameter = parameter;
+        
+        pthread_t thread;
+        result = pthread_create(&thread, null, &LNX_ThreadEntry, start) == 0;
+        if (result)
+        {
+            pthread_detach(thread);
+        }
+        else
+        {
+            free(start);
+        }
+    }
+    return(result);
+}
+
+function u32
+OS_GetProcessorCount(void)
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    u32 result = (count > 0) ? (u32)count : 1;
+    return(result);
+}
+
+function b32
+OS_SemaphoreInit(OS_Semaphore *semaphore, u32 initial_count)
+{
+    b32 result = sem_init(&semaphore->semaphore, 0, initial_count) == 0;
+    return(result);
+}
+
+function void
+OS_SemaphoreSignal(OS_Semaphore *semaphore, u32 count)
+{
+    for (u32 signal_index = 0; signal_index < count; ++signal_index)
+    {
+        sem_post(&semaphore->semaphore);
+    }
+}
+
+function void
+OS_SemaphoreWait(OS_Semaphore *semaphore)
+{
+    while (sem_wait(&semaphore->semaphore) == -1 && errno == EINTR);
+}
+
+//~ NOTE(christian): file watching
+#define lnx_file_watch_mask (IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE)
+
+// NOTE(christian): watches relative (empty or ending in '/') and everything below it.
+function void
+LNX_FileWatchAddDirectory(OS_File_Watch *watch, char *relative)
+{
+    if (watch->directory_count == os_file_watch_max_directories)
+    {
+        return;
+    }
+    
+    char path[os_file_watch_max_path * 2];
+    snprintf(path, sizeof(path), "%s/%s", watch->root, relative);
+    s32 watch_descriptor = inotify_add_watch(watch->fd, path, lnx_file_watch_mask | IN_ONLYDIR);
+    if (watch_descriptor < 0)
+    {
+        return;
+    }
+    
+    // NOTE(christian): the same directory twice hands back the watch it already has.
+    for (u32 directory_index = 0; directory_index < watch->directory_count; ++directory_index)
+    {
+        if (watch->directory_watches[directory_index] == watch_descriptor)
+        {
+            return;
+        }
+    }
+    
+    u32 directory_index = watch->directory_count++;
+    watch->directory_watches[directory_index] = watch_descriptor;
+    snprintf(watch->directories[directory_index], os_file_watch_max_path, "%s", relative);
+    
+    DIR *directory = opendir(path);
+    if (directory)
+    {
+        struct dirent *entry;
+        while ((entry = readdir(directory)) != null)
+        {
+            if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, ".."))
+            {
+                continue;
+            }
+            
+            char child_path[os_file_watch_max_path * 3];
+            snprintf(child_path, sizeof(child_path), "%s%s", path, entry->d_name);
+            struct stat child_stat;
+            if ((stat(child_path, &child_stat) == 0) && S_ISDIR(child_stat.st_mode))
+            {
+                char child[os_file_watch_max_path];
+                s32 length = snprintf(child, sizeof(child), "%s%s/", relative, entry->d_name);
+                if ((length > 0) && (length < (s32)sizeof(child)))
+                {
+                    LNX_FileWatchAddDirectory(watch, child);
+                }
+            }
+        }
+        closedir(directory);
+    }
+}
+
+function b32
+OS_FileWatchInit(OS_File_Watch *watch, char *directory)
+{
+    MemoryZero(watch, sizeof(OS_File_Watch));
+    snprintf(watch->root, sizeof(watch->root), "%s", directory);
+    watch->fd = inotify_init1(IN_CLOEXEC);
+    watch->wake_fd = eventfd(0, EFD_CLOEXEC);
+    if (watch->fd >= 0)
+    {
+        LNX_FileWatchAddDirectory(watch, "");
+    }
+    
+    b32 result = (watch->directory_count > 0) && (watch->wake_fd >= 0);
+    if (!result)
+    {
+        OS_FileWatchClose(watch);
+    }
+    return(result);
+}
+
+function u32
+OS_FileWatchWait(OS_File_Watch *watch, u32 timeout_ms, char *out_path, u32 out_path_capacity)
+{
+    u32 result = 0;
+    u64 deadline_ticks = OS_GetTicks() + (u64)timeout_ms * 1000000llu;
+    while (!result)
+    {
+        if (watch->buffer_offset >= watch->buffer_size)
+        {
+            s32 poll_timeout = -1;
+            if (timeout_ms != os_wait_infinite)
+            {
+                u64 now_ticks = OS_GetTicks();
+                poll_timeout = (now_ticks < deadline_ticks) ? (s32)((deadline_ticks - now_ticks + 999999) / 1000000) : 0;
+            }
+            
+            struct pollfd poll_fds[2] = { { watch->fd, POLLIN, 0 }, { watch->wake_fd, POLLIN, 0 } };
+            if ((poll(poll_fds, 2, poll_timeout) <= 0) || poll_fds[1].revents)
+            {
+                break;
+            }
+            
+            ssize_t size = read(watch->fd, watch->buffer, sizeof(watch->buffer));
+            if (size <= 0)
+            {
+                break;
+            }
+            watch->buffer_size = (u32)size;
+            watch->buffer_offset = 0;
+        }
+        
+        struct inotify_event *event = (struct inotify_event *)((u8 *)watch->buffer + watch->buffer_offset);
+        watch->buffer_offset += sizeof(struct inotify_event) + event->len;
+        
+        char *directory = null;
+        for (u32 directory_index = 0; directory_index < watch->directory_count; ++directory_index)
+        {
+            if (watch->directory_watches[directory_index] == event->wd)
+            {
+                directory = watch->directories[directory_index];
+                break;
+            }
+        }
+        
+        if (!directory || !event->len)
+        {
+            continue;
+        }
+        
+        if (event->mask & IN_ISDIR)
+        {
+            if (event->mask & (IN_CREATE | IN_MOVED_TO))
+            {
+                char child[os_file_watch_max_path];
+                s32 length = snprintf(child, sizeof(child), "%s%s/", directory, event->name);
+                if ((length > 0) && (length < (s32)sizeof(child)))
+                {
+                    LNX_FileWatchAddDirectory(watch, child);
+                }
+            }
+        }
+        else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+        {
+            s32 length = snprintf(out_path, out_path_capacity, "%s%s", directory, event->name);
+            if ((length > 0) && ((u32)length < out_path_capacity))
+            {
+                result = (u32)length;
+            }
+        }
+    }
+    return(result);
+}
+
+// NOTE(christian): the eventfd is never read, so it stays readable.
+function void
+OS_FileWatchWake(OS_File_Watch *watch)
+{
+    u64 value = 1;
+    ssize_t written = write(watch->wake_fd, &value, sizeof(value));
+    Unused(written);
+}
+
+function void
+OS_FileWatchClose(OS_File_Watch *watch)
+{
+    if (watch->fd >= 0)
+    {
+        close(watch->fd);
+    }
+    if (watch->wake_fd >= 0)
+    {
+        close(watch->wake_fd);
+    }
+    watch->fd = -1;
+    watch->wake_fd = -1;
+    watch->directory_count = 0;
+}
+
+//~ NOTE(christian): events
+function void
+LNX_QuitSignalHandler(s32 signal_number)
+{
+    Unused(signal_number);
+    g_lnx_quit_requested = 1;
+}
+
+function void
+OS_Init(void)
+{
+    g_lnx_state.ticks_per_second = 1000000000llu;
+    
+    struct sigaction quit_action = {0};
+    quit_action.sa_handler = &LNX_QuitSignalHandler;
+    sigemptyset(&quit_action.sa_mask);
+    sigaction(SIGINT, &quit_action, null);
+    sigaction(SIGTERM, &quit_action, null);
+}
+
+function void
+OS_Shutdown(void)
+{
+}
+
+function void
+OS_FillEvents(void)
+{
+    OS_BeginInputFrame();
+    if (g_lnx_quit_requested)
+    {
+        g_os_input.misc_flags |= InputFlag_Quit;
+    }
+}
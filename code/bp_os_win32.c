@@ -0,0 +1,495 @@
+// NOTE(christian): win10 1803+. older sdks don't have the define, older systems fail the create.
+#if !defined(CREATE_WAITABLE_TIMER_HIGH_RESOLUTION)
+# define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+typedef struct W32_State
+{
+    HWND window;
+    u64 ticks_per_second;
+    UINT timer_period;
+    HANDLE sleep_timer;
+} W32_State;
+
+global W32_State g_w32_state;
+
+//~ NOTE(christian): memory
+function void *
+OS_ReserveMemory(u64 size_in_bytes)
+{
+    void *block = VirtualAlloc(0, size_in_bytes, MEM_RESERVE, PAGE_NOACCESS);
+    return(block);
+}
+
+function b32
+OS_CommitMemory(void *memory_to_commit, u64 size_in_bytes)
+{
+    b32 success = VirtualAlloc(memory_to_commit, size_in_bytes, MEM_COMMIT, PAGE_READWRITE) != null;
+    return(success);
+}
+
+function b32
+OS_DecommitMemory(void *memory_to_decommit, u64 size_in_bytes)
+{
+    b32 success = VirtualFree(memory_to_decommit, size_in_bytes, MEM_DECOMMIT) != FALSE;
+    return(success);
+}
+
+function b32
+OS_ReleaseMemory(void *memory_to_release, u64 size_in_bytes)
+{
+    Unused(size_in_bytes);
+    b32 success = VirtualFree(memory_to_release, 0, MEM_RELEASE) != FALSE;
+    return(success);
+}
+
+//~ NOTE(christian): time
+function void
+OS_Sleep(u64 milliseconds)
+{
+    Sleep((DWORD)milliseconds);
+}
+
+function u64
+OS_GetTicks(void)
+{
+    LARGE_INTEGER result;
+    QueryPerformanceCounter(&result);
+    
+    return(result.QuadPart);
+}
+
+function u64
+OS_GetTicksPerSecond(void)
+{
+    return(g_w32_state.ticks_per_second);
+}
+
+function void
+OS_SleepUntilTicks(u64 deadline_ticks)
+{
+    u64 now_ticks = OS_GetTicks();
+    if (now_ticks < deadline_ticks)
+    {
+        u64 remaining_ticks = deadline_ticks - now_ticks;
+        if (g_w32_state.sleep_timer)
+        {
+            // NOTE(christian): relative due time, negative, in 100ns units.
+            LARGE_INTEGER due_time;
+            due_time.QuadPart = -(LONGLONG)((remaining_ticks * 10000000llu) / g_w32_state.ticks_per_second);
+            if (due_time.QuadPart < 0 &&
+                SetWaitableTimerEx(g_w32_state.sleep_timer, &due_time, 0, null, null, null, 0))
+            {
+                WaitForSingleObject(g_w32_state.sleep_timer, INFINITE);
+            }
+        }
+        else
+        {
+            // NOTE(christian): no high resolution timer (before win10 1803). whole milliseconds, rounded down.
+            u64 sleep_ms = (remaining_ticks * 1000llu) / g_w32_state.ticks_per_second;
+            if (sleep_ms)
+            {
+                Sleep((DWORD)sleep_ms);
+            }
+        }
+    }
+}
+
+function s32
+OS_GetMonitorRefreshRate(void)
+{
+    s32 result = 0;
+    if (g_w32_state.window)
+    {
+        HDC dc = GetDC(g_w32_state.window);
+        result = GetDeviceCaps(dc, VREFRESH);
+        ReleaseDC(g_w32_state.window, dc);
+    }
+    
+    return(result);
+}
+
+function void
+OS_Init(void)
+{
+    TIMECAPS time_caps;
+    if (timeGetDevCaps(&time_caps, sizeof(time_caps)) == MMSYSERR_NOERROR)
+    {
+        g_w32_state.timer_period = time_caps.wPeriodMin;
+        timeBeginPeriod(g_w32_state.timer_period);
+        
+        PROCESS_POWER_THROTTLING_STATE process_throttling_state;
+        process_throttling_state.Version = PROCESS_POWER_THROTTLING_CURRENT_VERSION;
+        process_throttling_state.ControlMask = PROCESS_POWER_THROTTLING_IGNORE_TIMER_RESOLUTION;
+        process_throttling_state.StateMask = 0;
+        
+        SetProcessInformation(GetCurrentProcess(), ProcessPowerThrottling,
+                              (void *)(&process_throttling_state), sizeof(PROCESS_POWER_THROTTLING_STATE));
+    }
+    
+    LARGE_INTEGER ticks_per_second_li;
+    QueryPerformanceFrequency(&ticks_per_second_li);
+    g_w32_state.ticks_per_second = (u64)ticks_per_second_li.QuadPart;
+    
+    g_w32_state.sleep_timer = CreateWaitableTimerExW(null, null, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+}
+
+function void
+OS_Shutdown(void)
+{
+    if (g_w32_state.timer_period)
+    {
+        timeEndPeriod(g_w32_state.timer_period);
+    }
+    
+    if (g_w32_state.sleep_timer)
+    {
+        CloseHandle(g_w32_state.sleep_timer);
+    }
+}
+
+//~ NOTE(christian): threads
+typedef struct W32_Thread_Start
+{
+    OS_Thread_Proc *proc;
+    void *parameter;
+} W32_Thread_Start;
+
+function DWORD WINAPI
+W32_ThreadEntry(LPVOID parameter)
+{
+    W32_Thread_Start start = *(W32_Thread_Start *)parameter;
+    HeapFree(GetProcessHeap(), 0, parameter);
+    start.proc(start.parameter);
+    return(0);
+}
+
+function b32
+OS_ThreadStart(OS_Thread_Proc *proc, void *parameter)
+{
+    b32 result = False;
+    W32_Thread_Start *start = (W32_Thread_Start *)HeapAlloc(GetProcessHeap(), 0, sizeof(W32_Thread_Start));
+    if (start)
+    {
+        start->proc = proc;
+        start->parameter = parameter;
+        
+        HANDLE thread = CreateThread(null, 0, &W32_ThreadEntry, start, 0, null);
+        result = thread != null;
+        if (result)
+        {
+            CloseHandle(thread);
+        }
+        else
+        {
+            HeapFree(GetProcessHeap(), 0, start);
+        }
+    }
+    return(result);
+}
+
+function u32
+OS_GetProcessorCount(void)
+{
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    u32 result = Max(system_info.dwNumberOfProcessors, 1);
+    return(result);
+}
+
+function b32
+OS_SemaphoreInit(OS_Semaphore *semaphore, u32 initial_count)
+{
+    semaphore->handle = CreateSemaphoreA(null, (LONG)initial_count, 0x7FFFFFFF, null);
+    return(semaphore->handle != null);
+}
+
+function void
+OS_SemaphoreSignal(OS_Semaphore *semaphore, u32 count)
+{
+    if (count)
+    {
+        ReleaseSemaphore(semaphore->handle, (LONG)count, null);
+    }
+}
+
+function void
+OS_SemaphoreWait(OS_Semaphore *semaphore)
+{
+    WaitForSingleObject(semaphore->handle, INFINITE);
+}
+
+//~ NOTE(christian): file watching
+function b32
+OS_FileWatchInit(OS_File_Watch *watch, char *directory)
+{
+    MemoryZero(watch, sizeof(OS_File_Watch));
+    watch->directory = CreateFileA(directory, FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                   null, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, null);
+    watch->event = CreateEventA(null, TRUE, FALSE, null);
+    watch->wake_event = CreateEventA(null, TRUE, FALSE, null);
+    b32 result = (watch->directory != INVALID_HANDLE_VALUE) && (watch->event != null) && (watch->wake_event != null);
+    if (!result)
+    {
+        OS_FileWatchClose(watch);
+    }
+    return(result);
+}
+
+function u32
+OS_FileWatchWait(OS_File_Watch *watch, u32 timeout_ms, char *out_path, u32 out_path_capacity)
+{
+    u32 result = 0;
+    u64 begin_ticks = OS_GetTicks();
+    while (!result)
+    {
+        if (watch->buffer_offset >= watch->buffer_size)
+        {
+            // NOTE(christian): the read stays queued across calls that time out, so nothing that
+            // happens in between is missed.
+            if (!watch->read_pending)
+            {
+                ResetEvent(watch->event);
+                MemoryZero(&watch->overlapped, sizeof(watch->overlapped));
+                watch->overlapped.hEvent = watch->event;
+                if (!ReadDirectoryChangesW(watch->directory, watch->buffer, sizeof(watch->buffer), TRUE,
+                                           FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE,
+                                           null, &watch->overlapped, null))
+                {
+                    break;
+                }
+                watch->read_pending = True;
+            }
+            
+            DWORD wait_ms = INFINITE;
+            if (timeout_ms != os_wait_infinite)
+            {
+                u64 elapsed_ms = (u64)(1000.0 * OS_SecondsBetweenTicksF64(begin_ticks, OS_GetTicks()));
+                wait_ms = (elapsed_ms < timeout_ms) ? (DWORD)(timeout_ms - elapsed_ms) : 0;
+            }
+            
+            // NOTE(christian): a change and a wake both pending gives the change, the wake stays set.
+            HANDLE wait_handles[2] = { watch->event, watch->wake_event };
+            if (WaitForMultipleObjects(2, wait_handles, FALSE, wait_ms) != WAIT_OBJECT_0)
+            {
+                break;
+            }
+            
+            // NOTE(christian): 0 bytes means the buffer overflowed and the changes are lost.
+            DWORD size = 0;
+            GetOverlappedResult(watch->directory, &watch->overlapped, &size, FALSE);
+            watch->read_pending = False;
+            watch->buffer_size = (u32)size;
+            watch->buffer_offset = 0;
+            continue;
+        }
+        
+        FILE_NOTIFY_INFORMATION *info = (FILE_NOTIFY_INFORMATION *)((u8 *)watch->buffer + watch->buffer_offset);
+        watch->buffer_offset = info->NextEntryOffset ? (watch->buffer_offset + info->NextEntryOffset) : watch->buffer_size;
+        if ((info->Action == FILE_ACTION_ADDED) ||
+            (info->Action == FILE_ACTION_MODIFIED) ||
+            (info->Action == FILE_ACTION_RENAMED_NEW_NAME))
+        {
+            s32 length = WideCharToMultiByte(CP_UTF8, 0, info->FileName, (s32)(info->FileNameLength / sizeof(WCHAR)),
+                                             out_path, (s32)out_path_capacity - 1, null, null);
+            if (length > 0)
+            {
+                out_path[length] = 0;
+                for (s32 char_index = 0; char_index < length; ++char_index)
+                {
+                    if (out_path[char_index] == '\\')
+                    {
+                        out_path[char_index] = '/';
+                    }
+                }
+                result = (u32)length;
+            }
+        }
+    }
+    return(result);
+}
+
+function void
+OS_FileWatchWake(OS_File_Watch *watch)
+{
+    SetEvent(watch->wake_event);
+}
+
+function void
+OS_FileWatchClose(OS_File_Watch *watch)
+{
+    if (watch->directory != INVALID_HANDLE_VALUE)
+    {
+        // NOTE(christian): the queued read writes into the watch, so it has to be done before the watch goes away.
+        if (watch->read_pending)
+        {
+            DWORD size = 0;
+            CancelIoEx(watch->directory, &watch->overlapped);
+            GetOverlappedResult(watch->directory, &watch->overlapped, &size, TRUE);
+            watch->read_pending = False;
+        }
+        CloseHandle(watch->directory);
+    }
+    if (watch->event)
+    {
+        CloseHandle(watch->event);
+    }
+    if (watch->wake_event)
+    {
+        CloseHandle(watch->wake_event);
+    }
+    watch->directory = INVALID_HANDLE_VALUE;
+    watch->event = null;
+    watch->wake_event = null;
+}
+
+//~ NOTE(christian): window & events
+function Key_Code
+W32_MapWParamToKeyCode(WPARAM wparam)
+{
+    Key_Code result;
+    switch (wparam)
+    {
+        case VK_ESCAPE:
+        {
+            result = KeyCode_Escape;
+        } break;
+        
+        case VK_LEFT:
+        {
+            result = KeyCode_LeftArrow;
+        } break;
+        
+        case VK_UP:
+        {
+            result = KeyCode_UpArrow;
+        } break;
+        
+        case VK_RIGHT:
+        {
+            result = KeyCode_RightArrow;
+        } break;
+        
+        case VK_DOWN:
+        {
+            result = KeyCode_DownArrow;
+        } break;
+        
+        default:
+        {
+            result = KeyCode_Total;
+        } break;
+    }
+    
+    return(result);
+}
+
+function LRESULT __stdcall
+W32_WindowProc(HWND window, UINT message,
+               WPARAM wparam, LPARAM lparam)
+{
+    LRESULT result = 0;
+    
+    switch (message)
+    {
+        case WM_CLOSE:
+        {
+            DestroyWindow(window);
+        } break;
+        
+        case WM_DESTROY:
+        {
+            PostQuitMessage(0);
+        } break;
+        
+        default:
+        {
+            result = DefWindowProcA(window, message, wparam, lparam);
+        } break;
+    }
+    
+    return(result);
+}
+
+function void
+OS_FillEvents(void)
+{
+    OS_Input *os_input = &g_os_input;
+    OS_BeginInputFrame();
+    
+    MSG message;
+    while (PeekMessageA(&message, null, 0, 0, PM_REMOVE) != FALSE)
+    {
+        switch (message.message)
+        {
+            case WM_QUIT:
+            {
+                os_input->misc_flags |= InputFlag_Quit;
+            } break;
+            
+            case WM_KEYDOWN:
+            {
+                Key_Code key_code = W32_MapWParamToKeyCode(message.wParam);
+                if (key_code != KeyCode_Total)
+                {
+                    os_input->key_states[key_code] |= (InputInteract_Pressed | InputInteract_Held);
+                }
+            } break;
+            
+            case WM_KEYUP:
+            {
+                Key_Code key_code = W32_MapWParamToKeyCode(message.wParam);
+                if (key_code != KeyCode_Total)
+                {
+                    os_input->key_states[key_code] &= ~(InputInteract_Held);
+                    os_input->key_states[key_code] |= (InputInteract_Released);
+                }
+            } break;
+            
+            default:
+            {
+                TranslateMessage(&message);
+                DispatchMessage(&message);
+            } break;
+        }
+    }
+}
+
+function HWND
+W32_AcquireWindow(String_Const_U8 window_name, s32 width, s32 height)
+{
+    HWND result = null;
+    
+    WNDCLASSA window_class;
+    window_class.style = 0;
+    window_class.lpfnWndProc = &W32_WindowProc;
+    window_class.cbClsExtra = 0;
+    window_class.cbWndExtra = 0;
+    window_class.hInstance = GetModuleHandleA(null);
+    window_class.hIcon = LoadIconA(null, IDI_APPLICATION);
+    window_class.hCursor = LoadCursorA(null, IDC_ARROW);
+    window_class.hbrBackground = null;
+    window_class.lpszMenuName = null;
+    window_class.lpszClassName = "bytepath_class";
+    
+    if (RegisterClassA(&window_class))
+    {
+        RECT client_area;
+        client_area.left = client_area.top = 0;
+        client_area.right = width;
+        client_area.bottom = height;
+        
+        if (AdjustWindowRect(&client_area, WS_OVERLAPPEDWINDOW, FALSE) != FALSE)
+        {
+            result = CreateWindowExA(0, window_class.lpszClassName, window_name.str,
+                                     WS_OVERLAPPEDWINDOW, 0, 0,
+                                     client_area.right - client_area.left,
+                                     client_area.bottom - client_area.top,
+                                     null, null, window_class.hInstance,
+                                     null);
+        }
+    }
+    
+    g_w32_state.window = result;
+    return(result);
+}
@@ -0,0 +1,342 @@
+function void
+ParticleSystem_Init(Particle_System *system, u64 seed)
+{
+    MemoryZero(system, sizeof(Particle_System));
+    system->random_stream = RandomStream_Make(seed, 0);
+}
+
+function u32
+ParticleSystem_AddPool(Particle_System *system, Memory_Arena *arena, Particle_Style *style, u32 capacity)
+{
+    Assert(system->pool_count < particle_max_pool_count);
+    u32 result = system->pool_count++;
+    Particle_Pool *pool = system->pools + result;
+    pool->style = *style;
+    pool->capacity = capacity;
+    pool->count = 0;
+    
+    u32 padded_capacity = capacity + lane_width;
+    pool->x = MemoryArena_PushArrayZero(arena, f32, padded_capacity);
+    pool->y = MemoryArena_PushArrayZero(arena, f32, padded_capacity);
+    pool->dx = MemoryArena_PushArrayZero(arena, f32, padded_capacity);
+    pool->dy = MemoryArena_PushArrayZero(arena, f32, padded_capacity);
+    pool->t = MemoryArena_PushArrayZero(arena, f32, padded_capacity);
+    pool->t_rate = MemoryArena_PushArrayZero(arena, f32, padded_capacity);
+    pool->size = MemoryArena_PushArrayZero(arena, f32, padded_capacity);
+    pool->dead_indices = MemoryArena_PushArray(arena, u32, capacity);
+    pool->batch_dead_counts = MemoryArena_PushArrayZero(arena, u32, (capacity + particle_update_batch_size - 1) / particle_update_batch_size);
+    return(result);
+}
+
+inline u32
+ParticleSystem_Count(Particle_System *system)
+{
+    u32 result = 0;
+    for (u32 pool_index = 0; pool_index < system->pool_count; ++pool_index)
+    {
+        result += system->pools[pool_index].count;
+    }
+    return(result);
+}
+
+inline lane_f32
+LaneF32_ParticleEase(lane_f32 t, Particle_Ease ease)
+{
+    lane_f32 result = t;
+    if (ease == ParticleEase_OutQuart)
+    {
+        result = LaneF32_EaseOutQuart(t);
+    }
+    else if (ease == ParticleEase_InQuart)
+    {
+        result = LaneF32_EaseInQuart(t);
+    }
+    return(result);
+}
+
+//~ NOTE(christian): spawning
+// NOTE(christian): a pool that is full drops the rest of the burst.
+function void
+ParticleSystem_Emit(Particle_System *system, Particle_Emitter *emitter, u32 count)
+{
+    Assert(emitter->pool_index < system->pool_count);
+    Particle_Pool *pool = system->pools + emitter->pool_index;
+    count = Min(count, pool->capacity - pool->count);
+    
+    f32 sines[particle_spawn_block_size];
+    f32 cosines[particle_spawn_block_size];
+    f32 scratch[particle_spawn_block_size];
+    lane_f32 x = LaneF32_Set1(emitter->p.x);
+    lane_f32 y = LaneF32_Set1(emitter->p.y);
+    lane_f32 zero = LaneF32_Set1(0.0f);
+    lane_f32 one = LaneF32_Set1(1.0f);
+    Random_Stream *random_stream = &system->random_stream;
+    while (count)
+    {
+        u32 first = pool->count;
+        u32 block_count = Min(count, particle_spawn_block_size);
+        RandomStream_FillF32Range(random_stream, scratch, block_count,
+                                  emitter->angle - emitter->spread, emitter->angle + emitter->spread);
+        BatchF32_SinCosApprox(sines, cosines, scratch, block_count);
+        RandomStream_FillF32Range(random_stream, scratch, block_count, emitter->speed_min, emitter->speed_max);
+        
+        // NOTE(christian): the arrays have a lane of slack, so whole lanes are fine up to block_count.
+        for (u32 index = 0; index < block_count; index += lane_width)
+        {
+            u32 particle_index = first + index;
+            lane_f32 speed = LaneF32_Load(scratch + index);
+            LaneF32_Store(pool->x + particle_index, x);
+            LaneF32_Store(pool->y + particle_index, y);
+            LaneF32_Store(pool->dx + particle_index, LaneF32_Multiply(LaneF32_Load(cosines + index), speed));
+            LaneF32_Store(pool->dy + particle_index, LaneF32_Multiply(LaneF32_Load(sines + index), speed));
+            LaneF32_Store(pool->t + particle_index, zero);
+        }
+        
+        RandomStream_FillF32Range(random_stream, scratch, block_count, emitter->lifetime_min, emitter->lifetime_max);
+        for (u32 index = 0; index < block_count; index += lane_width)
+        {
+            LaneF32_Store(pool->t_rate + first + index, LaneF32_Divide(one, LaneF32_Load(scratch + index)));
+        }
+        RandomStream_FillF32Range(random_stream, pool->size + first, block_count, emitter->size_min, emitter->size_max);
+        
+        pool->count += block_count;
+        count -= block_count;
+    }
+}
+
+function void
+ParticleEmitter_Update(Particle_System *system, Particle_Emitter *emitter, f32 delta_time)
+{
+    emitter->spawn_accumulator += emitter->rate * delta_time;
+    u32 count = (u32)emitter->spawn_accumulator;
+    emitter->spawn_accumulator -= (f32)count;
+    ParticleSystem_Emit(system, emitter, count);
+}
+
+//~ NOTE(christian): update
+function void
+ParticlePool_RemoveAt(Particle_Pool *pool, u32 index)
+{
+    u32 last = --pool->count;
+    pool->x[index] = pool->x[last];
+    pool->y[index] = pool->y[last];
+    pool->dx[index] = pool->dx[last];
+    pool->dy[index] = pool->dy[last];
+    pool->t[index] = pool->t[last];
+    pool->t_rate[index] = pool->t_rate[last];
+    pool->size[index] = pool->size[last];
+}
+
+function void
+ParticlePool_UpdateJob(void *data, u32 first, u32 one_past_last)
+{
+    Particle_Job *job = (Particle_Job *)data;
+    Particle_Pool *pool = job->pool;
+    f32 delta_time = job->delta_time;
+    f32 damping = expf(-pool->style.drag * delta_time);
+    u32 *dead_indices = pool->dead_indices + first;
+    u32 dead_count = 0;
+    
+    lane_f32 delta_time_wide = LaneF32_Set1(delta_time);
+    lane_f32 damping_wide = LaneF32_Set1(damping);
+    lane_f32 one = LaneF32_Set1(1.0f);
+    u32 index = first;
+    for (; (index + lane_width) <= one_past_last; index += lane_width)
+    {
+        lane_f32 dx = LaneF32_Multiply(LaneF32_Load(pool->dx + index), damping_wide);
+        lane_f32 dy = LaneF32_Multiply(LaneF32_Load(pool->dy + index), damping_wide);
+        lane_f32 t = LaneF32_MulAdd(LaneF32_Load(pool->t_rate + index), delta_time_wide, LaneF32_Load(pool->t + index));
+        LaneF32_Store(pool->dx + index, dx);
+        LaneF32_Store(pool->dy + index, dy);
+        LaneF32_Store(pool->x + index, LaneF32_MulAdd(dx, delta_time_wide, LaneF32_Load(pool->x + index)));
+        LaneF32_Store(pool->y + index, LaneF32_MulAdd(dy, delta_time_wide, LaneF32_Load(pool->y + index)));
+        LaneF32_Store(pool->t + index, t);
+        
+        lane_u32 dead = LaneF32_GreaterEqual(t, one);
+        if (LaneU32_AnyNonZero(dead))
+        {
+            u32 dead_lanes[lane_width];
+            LaneU32_Store(dead_lanes, dead);
+            for (u32 lane_index = 0; lane_index < lane_width; ++lane_index)
+            {
+                if (dead_lanes[lane_index])
+                {
+                    dead_indices[dead_count++] = index + lane_index;
+                }
+            }
+        }
+    }
+    
+    for (; index < one_past_last; ++index)
+    {
+        pool->dx[index] *= damping;
+        pool->dy[index] *= damping;
+        pool->x[index] += pool->dx[index] * delta_time;
+        pool->y[index] += pool->dy[index] * delta_time;
+        pool->t[index] += pool->t_rate[index] * delta_time;
+        if (pool->t[index] >= 1.0f)
+        {
+            dead_indices[dead_count++] = index;
+        }
+    }
+    pool->batch_dead_counts[first / particle_update_batch_size] = dead_count;
+}
+
+// NOTE(christian): the kernels only list what died, removal is serial and touches just the dead.
+// it goes from the highest index down, so whatever a swap-remove pulls in from the end is alive:
+// everything dead above it is already gone.
+function void
+ParticleSystem_Update(Particle_System *system, Job_System *jobs, f32 delta_time)
+{
+    system->tick_delta_time = delta_time;
+    
+    Job_Counter update_counter = {0};
+    for (u32 pool_index = 0; pool_index < system->pool_count; ++pool_index)
+    {
+        Particle_Job *job = system->jobs + pool_index;
+        job->system = system;
+        job->pool = system->pools + pool_index;
+        job->delta_time = delta_time;
+        JobSystem_ParallelFor(jobs, &update_counter, job->pool->count, particle_update_batch_size,
+                              &ParticlePool_UpdateJob, job);
+    }
+    JobSystem_Wait(jobs, &update_counter);
+    
+    for (u32 pool_index = 0; pool_index < system->pool_count; ++pool_index)
+    {
+        Particle_Pool *pool = system->pools + pool_index;
+        u32 batch_count = (pool->count + particle_update_batch_size - 1) / particle_update_batch_size;
+        for (u32 batch_index = batch_count; batch_index > 0; --batch_index)
+        {
+            u32 *dead_indices = pool->dead_indices + (batch_index - 1) * particle_update_batch_size;
+            for (u32 dead_index = pool->batch_dead_counts[batch_index - 1]; dead_index > 0; --dead_index)
+            {
+                ParticlePool_RemoveAt(pool, dead_indices[dead_index - 1]);
+            }
+        }
+    }
+}
+
+//~ NOTE(christian): rendering
+function void
+ParticlePool_RenderJob(void *data, u32 first, u32 one_past_last)
+{
+    Particle_Job *job = (Particle_Job *)data;
+    Particle_Pool *pool = job->pool;
+    Particle_Style *style = &pool->style;
+    
+    u32 count = one_past_last - first;
+    u32 quad_index;
+    Quad_Render_Chunk *chunk = QuadRenderChunk_Seek(job->first_chunk, job->first_quad_in_chunk, first, &quad_index);
+    
+    lane_f32 back = LaneF32_Set1((job->interpolation - 1.0f) * job->system->tick_delta_time);
+    lane_f32 colour_start[4];
+    lane_f32 colour_delta[4];
+    for (u32 channel = 0; channel < 4; ++channel)
+    {
+        colour_start[channel] = LaneF32_Set1(style->colour_start.v[channel]);
+        colour_delta[channel] = LaneF32_Set1(style->colour_end.v[channel] - style->colour_start.v[channel]);
+    }
+    lane_f32 size_start = LaneF32_Set1(style->size_start);
+    lane_f32 size_delta = LaneF32_Set1(style->size_end - style->size_start);
+    lane_f32 half_roundness = LaneF32_Set1(style->roundness * 0.5f);
+    lane_f32 stretch = LaneF32_Set1(style->stretch);
+    lane_f32 half = LaneF32_Set1(0.5f);
+    lane_f32 zero = LaneF32_Set1(0.0f);
+    lane_f32 tiny = LaneF32_Set1(1.0e-12f);
+    b32 stretched = style->stretch > 0.0f;
+    
+    // NOTE(christian): the fields of lane_width quads, in Quad order. the colours past the first stay zero.
+    lane_u32 fields[8];
+    for (u32 field_index = 0; field_index < ArrayCount(fields); ++field_index)
+    {
+        fields[field_index] = LaneU32_Set1(0);
+    }
+    
+    // NOTE(christian): whole lanes, the tail reads into the pool's slack and is never stored.
+    for (u32 index = 0; index < count; index += lane_width)
+    {
+        u32 particle_index = first + index;
+        lane_f32 t = LaneF32_Load(pool->t + particle_index);
+        lane_f32 dx = LaneF32_Load(pool->dx + particle_index);
+        lane_f32 dy = LaneF32_Load(pool->dy + particle_index);
+        lane_f32 x = LaneF32_MulAdd(dx, back, LaneF32_Load(pool->x + particle_index));
+        lane_f32 y = LaneF32_MulAdd(dy, back, LaneF32_Load(pool->y + particle_index));
+        
+        lane_f32 colour_t = LaneF32_ParticleEase(t, style->colour_ease);
+        fields[4] = QuadPack_LaneColour(LaneF32_MulAdd(colour_delta[0], colour_t, colour_start[0]),
+                                        LaneF32_MulAdd(colour_delta[1], colour_t, colour_start[1]),
+                                        LaneF32_MulAdd(colour_delta[2], colour_t, colour_start[2]),
+                                        LaneF32_MulAdd(colour_delta[3], colour_t, colour_start[3]));
+        
+        lane_f32 size = LaneF32_Multiply(LaneF32_Load(pool->size + particle_index),
+                                         LaneF32_MulAdd(size_delta, LaneF32_ParticleEase(t, style->size_ease), size_start));
+        fields[3] = QuadPack_LaneStyle(LaneF32_Multiply(size, half_roundness), zero, QuadFlag_UniformColour);
+        
+        lane_f32 axis_x_x = size;
+        lane_f32 axis_x_y = zero;
+        lane_f32 axis_y_x = zero;
+        lane_f32 axis_y_y = size;
+        if (stretched)
+        {
+            // NOTE(christian): x runs along the velocity, size plus stretch seconds of travel long.
+            lane_f32 speed_squared = LaneF32_Add(LaneF32_Multiply(dx, dx), LaneF32_Multiply(dy, dy));
+            lane_f32 inverse_speed = LaneF32_RSqrtApprox(LaneF32_Max(speed_squared, tiny));
+            lane_f32 direction_x = LaneF32_Multiply(dx, inverse_speed);
+            lane_f32 direction_y = LaneF32_Multiply(dy, inverse_speed);
+            lane_f32 length = LaneF32_MulAdd(LaneF32_Multiply(speed_squared, inverse_speed), stretch, size);
+            axis_x_x = LaneF32_Multiply(direction_x, length);
+            axis_x_y = LaneF32_Multiply(direction_y, length);
+            axis_y_x = LaneF32_Multiply(LaneF32_Subtract(zero, direction_y), size);
+            axis_y_y = LaneF32_Multiply(direction_x, size);
+        }
+        fields[1] = QuadPack_LaneV2F(axis_x_x, axis_x_y);
+        fields[2] = QuadPack_LaneV2F(axis_y_x, axis_y_y);
+        fields[0] = QuadPack_LaneV2F(LaneF32_Subtract(x, LaneF32_Multiply(LaneF32_Add(axis_x_x, axis_y_x), half)),
+                                     LaneF32_Subtract(y, LaneF32_Multiply(LaneF32_Add(axis_x_y, axis_y_y), half)));
+        
+        if (quad_index == quad_render_chunk_capacity)
+        {
+            chunk = chunk->next;
+            quad_index = 0;
+        }
+        
+        // NOTE(christian): straight into the batch, unless the lanes run past the range or straddle two
+        // chunks, which a range that doesn't start lane aligned does once per chunk.
+        if (((index + lane_width) <= count) && ((quad_index + lane_width) <= quad_render_chunk_capacity))
+        {
+            LaneU32_StoreInterleaved8((u32 *)(chunk->quads + quad_index), fields);
+            quad_index += lane_width;
+        }
+        else
+        {
+            Quad staged[lane_width];
+            LaneU32_StoreInterleaved8((u32 *)staged, fields);
+            for (u32 lane_index = 0; lane_index < Min(lane_width, count - index); ++lane_index)
+            {
+                if (quad_index == quad_render_chunk_capacity)
+                {
+                    chunk = chunk->next;
+                    quad_index = 0;
+                }
+                chunk->quads[quad_index++] = staged[lane_index];
+            }
+        }
+    }
+}
+
+function void
+ParticleSystem_Render(Particle_System *system, Job_System *jobs, Job_Counter *counter,
+                      Quad_Render_Batch *quad_render_batch, f32 interpolation)
+{
+    for (u32 pool_index = 0; pool_index < system->pool_count; ++pool_index)
+    {
+        Particle_Job *job = system->jobs + pool_index;
+        job->system = system;
+        job->pool = system->pools + pool_index;
+        job->interpolation = interpolation;
+        job->quad_count = QuadRenderBatch_Reserve(quad_render_batch, job->pool->count,
+                                                  &job->first_chunk, &job->first_quad_in_chunk);
+        JobSystem_ParallelFor(jobs, counter, job->quad_count, particle_render_batch_size, &ParticlePool_RenderJob, job);
+    }
+}
@@ -0,0 +1,278 @@
+#if BP_PROFILER
+
+global Profile_Thread g_profile_threads[profiler_max_threads];
+global u32 g_profile_thread_count;
+global per_thread Profile_Thread *tl_profile_thread;
+
+// NOTE(christian): threads past profiler_max_threads (or whose ring couldn't be allocated) all write
+// here. it is never read, so the races on it don't matter.
+global Profile_Event g_profile_discard_events[profiler_ring_capacity];
+global Profile_Thread g_profile_discard_thread = { g_profile_discard_events, 0, 0 };
+
+global u64 g_profile_begin_counter;
+global u64 g_profile_begin_ticks;
+
+function Profile_Thread *
+Profiler_RegisterThread(void)
+{
+    Profile_Thread *result = &g_profile_discard_thread;
+    u32 thread_index = AtomicIncrementU32(&g_profile_thread_count) - 1;
+    if (thread_index < profiler_max_threads)
+    {
+        u64 ring_size = sizeof(Profile_Event) * profiler_ring_capacity;
+        Profile_Event *events = (Profile_Event *)OS_ReserveMemory(ring_size);
+        if (events && OS_CommitMemory(events, ring_size))
+        {
+            result = g_profile_threads + thread_index;
+            result->events = events;
+            result->thread_id = thread_index;
+        }
+    }
+    
+    tl_profile_thread = result;
+    return(result);
+}
+
+// NOTE(christian): call on the main thread before anything else records, so it becomes thread 0.
+function void
+Profiler_Init(void)
+{
+    Profiler_RegisterThread();
+    g_profile_begin_ticks = OS_GetTicks();
+    g_profile_begin_counter = Profiler_ReadCounter();
+}
+
+inline void
+Profiler_Record(char *name, u64 end)
+{
+    Profile_Thread *thread = tl_profile_thread;
+    if (!thread)
+    {
+        thread = Profiler_RegisterThread();
+    }
+    
+    Profile_Event *event = thread->events + (thread->event_count & (profiler_ring_capacity - 1));
+    event->stamp = (Profiler_ReadCounter() << 1) | end;
+    event->name = name;
+    ++thread->event_count;
+}
+
+// NOTE(christian): measured against the os clock over the whole run so far.
+function f64
+Profiler_CountersPerSecond(void)
+{
+    u64 counter = Profiler_ReadCounter();
+    f64 seconds = OS_SecondsBetweenTicksF64(g_profile_begin_ticks, OS_GetTicks());
+    f64 result = (seconds > 0.0) ? ((f64)(counter - g_profile_begin_counter) / seconds) : 1.0;
+    return(result);
+}
+
+inline u64
+Profiler_EventCounter(Profile_Event *event)
+{
+    return(event->stamp >> 1);
+}
+
+// NOTE(christian): reads the rings while other threads may still write them, so call it with the
+// workers idle (at exit). zones the ring lost the begin of are dropped, zones still open are left
+// open, which chrome draws up to the end of the trace.
+function b32
+Profiler_WriteChromeTrace(char *path)
+{
+    b32 result = False;
+    FILE *file = fopen(path, "wb");
+    if (file)
+    {
+        f64 micros_per_counter = 1000000.0 / Profiler_CountersPerSecond();
+        // NOTE(christian): same top bit loss as the stamps.
+        u64 begin_counter = (g_profile_begin_counter << 1) >> 1;
+        
+        fprintf(file, "{\"traceEvents\":[\n");
+        b32 first_event = True;
+        u32 thread_count = Min(g_profile_thread_count, profiler_max_threads);
+        for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+        {
+            Profile_Thread *thread = g_profile_threads + thread_index;
+            u64 event_count = thread->event_count;
+            u64 first_index = (event_count > profiler_ring_capacity) ? (event_count - profiler_ring_capacity) : 0;
+            u32 depth = 0;
+            for (u64 event_index = first_index; event_index < event_count; ++event_index)
+            {
+                Profile_Event *event = thread->events + (event_index & (profiler_ring_capacity - 1));
+                b32 end = event->stamp & 1;
+                if (end)
+                {
+                    if (!depth)
+                    {
+                        continue;
+                    }
+                    --depth;
+                }
+                else
+                {
+                    ++depth;
+                }
+                
+                u64 counter = Profiler_EventCounter(event);
+                f64 micros = (counter > begin_counter) ? ((f64)(counter - begin_counter) * micros_per_counter) : 0.0;
+                fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}",
+                        first_event ? "" : ",\n", event->name, end ? 'E' : 'B', micros, thread->thread_id);
+                first_event = False;
+            }
+        }
+        fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+        
+        result = ferror(file) == 0;
+        fclose(file);
+    }
+    return(result);
+}
+
+//~ NOTE(christian): per frame breakdown
+#define profiler_max_nodes 256
+
+typedef struct Profile_Node
+{
+    char *name;
+    u32 parent;
+    u32 depth;
+    u64 total_counter;
+    u64 max_counter;
+    u64 hit_count;
+} Profile_Node;
+
+function u32
+Profiler_FindOrAddNode(Profile_Node *nodes, u32 *node_count, char *name, u32 parent, u32 depth)
+{
+    u32 result = bad_index_u32;
+    for (u32 node_index = 0; node_index < *node_count; ++node_index)
+    {
+        if ((nodes[node_index].parent == parent) && !strcmp(nodes[node_index].name, name))
+        {
+            result = node_index;
+            break;
+        }
+    }
+    
+    if ((result == bad_index_u32) && (*node_count < profiler_max_nodes))
+    {
+        result = (*node_count)++;
+        MemoryZero(nodes + result, sizeof(Profile_Node));
+        nodes[result].name = name;
+        nodes[result].parent = parent;
+        nodes[result].depth = depth;
+    }
+    return(result);
+}
+
+function void
+Profiler_PrintNodes(Profile_Node *nodes, u32 node_count, u32 parent, u64 frame_count, f64 millis_per_counter, f64 frame_millis)
+{
+    for (u32 node_index = 0; node_index < node_count; ++node_index)
+    {
+        Profile_Node *node = nodes + node_index;
+        if (node->parent == parent)
+        {
+            f64 average_millis = (f64)node->total_counter * millis_per_counter / (f64)frame_count;
+            printf("  %*s%-*s %9.4f ms %6.1f%% %9.4f ms max %8.2f hits\n",
+                   (int)(node->depth * 2), "", (int)(28 - node->depth * 2), node->name,
+                   average_millis, (frame_millis > 0.0) ? (100.0 * average_millis / frame_millis) : 0.0,
+                   (f64)node->max_counter * millis_per_counter, (f64)node->hit_count / (f64)frame_count);
+            Profiler_PrintNodes(nodes, node_count, node_index, frame_count, millis_per_counter, frame_millis);
+        }
+    }
+}
+
+// NOTE(christian): averages the main thread's zones over the profiler_frame_zone zones still in its
+// ring. zones are told apart by name and parent, so the same name under two parents is two rows.
+function void
+Profiler_PrintFrameBreakdown(void)
+{
+    Profile_Thread *thread = g_profile_threads + 0;
+    if (!g_profile_thread_count || !thread->events)
+    {
+        return;
+    }
+    
+    Temporary_Memory scratch = Scratch_Begin(null, 0);
+    Profile_Node *nodes = MemoryArena_PushArray(scratch.arena, Profile_Node, profiler_max_nodes);
+    u32 node_count = 0;
+    
+    u32 stack_nodes[64];
+    u64 stack_counters[64];
+    u32 depth = 0;
+    u32 dropped_depth = 0;
+    u64 frame_count = 0;
+    f64 frame_millis = 0.0;
+    f64 millis_per_counter = 1000.0 / Profiler_CountersPerSecond();
+    
+    // NOTE(christian): only start at a top level frame begin, so every stack is complete.
+    u64 event_count = thread->event_count;
+    u64 first_index = (event_count > profiler_ring_capacity) ? (event_count - profiler_ring_capacity) : 0;
+    b32 in_frames = False;
+    for (u64 event_index = first_index; event_index < event_count; ++event_index)
+    {
+        Profile_Event *event = thread->events + (event_index & (profiler_ring_capacity - 1));
+        b32 end = event->stamp & 1;
+        if (!in_frames)
+        {
+            in_frames = !end && !strcmp(event->name, profiler_frame_zone);
+            if (!in_frames)
+            {
+                continue;
+            }
+        }
+        
+        if (!end)
+        {
+            // NOTE(christian): inside a dropped zone nothing gets a node, so skipped zones don't use up slots.
+            u32 node_index = bad_index_u32;
+            if (!dropped_depth && (depth < ArrayCount(stack_nodes)))
+            {
+                u32 parent = depth ? stack_nodes[depth - 1] : bad_index_u32;
+                node_index = Profiler_FindOrAddNode(nodes, &node_count, event->name, parent, depth);
+            }
+            
+            if (node_index == bad_index_u32)
+            {
+                // NOTE(christian): out of nodes or too deep. skip this zone and everything inside it.
+                ++dropped_depth;
+                continue;
+            }
+            
+            stack_nodes[depth] = node_index;
+            stack_counters[depth] = Profiler_EventCounter(event);
+            ++depth;
+        }
+        else if (dropped_depth)
+        {
+            --dropped_depth;
+        }
+        else if (depth)
+        {
+            --depth;
+            Profile_Node *node = nodes + stack_nodes[depth];
+            u64 elapsed = Profiler_EventCounter(event) - stack_counters[depth];
+            node->total_counter += elapsed;
+            node->max_counter = Max(node->max_counter, elapsed);
+            ++node->hit_count;
+            
+            if (!depth && !strcmp(node->name, profiler_frame_zone))
+            {
+                ++frame_count;
+                frame_millis = (f64)node->total_counter * millis_per_counter;
+            }
+        }
+    }
+    
+    if (frame_count)
+    {
+        frame_millis /= (f64)frame_count;
+        printf("zones: last %llu frames, main thread, avg per frame\n", (unsigned long long)frame_count);
+        Profiler_PrintNodes(nodes, node_count, bad_index_u32, frame_count, millis_per_counter, frame_millis);
+    }
+    
+    Scratch_End(scratch);
+}
+
+#endif // BP_PROFILER
@@ -0,0 +1,63 @@
+/* date = October 17th 2026 7:10 pm */
+
+#ifndef BP_PROFILER_H
+#define BP_PROFILER_H
+
+// NOTE(christian): zones are begin / end events stamped with the cycle counter and written to a
+// ring per thread. nothing is aggregated while recording, a zone edge is one counter read and one
+// 16 byte store. the rings keep the last profiler_ring_capacity events of every thread, which is
+// what the chrome trace export (chrome://tracing, ui.perfetto.dev) and the per frame breakdown see.
+//
+// BP_PROFILER follows BP_DEBUG unless it is set. when it is off the macros expand to nothing and
+// none of this gets compiled.
+#if !defined(BP_PROFILER)
+# define BP_PROFILER BP_DEBUG
+#endif
+
+#if BP_PROFILER
+
+#define profiler_ring_capacity (64*1024)
+#define profiler_max_threads 64
+
+// NOTE(christian): the zone that wraps a whole frame on the main thread. the breakdown is per one of these.
+#define profiler_frame_zone "frame"
+
+// NOTE(christian): bit 0 of the stamp says whether it's an end, the counter is shifted up past it.
+typedef struct Profile_Event
+{
+    u64 stamp;
+    char *name;
+} Profile_Event;
+
+typedef struct Profile_Thread
+{
+    Profile_Event *events;
+    u64 event_count;
+    u32 thread_id;
+} Profile_Thread;
+
+#if COMPILER_MSVC
+# define Profiler_ReadCounter() ReadTimeStampCounter()
+#elif ARCH_X64
+# define Profiler_ReadCounter() __builtin_ia32_rdtsc()
+#else
+# define Profiler_ReadCounter() OS_GetTicks()
+#endif
+
+function void Profiler_Init(void);
+inline void Profiler_Record(char *name, u64 end);
+function b32 Profiler_WriteChromeTrace(char *path);
+function void Profiler_PrintFrameBreakdown(void);
+
+// NOTE(christian): the name on ProfileEnd is for whoever reads the code, only begins are matched by position.
+# define ProfileBegin(name) Profiler_Record(name, 0)
+# define ProfileEnd(name) Profiler_Record(name, 1)
+
+#else
+
+# define ProfileBegin(name)
+# define ProfileEnd(name)
+
+#endif
+
+#endif //BP_PROFILER_H
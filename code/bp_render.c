@@ -0,0 +1,1229 @@
+//~ NOTE(christian): quad packing
+inline u32
+QuadPack_S16(f32 a)
+{
+    f32 clamped = Clamp(quad_position_min, a, quad_position_max);
+    u32 result = (u32)(s32)RoundF32(clamped * quad_position_scale) & 0xFFFF;
+    return(result);
+}
+
+inline u32
+QuadPack_U8(f32 a)
+{
+    f32 clamped = Clamp(0.0f, a, 1.0f);
+    u32 result = (u32)(s32)RoundF32(clamped * 255.0f);
+    return(result);
+}
+
+inline u32
+QuadPack_V2F(v2f a)
+{
+    u32 result = QuadPack_S16(a.x) | (QuadPack_S16(a.y) << 16);
+    return(result);
+}
+
+inline u32
+QuadPack_Colour(v4f colour)
+{
+    u32 result = (QuadPack_U8(colour.r) |
+                  (QuadPack_U8(colour.g) << 8) |
+                  (QuadPack_U8(colour.b) << 16) |
+                  (QuadPack_U8(colour.a) << 24));
+    return(result);
+}
+
+inline u32
+QuadPack_UV(v2f uv)
+{
+    f32 u = Clamp(0.0f, uv.x, 1.0f);
+    f32 v = Clamp(0.0f, uv.y, 1.0f);
+    u32 result = (u32)(s32)RoundF32(u * quad_uv_scale) | ((u32)(s32)RoundF32(v * quad_uv_scale) << 16);
+    return(result);
+}
+
+inline u32
+QuadPack_Style(f32 side_roundness, f32 side_thickness, u32 flags)
+{
+    f32 roundness = Clamp(0.0f, side_roundness, quad_style_max);
+    f32 thickness = Clamp(0.0f, side_thickness, quad_style_max);
+    u32 result = ((u32)(s32)RoundF32(roundness * quad_style_scale) |
+                  ((u32)(s32)RoundF32(thickness * quad_style_scale) << quad_style_thickness_shift) |
+                  (flags << quad_style_flags_shift));
+    return(result);
+}
+
+inline v2f
+QuadUnpack_V2F(u32 packed)
+{
+    f32 scale = 1.0f / quad_position_scale;
+    v2f result = V2F((f32)(s16)(packed & 0xFFFF) * scale, (f32)(s16)(packed >> 16) * scale);
+    return(result);
+}
+
+inline v4f
+QuadUnpack_Colour(u32 packed)
+{
+    f32 scale = 1.0f / 255.0f;
+    v4f result = RGBA((f32)(packed & 0xFF) * scale,
+                      (f32)((packed >> 8) & 0xFF) * scale,
+                      (f32)((packed >> 16) & 0xFF) * scale,
+                      (f32)(packed >> 24) * scale);
+    return(result);
+}
+
+inline v2f
+QuadUnpack_UV(u32 packed)
+{
+    f32 scale = 1.0f / quad_uv_scale;
+    v2f result = V2F((f32)(packed & 0xFFFF) * scale, (f32)(packed >> 16) * scale);
+    return(result);
+}
+
+function Quad_Unpacked
+Quad_Unpack(Quad *quad)
+{
+    Quad_Unpacked result;
+    u32 style_mask = (1 << quad_style_thickness_shift) - 1;
+    result.origin = QuadUnpack_V2F(quad->origin);
+    result.x_axis = QuadUnpack_V2F(quad->x_axis);
+    result.y_axis = QuadUnpack_V2F(quad->y_axis);
+    result.side_roundness = (f32)(quad->style & style_mask) / quad_style_scale;
+    result.side_thickness = (f32)((quad->style >> quad_style_thickness_shift) & style_mask) / quad_style_scale;
+    result.flags = quad->style >> quad_style_flags_shift;
+    if (result.flags & QuadFlag_UniformColour)
+    {
+        v4f colour = QuadUnpack_Colour(quad->colours[0]);
+        result.colours[0] = colour;
+        result.colours[1] = colour;
+        result.colours[2] = colour;
+        result.colours[3] = colour;
+        result.uv_min = QuadUnpack_UV(quad->colours[1]);
+        result.uv_max = QuadUnpack_UV(quad->colours[2]);
+    }
+    else
+    {
+        for (u32 colour_index = 0; colour_index < ArrayCount(result.colours); ++colour_index)
+        {
+            result.colours[colour_index] = QuadUnpack_Colour(quad->colours[colour_index]);
+        }
+        result.uv_min = V2F(0.0f, 0.0f);
+        result.uv_max = V2F(0.0f, 0.0f);
+    }
+    return(result);
+}
+
+inline void
+Quad_GetBounds(Quad *quad, v2f *out_min, v2f *out_max)
+{
+    v2f origin = QuadUnpack_V2F(quad->origin);
+    v2f x_axis = QuadUnpack_V2F(quad->x_axis);
+    v2f y_axis = QuadUnpack_V2F(quad->y_axis);
+    out_min->x = origin.x + Min(x_axis.x, 0.0f) + Min(y_axis.x, 0.0f);
+    out_min->y = origin.y + Min(x_axis.y, 0.0f) + Min(y_axis.y, 0.0f);
+    out_max->x = origin.x + Max(x_axis.x, 0.0f) + Max(y_axis.x, 0.0f);
+    out_max->y = origin.y + Max(x_axis.y, 0.0f) + Max(y_axis.y, 0.0f);
+}
+
+inline lane_u32
+QuadPack_LaneV2F(lane_f32 x, lane_f32 y)
+{
+    lane_f32 min = LaneF32_Set1(quad_position_min);
+    lane_f32 max = LaneF32_Set1(quad_position_max);
+    lane_f32 scale = LaneF32_Set1(quad_position_scale);
+    lane_u32 fixed_x = LaneU32_FromF32(LaneF32_Multiply(LaneF32_Min(LaneF32_Max(x, min), max), scale));
+    lane_u32 fixed_y = LaneU32_FromF32(LaneF32_Multiply(LaneF32_Min(LaneF32_Max(y, min), max), scale));
+    lane_u32 result = LaneU32_Or(LaneU32_And(fixed_x, LaneU32_Set1(0xFFFF)), LaneU32_ShiftLeft(fixed_y, 16));
+    return(result);
+}
+
+inline lane_u32
+QuadPack_LaneU8(lane_f32 a)
+{
+    lane_f32 clamped = LaneF32_Min(LaneF32_Max(a, LaneF32_Set1(0.0f)), LaneF32_Set1(1.0f));
+    lane_u32 result = LaneU32_FromF32(LaneF32_Multiply(clamped, LaneF32_Set1(255.0f)));
+    return(result);
+}
+
+inline lane_u32
+QuadPack_LaneColour(lane_f32 r, lane_f32 g, lane_f32 b, lane_f32 a)
+{
+    lane_u32 result = LaneU32_Or(LaneU32_Or(QuadPack_LaneU8(r), LaneU32_ShiftLeft(QuadPack_LaneU8(g), 8)),
+                                 LaneU32_Or(LaneU32_ShiftLeft(QuadPack_LaneU8(b), 16), LaneU32_ShiftLeft(QuadPack_LaneU8(a), 24)));
+    return(result);
+}
+
+inline lane_u32
+QuadPack_LaneStyle(lane_f32 side_roundness, lane_f32 side_thickness, u32 flags)
+{
+    lane_f32 zero = LaneF32_Set1(0.0f);
+    lane_f32 max = LaneF32_Set1(quad_style_max);
+    lane_f32 scale = LaneF32_Set1(quad_style_scale);
+    lane_u32 roundness = LaneU32_FromF32(LaneF32_Multiply(LaneF32_Min(LaneF32_Max(side_roundness, zero), max), scale));
+    lane_u32 thickness = LaneU32_FromF32(LaneF32_Multiply(LaneF32_Min(LaneF32_Max(side_thickness, zero), max), scale));
+    lane_u32 result = LaneU32_Or(LaneU32_Or(roundness, LaneU32_ShiftLeft(thickness, quad_style_thickness_shift)),
+                                 LaneU32_Set1(flags << quad_style_flags_shift));
+    return(result);
+}
+
+//~ NOTE(christian): quad rendering
+function Quad_Render_Chunk *
+QuadRenderBatch_AllocateChunk(Quad_Render_Batch *render_batch)
+{
+    Quad_Render_Chunk *result = (Quad_Render_Chunk *)MemoryArena_PushAligned(&render_batch->chunk_arena,
+                                                                             sizeof(Quad_Render_Chunk),
+                                                                             memory_arena_default_alignment);
+    if (result)
+    {
+        result->next = null;
+        result->quads_drawn = 0;
+        ++render_batch->chunk_count;
+    }
+    return(result);
+}
+
+function b32
+QuadRenderBatch_Init(Quad_Render_Batch *render_batch)
+{
+    b32 result = False;
+    render_batch->first_chunk = null;
+    render_batch->current_chunk = null;
+    render_batch->chunk_count = 0;
+    render_batch->quads_drawn = 0;
+    
+    if (MemoryArena_Init(&render_batch->chunk_arena, quad_render_batch_reserve))
+    {
+        render_batch->first_chunk = QuadRenderBatch_AllocateChunk(render_batch);
+        render_batch->current_chunk = render_batch->first_chunk;
+        result = render_batch->first_chunk != null;
+    }
+    
+    return(result);
+}
+
+function void
+QuadRenderBatch_Reset(Quad_Render_Batch *render_batch)
+{
+    for (Quad_Render_Chunk *chunk = render_batch->first_chunk;
+         chunk && chunk->quads_drawn;
+         chunk = chunk->next)
+    {
+        chunk->quads_drawn = 0;
+    }
+    
+    render_batch->current_chunk = render_batch->first_chunk;
+    render_batch->quads_drawn = 0;
+}
+
+// NOTE(christian): slow path of QuadRenderBatch_Acquire, the current chunk is full.
+function Quad_Render_Chunk *
+QuadRenderBatch_AdvanceChunk(Quad_Render_Batch *render_batch)
+{
+    Quad_Render_Chunk *current = render_batch->current_chunk;
+    Quad_Render_Chunk *result = current->next;
+    if (!result)
+    {
+        result = QuadRenderBatch_AllocateChunk(render_batch);
+        current->next = result;
+    }
+    
+    if (result)
+    {
+        render_batch->current_chunk = result;
+    }
+    return(result);
+}
+
+inline Quad *
+QuadRenderBatch_Acquire(Quad_Render_Batch *render_batch)
+{
+    Quad *result = &render_batch->overflow_quad;
+    Quad_Render_Chunk *chunk = render_batch->current_chunk;
+    if (chunk->quads_drawn == quad_render_chunk_capacity)
+    {
+        chunk = QuadRenderBatch_AdvanceChunk(render_batch);
+    }
+    
+    if (chunk)
+    {
+        result = chunk->quads + chunk->quads_drawn++;
+        ++render_batch->quads_drawn;
+    }
+    return(result);
+}
+
+// NOTE(christian): bulk version of QuadRenderBatch_Acquire for filling in later, possibly from
+// another thread. the range starts at (first_chunk, first_index), where first_index may be one
+// past the end of the chunk. returns how many fit in the reserve.
+function u32
+QuadRenderBatch_Reserve(Quad_Render_Batch *render_batch, u32 count, Quad_Render_Chunk **first_chunk, u32 *first_index)
+{
+    u32 result = 0;
+    Quad_Render_Chunk *chunk = render_batch->current_chunk;
+    *first_chunk = chunk;
+    *first_index = chunk->quads_drawn;
+    while ((result < count) && chunk)
+    {
+        if (chunk->quads_drawn == quad_render_chunk_capacity)
+        {
+            chunk = QuadRenderBatch_AdvanceChunk(render_batch);
+            continue;
+        }
+        
+        u32 reserve_count = Min(count - result, quad_render_chunk_capacity - chunk->quads_drawn);
+        chunk->quads_drawn += reserve_count;
+        render_batch->quads_drawn += reserve_count;
+        result += reserve_count;
+    }
+    return(result);
+}
+
+// NOTE(christian): the chunk and index offset quads further along a reserved range. every chunk but
+// the last is full, so it's a division and a few steps down the chain. index may be one past the end.
+function Quad_Render_Chunk *
+QuadRenderChunk_Seek(Quad_Render_Chunk *chunk, u32 index, u32 offset, u32 *out_index)
+{
+    Quad_Render_Chunk *result = chunk;
+    u32 position = index + offset;
+    for (u32 chunk_step = position / quad_render_chunk_capacity; chunk_step && result; --chunk_step)
+    {
+        result = result->next;
+    }
+    *out_index = position % quad_render_chunk_capacity;
+    return(result);
+}
+
+// NOTE(christian): copies count quads between two chunk chains. indices may be one past the end of their chunk.
+function void
+QuadRenderChunk_Copy(Quad_Render_Chunk *dest_chunk, u32 dest_index, Quad_Render_Chunk *source_chunk, u32 source_index, u32 count)
+{
+    while (count && dest_chunk && source_chunk)
+    {
+        if (dest_index == quad_render_chunk_capacity)
+        {
+            dest_chunk = dest_chunk->next;
+            dest_index = 0;
+        }
+        else if (source_index == quad_render_chunk_capacity)
+        {
+            source_chunk = source_chunk->next;
+            source_index = 0;
+        }
+        else
+        {
+            u32 copy_count = Min(count, Min(quad_render_chunk_capacity - dest_index, quad_render_chunk_capacity - source_index));
+            MemoryCopy(dest_chunk->quads + dest_index, source_chunk->quads + source_index, sizeof(Quad) * copy_count);
+            dest_index += copy_count;
+            source_index += copy_count;
+            count -= copy_count;
+        }
+    }
+}
+
+inline Quad *
+QuadRenderBatch_Push(Quad_Render_Batch *render_batch, v2f origin, v2f x_axis, v2f y_axis,
+                     v4f colour_tl, v4f colour_tr, v4f colour_br, v4f colour_bl, f32 side_roundness,
+                     f32 side_thickness)
+{
+    // NOTE(christian): one colour four times is the common case. it only needs colours[0], and the
+    // other three stay zero, which is the empty uv rect.
+    u32 tl = QuadPack_Colour(colour_tl);
+    u32 tr = QuadPack_Colour(colour_tr);
+    u32 bl = QuadPack_Colour(colour_bl);
+    u32 br = QuadPack_Colour(colour_br);
+    u32 flags = 0;
+    if ((tl == tr) && (tl == bl) && (tl == br))
+    {
+        flags |= QuadFlag_UniformColour;
+        tr = 0;
+        bl = 0;
+        br = 0;
+    }
+    
+    Quad *quad = QuadRenderBatch_Acquire(render_batch);
+    quad->origin = QuadPack_V2F(origin);
+    quad->x_axis = QuadPack_V2F(x_axis);
+    quad->y_axis = QuadPack_V2F(y_axis);
+    quad->style = QuadPack_Style(side_roundness, side_thickness, flags);
+    quad->colours[0] = tl;
+    quad->colours[1] = tr;
+    quad->colours[2] = bl;
+    quad->colours[3] = br;
+    return(quad);
+}
+
+inline Quad *
+QuadRenderBatch_PushRectFilled(Quad_Render_Batch *render_batch,
+                               v2f origin, v2f dims,
+                               v4f colour, f32 roundness)
+{
+    return QuadRenderBatch_Push(render_batch, origin, V2F(dims.x, 0.0f), V2F(0.0f, dims.y),
+                                colour, colour, colour, colour, roundness, 0.0f);
+}
+
+inline Quad *
+QuadRenderBatch_PushRectOutline(Quad_Render_Batch *render_batch,
+                                v2f origin, v2f dims,
+                                v4f colour, f32 roundness, f32 thickness)
+{
+    return QuadRenderBatch_Push(render_batch, origin, V2F(dims.x, 0.0f), V2F(0.0f, dims.y),
+                                colour, colour, colour, colour, roundness, thickness);
+}
+
+inline Quad *
+QuadRenderBatch_PushCircleFilled(Quad_Render_Batch *render_batch,
+                                 v2f origin, v4f colour, f32 radius)
+{
+    return QuadRenderBatch_PushRectFilled(render_batch,
+                                          V2F(origin.x - radius, origin.y - radius),
+                                          V2F(radius * 2.0f, radius * 2.0f),
+                                          colour, radius);
+}
+
+inline Quad *
+QuadRenderBatch_PushCircleOutline(Quad_Render_Batch *render_batch,
+                                  v2f origin, v4f colour, f32 radius, f32 thickness)
+{
+    return QuadRenderBatch_PushRectOutline(render_batch,
+                                           V2F(origin.x - radius, origin.y - radius),
+                                           V2F(radius * 2.0f, radius * 2.0f),
+                                           colour, radius, thickness);
+}
+
+//~ NOTE(christian): immediate rendering
+function b32
+RenderBatch_Init(Render_Batch *render_batch)
+{
+    b32 result = MemoryArena_Init(&render_batch->draw_call_arena, max_draw_calls * sizeof(Render_Draw_Call));
+    result = result && MemoryArena_Init(&render_batch->vertex_arena, max_vertices * sizeof(Render_Per_Vertex_Data));
+    
+    render_batch->draw_calls = (Render_Draw_Call *)render_batch->draw_call_arena.memory;
+    render_batch->vertices = (Render_Per_Vertex_Data *)render_batch->vertex_arena.memory;
+    render_batch->draw_call_count = 0;
+    render_batch->vertex_count = 0;
+    render_batch->first_open_draw_call = 0;
+    render_batch->has_begun = False;
+    render_batch->current_primitive = RenderPrimitiveKind_None;
+    render_batch->current_vertex_array_start = bad_index_u32;
+    Circle_BuildTables();
+    return(result);
+}
+
+function void
+RenderBatch_Reset(Render_Batch *render_batch)
+{
+    MemoryArena_PopToMark(&render_batch->draw_call_arena, 0);
+    MemoryArena_PopToMark(&render_batch->vertex_arena, 0);
+    render_batch->draw_call_count = 0;
+    render_batch->vertex_count = 0;
+    render_batch->first_open_draw_call = 0;
+}
+
+// NOTE(christian): both asserts on a full arena. without asserts they hand back null and leave the
+// counts alone, so the backend never submits slots that weren't written.
+inline Render_Draw_Call *
+RenderBatch_AcquireDrawCall(Render_Batch *render_batch)
+{
+    Render_Draw_Call *result = (Render_Draw_Call *)MemoryArena_PushAligned(&render_batch->draw_call_arena,
+                                                                           sizeof(Render_Draw_Call), 4);
+    Assert(result != null);
+    if (result)
+    {
+        ++render_batch->draw_call_count;
+    }
+    return(result);
+}
+
+inline Render_Per_Vertex_Data *
+RenderBatch_AcquireVertices(Render_Batch *render_batch, u32 count)
+{
+    Render_Per_Vertex_Data *result = (Render_Per_Vertex_Data *)MemoryArena_PushAligned(&render_batch->vertex_arena,
+                                                                                       sizeof(Render_Per_Vertex_Data) * count, 4);
+    Assert(result != null);
+    if (result)
+    {
+        render_batch->vertex_count += count;
+    }
+    return(result);
+}
+
+inline void
+RenderBatch_BeginPrimitive(Render_Batch *render_batch, Render_Primitive_Kind kind, b32 filled)
+{
+    AssertFalse(render_batch->has_begun);
+    render_batch->has_begun = True;
+    render_batch->current_primitive = kind;
+    render_batch->current_vertex_array_start = render_batch->vertex_count;
+    if (kind != RenderPrimitiveKind_Line)
+    {
+        render_batch->filled = filled;
+    }
+    else
+    {
+        render_batch->filled = True;
+    }
+}
+
+inline void
+RenderBatch_End(Render_Batch *render_batch)
+{
+    AssertTrue(render_batch->has_begun);
+    AssertTrue(render_batch->current_primitive != RenderPrimitiveKind_None);
+    AssertTrue(render_batch->current_vertex_array_start != bad_index_u32);
+    
+    render_batch->has_begun = False;
+    
+    // NOTE(christian): did we pushed something?
+    if (render_batch->current_vertex_array_start < render_batch->vertex_count)
+    {
+        // NOTE(christian): then new draw call!
+        // NOTE(christian): quads were expanded into triangles as they were pushed
+        Render_Primitive_Kind kind = render_batch->current_primitive;
+        if (kind == RenderPrimitiveKind_Quad)
+        {
+            kind = RenderPrimitiveKind_Triangle;
+        }
+        
+        // NOTE(christian): everything is stored as a list, so a call that continues the previous one
+        // with the same state is folded into it.
+        Render_Draw_Call *previous = (render_batch->draw_call_count > render_batch->first_open_draw_call) ?
+            (render_batch->draw_calls + render_batch->draw_call_count - 1) : null;
+        if (previous &&
+            (previous->primitive_kind == kind) &&
+            (previous->filled == render_batch->filled) &&
+            (previous->vertex_array_end_index == render_batch->current_vertex_array_start))
+        {
+            previous->vertex_array_end_index = render_batch->vertex_count;
+        }
+        else
+        {
+            Render_Draw_Call *draw_call = RenderBatch_AcquireDrawCall(render_batch);
+            draw_call->primitive_kind = kind;
+            draw_call->vertex_array_base_index = render_batch->current_vertex_array_start;
+            draw_call->vertex_array_end_index = render_batch->vertex_count;
+            draw_call->filled = render_batch->filled;
+        }
+    }
+    
+    render_batch->current_primitive = RenderPrimitiveKind_None;
+    render_batch->current_vertex_array_start = bad_index_u32;
+    render_batch->filled = False;
+}
+
+inline v4f
+RenderBatch_Colour(Render_Batch *render_batch, v4f colour)
+{
+    v4f old = render_batch->current_colour;
+    render_batch->current_colour = colour;
+    return(old);
+}
+
+inline void
+RenderBatch_Vertex(Render_Batch *render_batch, v2f v)
+{
+    AssertTrue(render_batch->has_begun);
+    u32 pushed_in_primitive = render_batch->vertex_count - render_batch->current_vertex_array_start;
+    
+    switch (render_batch->current_primitive)
+    {
+        case RenderPrimitiveKind_Line:
+        {
+            // NOTE(christian): lines are strips to the caller but a list to the gpu. repeat the previous
+            // vertex so this one starts a new segment.
+            if (pushed_in_primitive >= 2)
+            {
+                Render_Per_Vertex_Data *vertices = RenderBatch_AcquireVertices(render_batch, 2);
+                vertices[0] = vertices[-1];
+                vertices[1].vertex = v;
+                vertices[1].colour = render_batch->current_colour;
+                return;
+            }
+        } break;
+        
+        case RenderPrimitiveKind_Quad:
+        {
+            // NOTE(christian): strip order 0 1 2 3 -> triangles (0 1 2) (2 1 3)
+            if ((pushed_in_primitive % 6) == 3)
+            {
+                Render_Per_Vertex_Data *vertices = RenderBatch_AcquireVertices(render_batch, 3);
+                vertices[0] = vertices[-1];
+                vertices[1] = vertices[-2];
+                vertices[2].vertex = v;
+                vertices[2].colour = render_batch->current_colour;
+                return;
+            }
+        } break;
+        
+        default: break;
+    }
+    
+    Render_Per_Vertex_Data *vertex = RenderBatch_AcquireVertices(render_batch, 1);
+    vertex->vertex = v;
+    vertex->colour = render_batch->current_colour;
+}
+
+function void
+RenderBatch_PushLine(Render_Batch *render_batch, v2f start, v2f end, v4f colour)
+{
+    RenderBatch_BeginPrimitive(render_batch, RenderPrimitiveKind_Line, True);
+    v4f old = RenderBatch_Colour(render_batch, colour);
+    RenderBatch_Vertex(render_batch, start);
+    RenderBatch_Vertex(render_batch, end);
+    RenderBatch_Colour(render_batch, old);
+    RenderBatch_End(render_batch);
+}
+
+//~ NOTE(christian): circle tessellation cache
+global f32 g_circle_cos_tables[circle_table_count][circle_table_stride];
+global f32 g_circle_sin_tables[circle_table_count][circle_table_stride];
+global b32 g_circle_tables_built;
+
+function void
+Circle_BuildTables(void)
+{
+    if (!g_circle_tables_built)
+    {
+        for (u32 table_index = 0; table_index < circle_table_count; ++table_index)
+        {
+            u32 segment_count = circle_min_segments + table_index * 4;
+            f64 step = 6.283185307179586 / (f64)segment_count;
+            for (u32 point_index = 0; point_index < circle_table_stride; ++point_index)
+            {
+                // NOTE(christian): computed from the index in double so the second turn matches the first exactly.
+                u32 wrapped_index = point_index % segment_count;
+                g_circle_cos_tables[table_index][point_index] = (f32)cos(step * (f64)wrapped_index);
+                g_circle_sin_tables[table_index][point_index] = (f32)sin(step * (f64)wrapped_index);
+            }
+        }
+        
+        g_circle_tables_built = True;
+    }
+}
+
+inline u32
+Circle_SegmentCountForRadius(f32 radius)
+{
+    // NOTE(christian): keep the gap between chord and arc under circle_max_error pixels.
+    // n = pi / acos(1 - e/r), which is about pi * sqrt(r / 2e).
+    f32 segments = 3.14159265f * sqrtf(AbsoluteValueF32(radius) * (1.0f / (2.0f * circle_max_error)));
+    u32 result = ((u32)segments + 3) & ~3u;
+    result = Max(result, circle_min_segments);
+    result = Min(result, circle_max_segments);
+    return(result);
+}
+
+inline Circle_Table
+Circle_GetTable(u32 segment_count)
+{
+    u32 table_index = (segment_count - circle_min_segments) / 4;
+    Circle_Table result;
+    result.segment_count = segment_count;
+    result.cos = g_circle_cos_tables[table_index];
+    result.sin = g_circle_sin_tables[table_index];
+    return(result);
+}
+
+// NOTE(christian): out must have room for count rounded up to lane_width. the tables are padded for the same reason.
+function void
+Circle_TransformTable(Circle_Table table, u32 first, u32 count, v2f origin, f32 radius, v2f *out)
+{
+    f32 *cos_table = table.cos + first;
+    f32 *sin_table = table.sin + first;
+    
+    lane_v2f origin_wide;
+    origin_wide.x = LaneF32_Set1(origin.x);
+    origin_wide.y = LaneF32_Set1(origin.y);
+    lane_f32 radius_wide = LaneF32_Set1(radius);
+    for (u32 point_index = 0; point_index < count; point_index += lane_width)
+    {
+        lane_v2f unit = LaneV2F_Load(cos_table + point_index, sin_table + point_index);
+        LaneV2F_StoreInterleaved(out + point_index, LaneV2F_MulAdd(unit, radius_wide, origin_wide));
+    }
+}
+
+function void
+RenderBatch_PushCircleOutline(Render_Batch *render_batch, v2f origin, v4f colour, f32 radius)
+{
+    Circle_Table table = Circle_GetTable(Circle_SegmentCountForRadius(radius));
+    u32 segment_count = table.segment_count;
+    
+    v2f points[circle_max_segments + lane_width];
+    Circle_TransformTable(table, 0, segment_count + 1, origin, radius, points);
+    
+    RenderBatch_BeginPrimitive(render_batch, RenderPrimitiveKind_Line, True);
+    Render_Per_Vertex_Data *vertices = RenderBatch_AcquireVertices(render_batch, segment_count * 2);
+    for (u32 segment_index = 0; segment_index < segment_count; ++segment_index)
+    {
+        vertices[0].vertex = points[segment_index];
+        vertices[0].colour = colour;
+        vertices[1].vertex = points[segment_index + 1];
+        vertices[1].colour = colour;
+        vertices += 2;
+    }
+    RenderBatch_End(render_batch);
+}
+
+function void
+RenderBatch_PushCircleFilled(Render_Batch *render_batch, v2f origin, v4f colour, f32 radius)
+{
+    Circle_Table table = Circle_GetTable(Circle_SegmentCountForRadius(radius));
+    u32 segment_count = table.segment_count;
+    
+    v2f points[circle_max_segments + lane_width];
+    Circle_TransformTable(table, 0, segment_count + 1, origin, radius, points);
+    
+    RenderBatch_BeginPrimitive(render_batch, RenderPrimitiveKind_Triangle, True);
+    Render_Per_Vertex_Data *vertices = RenderBatch_AcquireVertices(render_batch, segment_count * 3);
+    for (u32 segment_index = 0; segment_index < segment_count; ++segment_index)
+    {
+        vertices[0].vertex = origin;
+        vertices[0].colour = colour;
+        vertices[1].vertex = points[segment_index];
+        vertices[1].colour = colour;
+        vertices[2].vertex = points[segment_index + 1];
+        vertices[2].colour = colour;
+        vertices += 3;
+    }
+    RenderBatch_End(render_batch);
+}
+
+function void
+RenderBatch_PushArcOutline(Render_Batch *render_batch, v2f origin, v4f colour, f32 radius,
+                           f32 start_radians, f32 end_radians)
+{
+    if (end_radians < start_radians)
+    {
+        f32 temp = start_radians;
+        start_radians = end_radians;
+        end_radians = temp;
+    }
+    
+    f32 sweep = Min(end_radians - start_radians, two_pi_F32);
+    if (sweep > 0.0f)
+    {
+        Circle_Table table = Circle_GetTable(Circle_SegmentCountForRadius(radius));
+        u32 segment_count = table.segment_count;
+        f32 step = two_pi_F32 / (f32)segment_count;
+        
+        start_radians = fmodf(start_radians, two_pi_F32);
+        if (start_radians < 0.0f)
+        {
+            start_radians += two_pi_F32;
+        }
+        end_radians = start_radians + sweep;
+        
+        // NOTE(christian): exact end points, cached points strictly between them.
+        u32 first = (u32)(start_radians / step) + 1;
+        u32 last = (u32)ceilf(end_radians / step);
+        last = Min(last, segment_count * 2);
+        u32 inner_count = (last > first) ? (last - first) : 0;
+        
+        v2f points[circle_max_segments * 2 + 8];
+        points[0] = V2F(origin.x + radius * cosf(start_radians), origin.y + radius * sinf(start_radians));
+        Circle_TransformTable(table, first, inner_count, origin, radius, points + 1);
+        points[inner_count + 1] = V2F(origin.x + radius * cosf(end_radians), origin.y + radius * sinf(end_radians));
+        
+        u32 line_count = inner_count + 1;
+        RenderBatch_BeginPrimitive(render_batch, RenderPrimitiveKind_Line, True);
+        Render_Per_Vertex_Data *vertices = RenderBatch_AcquireVertices(render_batch, line_count * 2);
+        for (u32 line_index = 0; line_index < line_count; ++line_index)
+        {
+            vertices[0].vertex = points[line_index];
+            vertices[0].colour = colour;
+            vertices[1].vertex = points[line_index + 1];
+            vertices[1].colour = colour;
+            vertices += 2;
+        }
+        RenderBatch_End(render_batch);
+    }
+}
+
+function void
+RenderBatch_PushRing(Render_Batch *render_batch, v2f origin, v4f colour,
+                     f32 inner_radius, f32 outer_radius)
+{
+    Circle_Table table = Circle_GetTable(Circle_SegmentCountForRadius(outer_radius));
+    u32 segment_count = table.segment_count;
+    
+    v2f inner_points[circle_max_segments + lane_width];
+    v2f outer_points[circle_max_segments + lane_width];
+    Circle_TransformTable(table, 0, segment_count + 1, origin, inner_radius, inner_points);
+    Circle_TransformTable(table, 0, segment_count + 1, origin, outer_radius, outer_points);
+    
+    RenderBatch_BeginPrimitive(render_batch, RenderPrimitiveKind_Triangle, True);
+    Render_Per_Vertex_Data *vertices = RenderBatch_AcquireVertices(render_batch, segment_count * 6);
+    for (u32 segment_index = 0; segment_index < segment_count; ++segment_index)
+    {
+        v2f inner_a = inner_points[segment_index];
+        v2f inner_b = inner_points[segment_index + 1];
+        v2f outer_a = outer_points[segment_index];
+        v2f outer_b = outer_points[segment_index + 1];
+        
+        vertices[0].vertex = inner_a;
+        vertices[1].vertex = outer_a;
+        vertices[2].vertex = outer_b;
+        vertices[3].vertex = inner_a;
+        vertices[4].vertex = outer_b;
+        vertices[5].vertex = inner_b;
+        for (u32 vertex_index = 0; vertex_index < 6; ++vertex_index)
+        {
+            vertices[vertex_index].colour = colour;
+        }
+        vertices += 6;
+    }
+    RenderBatch_End(render_batch);
+}
+
+//~ NOTE(christian): batch shards
+function b32
+RenderShards_Init(Render_Shards *shards, Memory_Arena *arena, Job_System *jobs)
+{
+    b32 result = True;
+    u32 shard_count = jobs->thread_count;
+    shards->jobs = jobs;
+    shards->shard_count = shard_count;
+    shards->shards = MemoryArena_PushArrayZero(arena, Render_Shard, shard_count);
+    for (u32 shard_index = 0; result && (shard_index < shard_count); ++shard_index)
+    {
+        Render_Shard *shard = shards->shards + shard_index;
+        result = QuadRenderBatch_Init(&shard->quads) && RenderBatch_Init(&shard->immediate);
+        shard->segments = MemoryArena_PushArray(arena, Render_Segment, render_shard_max_segments);
+        result = result && (shard->segments != null);
+    }
+    return(result);
+}
+
+function void
+RenderShards_Reset(Render_Shards *shards)
+{
+    for (u32 shard_index = 0; shard_index < shards->shard_count; ++shard_index)
+    {
+        Render_Shard *shard = shards->shards + shard_index;
+        QuadRenderBatch_Reset(&shard->quads);
+        RenderBatch_Reset(&shard->immediate);
+        shard->segment_count = 0;
+    }
+}
+
+inline Render_Shard *
+RenderShards_BeginSegment(Render_Shards *shards, u32 layer, u32 submission_index)
+{
+    u32 shard_index = JobSystem_GetThreadIndex();
+    Assert(shard_index < shards->shard_count);
+    
+    Render_Shard *result = shards->shards + shard_index;
+    AssertFalse(result->segment_open);
+    result->segment_open = True;
+    
+    // NOTE(christian): once the table is full the last segment just grows. its geometry still
+    // gets merged, under the key it started with.
+    if (result->segment_count < render_shard_max_segments)
+    {
+        Render_Segment *segment = result->segments + result->segment_count++;
+        segment->sort_key = RenderShards_SortKey(layer, submission_index);
+        segment->shard_index = shard_index;
+        segment->first_chunk = result->quads.current_chunk;
+        segment->first_quad_in_chunk = result->quads.current_chunk->quads_drawn;
+        segment->first_quad = result->quads.quads_drawn;
+        segment->first_draw_call = result->immediate.draw_call_count;
+    }
+    
+    // NOTE(christian): keep this segment's first primitive from folding into the last one's draw call.
+    result->immediate.first_open_draw_call = result->immediate.draw_call_count;
+    return(result);
+}
+
+inline void
+RenderShards_EndSegment(Render_Shard *shard)
+{
+    AssertTrue(shard->segment_open);
+    shard->segment_open = False;
+    
+    Render_Segment *segment = shard->segments + shard->segment_count - 1;
+    segment->one_past_last_quad = shard->quads.quads_drawn;
+    segment->one_past_last_draw_call = shard->immediate.draw_call_count;
+}
+
+function int
+RenderShards_CompareSegments(const void *a, const void *b)
+{
+    const Render_Segment *segment_a = *(const Render_Segment **)a;
+    const Render_Segment *segment_b = *(const Render_Segment **)b;
+    int result = (segment_a->sort_key > segment_b->sort_key) - (segment_a->sort_key < segment_b->sort_key);
+    if (!result)
+    {
+        // NOTE(christian): equal keys stay in shard then emission order, which is at least repeatable
+        // for a given schedule. callers that care give every segment its own key.
+        result = (segment_a->shard_index > segment_b->shard_index) - (segment_a->shard_index < segment_b->shard_index);
+        result = result ? result : (segment_a > segment_b) - (segment_a < segment_b);
+    }
+    return(result);
+}
+
+typedef struct Render_Merge_Copy
+{
+    Render_Segment *segment;
+    Quad_Render_Chunk *dest_chunk;
+    u32 dest_quad_in_chunk;
+    u32 quad_count;
+    u32 dest_first_vertex;
+    u32 source_first_vertex;
+    u32 vertex_count;
+} Render_Merge_Copy;
+
+typedef struct Render_Merge_Job
+{
+    Render_Shards *shards;
+    Render_Merge_Copy *copies;
+    Render_Batch *render_batch;
+} Render_Merge_Job;
+
+function void
+RenderShards_MergeCopyJob(void *data, u32 first, u32 one_past_last)
+{
+    Render_Merge_Job *job = (Render_Merge_Job *)data;
+    for (u32 copy_index = first; copy_index < one_past_last; ++copy_index)
+    {
+        Render_Merge_Copy *copy = job->copies + copy_index;
+        Render_Segment *segment = copy->segment;
+        Render_Shard *shard = job->shards->shards + segment->shard_index;
+        QuadRenderChunk_Copy(copy->dest_chunk, copy->dest_quad_in_chunk,
+                             segment->first_chunk, segment->first_quad_in_chunk, copy->quad_count);
+        MemoryCopy(job->render_batch->vertices + copy->dest_first_vertex, shard->immediate.vertices + copy->source_first_vertex,
+                   sizeof(Render_Per_Vertex_Data) * copy->vertex_count);
+    }
+}
+
+// NOTE(christian): appends every segment, in key order, after whatever the batches already hold.
+// destinations are handed out serially, which is cheap, then the copying fans out over the jobs.
+function void
+RenderShards_Merge(Render_Shards *shards, Quad_Render_Batch *quad_render_batch, Render_Batch *render_batch)
+{
+    Temporary_Memory scratch = Scratch_Begin(null, 0);
+    
+    u32 segment_count = 0;
+    for (u32 shard_index = 0; shard_index < shards->shard_count; ++shard_index)
+    {
+        AssertFalse(shards->shards[shard_index].segment_open);
+        segment_count += shards->shards[shard_index].segment_count;
+    }
+    
+    Render_Segment **sorted = MemoryArena_PushArray(scratch.arena, Render_Segment *, segment_count);
+    u32 sorted_count = 0;
+    for (u32 shard_index = 0; shard_index < shards->shard_count; ++shard_index)
+    {
+        Render_Shard *shard = shards->shards + shard_index;
+        for (u32 segment_index = 0; segment_index < shard->segment_count; ++segment_index)
+        {
+            sorted[sorted_count++] = shard->segments + segment_index;
+        }
+    }
+    qsort(sorted, segment_count, sizeof(Render_Segment *), &RenderShards_CompareSegments);
+    
+    ProfileBegin("merge copy");
+    Render_Merge_Copy *copies = MemoryArena_PushArray(scratch.arena, Render_Merge_Copy, segment_count);
+    for (u32 sorted_index = 0; sorted_index < segment_count; ++sorted_index)
+    {
+        Render_Segment *segment = sorted[sorted_index];
+        Render_Shard *shard = shards->shards + segment->shard_index;
+        Render_Merge_Copy *copy = copies + sorted_index;
+        copy->segment = segment;
+        copy->quad_count = QuadRenderBatch_Reserve(quad_render_batch, segment->one_past_last_quad - segment->first_quad,
+                                                   &copy->dest_chunk, &copy->dest_quad_in_chunk);
+        copy->vertex_count = 0;
+        copy->source_first_vertex = 0;
+        copy->dest_first_vertex = 0;
+        
+        // NOTE(christian): a segment's draw calls cover one contiguous vertex range. it moves as a
+        // block, the calls get rebased and fold into the previous one where RenderBatch_End would have.
+        if (segment->first_draw_call < segment->one_past_last_draw_call)
+        {
+            Render_Draw_Call *draw_calls = shard->immediate.draw_calls;
+            copy->source_first_vertex = draw_calls[segment->first_draw_call].vertex_array_base_index;
+            copy->vertex_count = draw_calls[segment->one_past_last_draw_call - 1].vertex_array_end_index - copy->source_first_vertex;
+            copy->dest_first_vertex = render_batch->vertex_count;
+            RenderBatch_AcquireVertices(render_batch, copy->vertex_count);
+            
+            for (u32 draw_call_index = segment->first_draw_call; draw_call_index < segment->one_past_last_draw_call; ++draw_call_index)
+            {
+                Render_Draw_Call *source = draw_calls + draw_call_index;
+                u32 base_index = source->vertex_array_base_index - copy->source_first_vertex + copy->dest_first_vertex;
+                u32 end_index = source->vertex_array_end_index - copy->source_first_vertex + copy->dest_first_vertex;
+                
+                Render_Draw_Call *previous = (render_batch->draw_call_count > render_batch->first_open_draw_call) ?
+                    (render_batch->draw_calls + render_batch->draw_call_count - 1) : null;
+                if (previous &&
+                    (previous->primitive_kind == source->primitive_kind) &&
+                    (previous->filled == source->filled) &&
+                    (previous->vertex_array_end_index == base_index))
+                {
+                    previous->vertex_array_end_index = end_index;
+                }
+                else
+                {
+                    Render_Draw_Call *draw_call = RenderBatch_AcquireDrawCall(render_batch);
+                    *draw_call = *source;
+                    draw_call->vertex_array_base_index = base_index;
+                    draw_call->vertex_array_end_index = end_index;
+                }
+            }
+        }
+    }
+    
+    Render_Merge_Job merge_job = { shards, copies, render_batch };
+    Job_Counter merge_counter = {0};
+    JobSystem_ParallelFor(shards->jobs, &merge_counter, segment_count, 1, &RenderShards_MergeCopyJob, &merge_job);
+    JobSystem_Wait(shards->jobs, &merge_counter);
+    ProfileEnd("merge copy");
+    
+    Scratch_End(scratch);
+}
+
+//~ NOTE(christian): render stats
+function void
+RenderStats_CollectBatches(Render_Stats *stats, Quad_Render_Batch *quad_render_batch,
+                           Render_Batch *render_batch, v2f target_dims)
+{
+    stats->quads = quad_render_batch->quads_drawn;
+    stats->quad_capacity = quad_render_batch->chunk_count * quad_render_chunk_capacity;
+    stats->vertices = render_batch->vertex_count;
+    stats->vertex_capacity = (u32)(render_batch->vertex_arena.commit_ptr / sizeof(Render_Per_Vertex_Data));
+    stats->draw_calls = render_batch->draw_call_count;
+    
+    stats->draw_call_state_changes = 0;
+    for (u32 draw_call_index = 1; draw_call_index < render_batch->draw_call_count; ++draw_call_index)
+    {
+        Render_Draw_Call *previous = render_batch->draw_calls + draw_call_index - 1;
+        Render_Draw_Call *draw_call = render_batch->draw_calls + draw_call_index;
+        if ((previous->primitive_kind != draw_call->primitive_kind) || (previous->filled != draw_call->filled))
+        {
+            ++stats->draw_call_state_changes;
+        }
+    }
+    
+    f64 covered_pixels = 0.0;
+    for (Quad_Render_Chunk *chunk = quad_render_batch->first_chunk;
+         chunk && chunk->quads_drawn;
+         chunk = chunk->next)
+    {
+        for (u32 quad_index = 0; quad_index < chunk->quads_drawn; ++quad_index)
+        {
+            v2f min;
+            v2f max;
+            Quad_GetBounds(chunk->quads + quad_index, &min, &max);
+            f32 width = Min(max.x, target_dims.x) - Max(min.x, 0.0f);
+            f32 height = Min(max.y, target_dims.y) - Max(min.y, 0.0f);
+            if ((width > 0.0f) && (height > 0.0f))
+            {
+                covered_pixels += (f64)(width * height);
+            }
+        }
+    }
+    stats->covered_pixels = (u64)covered_pixels;
+    
+    f32 target_pixels = target_dims.x * target_dims.y;
+    stats->overdraw = (target_pixels > 0.0f) ? ((f32)stats->covered_pixels / target_pixels) : 0.0f;
+}
+
+function void
+RenderStats_Record(Render_Stats_History *history, Render_Stats *stats)
+{
+    history->frames[history->frame_count % render_stats_history_count] = *stats;
+    ++history->frame_count;
+}
+
+#define render_stats_plot_height 24.0f
+#define render_stats_plot_gap 4.0f
+// NOTE(christian): room right of each plot for its label, at text scale 1.
+#define render_stats_label_gap 4.0f
+#define render_stats_label_glyphs 20
+
+typedef enum Render_Stats_Plot
+{
+    RenderStatsPlot_FrameMs,
+    RenderStatsPlot_UpdateMs,
+    RenderStatsPlot_RenderMs,
+    RenderStatsPlot_Draws,
+    RenderStatsPlot_UploadBytes,
+    RenderStatsPlot_Quads,
+    RenderStatsPlot_Overdraw,
+    RenderStatsPlot_Count,
+} Render_Stats_Plot;
+
+// NOTE(christian): the bar value and the reference line of a plot. a zero reference draws no line.
+function f32
+RenderStats_PlotValue(Render_Stats *stats, Render_Stats_Plot plot, f32 *reference)
+{
+    f32 result = 0.0f;
+    *reference = 0.0f;
+    switch (plot)
+    {
+        case RenderStatsPlot_FrameMs:
+        {
+            result = stats->frame_ms;
+        } break;
+        
+        case RenderStatsPlot_UpdateMs:
+        {
+            result = stats->update_ms;
+        } break;
+        
+        case RenderStatsPlot_RenderMs:
+        {
+            result = stats->render_ms;
+        } break;
+        
+        case RenderStatsPlot_Draws:
+        {
+            // NOTE(christian): backend calls when there is a backend that counts them, the batch's otherwise.
+            u32 draws = stats->draw_count + stats->draw_instanced_count;
+            result = (f32)(draws ? draws : stats->draw_calls);
+        } break;
+        
+        case RenderStatsPlot_UploadBytes:
+        {
+            result = (f32)stats->map_bytes;
+        } break;
+        
+        case RenderStatsPlot_Quads:
+        {
+            result = (f32)stats->quads;
+            *reference = (f32)stats->quad_capacity;
+        } break;
+        
+        case RenderStatsPlot_Overdraw:
+        {
+            result = stats->overdraw;
+            *reference = 1.0f;
+        } break;
+        
+        default: break;
+    }
+    return(result);
+}
+
+// NOTE(christian): the plot's name and its value for one frame, written into buffer.
+function String_Const_U8
+RenderStats_PlotLabel(Render_Stats *stats, Render_Stats_Plot plot, char *buffer, u32 buffer_size)
+{
+    f32 reference;
+    f32 value = RenderStats_PlotValue(stats, plot, &reference);
+    s32 length = 0;
+    switch (plot)
+    {
+        case RenderStatsPlot_FrameMs: { length = snprintf(buffer, buffer_size, "frame %.2f ms", value); } break;
+        case RenderStatsPlot_UpdateMs: { length = snprintf(buffer, buffer_size, "update %.2f ms", value); } break;
+        case RenderStatsPlot_RenderMs: { length = snprintf(buffer, buffer_size, "render %.2f ms", value); } break;
+        case RenderStatsPlot_Draws: { length = snprintf(buffer, buffer_size, "draws %.0f", value); } break;
+        case RenderStatsPlot_UploadBytes: { length = snprintf(buffer, buffer_size, "upload %.1f KB", value / 1024.0f); } break;
+        case RenderStatsPlot_Quads: { length = snprintf(buffer, buffer_size, "quads %.0f/%.0f", value, reference); } break;
+        case RenderStatsPlot_Overdraw: { length = snprintf(buffer, buffer_size, "overdraw %.2f", value); } break;
+        default: break;
+    }
+    String_Const_U8 result = { (u8 *)buffer, (u32)Clamp(0, length, (s32)buffer_size - 1) };
+    return(result);
+}
+
+// NOTE(christian): one bar plot per counter, stacked down from origin and each scaled to its own
+// maximum over the history: frame, update and render time, draws, upload bytes, quads against
+// capacity, overdraw against one full screen. atlas may be null, the plots then go unlabelled.
+function void
+RenderStats_DrawOverlay(Render_Stats_History *history, Render_Shards *shards, Glyph_Atlas *atlas, v2f origin)
+{
+    local v4f plot_colours[RenderStatsPlot_Count] =
+    {
+        { 1.0f, 1.0f, 1.0f, 0.9f },
+        { 0.75f, 0.55f, 1.0f, 0.9f },
+        { 1.0f, 0.9f, 0.3f, 0.9f },
+        { 0.35f, 0.75f, 1.0f, 0.9f },
+        { 1.0f, 0.65f, 0.25f, 0.9f },
+        { 0.45f, 1.0f, 0.45f, 0.9f },
+        { 1.0f, 0.35f, 0.45f, 0.9f },
+    };
+    v4f background_colour = RGBA(0.0f, 0.0f, 0.0f, 0.6f);
+    v4f reference_colour = RGBA(1.0f, 1.0f, 1.0f, 0.5f);
+    
+    u32 frame_count = (u32)Min(history->frame_count, render_stats_history_count);
+    u64 first_frame = history->frame_count - frame_count;
+    Render_Stats *latest = frame_count ? (history->frames + ((history->frame_count - 1) % render_stats_history_count)) : null;
+    f32 background_width = (f32)render_stats_history_count;
+    if (atlas)
+    {
+        background_width += 2.0f * render_stats_label_gap + (f32)(render_stats_label_glyphs * text_glyph_advance);
+    }
+    
+    Render_Shard *shard = RenderShards_BeginSegment(shards, render_stats_overlay_layer, 0);
+    for (u32 plot = 0; plot < RenderStatsPlot_Count; ++plot)
+    {
+        v2f plot_origin = V2F(origin.x, origin.y + (f32)plot * (render_stats_plot_height + render_stats_plot_gap));
+        QuadRenderBatch_PushRectFilled(&shard->quads, plot_origin, V2F(background_width, render_stats_plot_height),
+                                       background_colour, 0.0f);
+        
+        if (atlas && latest)
+        {
+            char label_text[64];
+            String_Const_U8 label = RenderStats_PlotLabel(latest, (Render_Stats_Plot)plot, label_text, sizeof(label_text));
+            v2f label_origin = V2F(plot_origin.x + (f32)render_stats_history_count + render_stats_label_gap,
+                                   plot_origin.y + (f32)((s32)(render_stats_plot_height - glyph_bitmap_height) / 2));
+            QuadRenderBatch_PushText(&shard->quads, atlas, label_origin, plot_colours[plot], 1.0f, label);
+        }
+        
+        f32 scale = 0.0f;
+        f32 reference = 0.0f;
+        for (u32 frame_index = 0; frame_index < frame_count; ++frame_index)
+        {
+            Render_Stats *stats = history->frames + ((first_frame + frame_index) % render_stats_history_count);
+            f32 frame_reference;
+            scale = Max(scale, RenderStats_PlotValue(stats, (Render_Stats_Plot)plot, &frame_reference));
+            scale = Max(scale, frame_reference);
+            reference = frame_reference;
+        }
+        
+        if (scale <= 0.0f)
+        {
+            continue;
+        }
+        
+        f32 pixels_per_unit = render_stats_plot_height / scale;
+        f32 plot_bottom = plot_origin.y + render_stats_plot_height;
+        for (u32 frame_index = 0; frame_index < frame_count; ++frame_index)
+        {
+            Render_Stats *stats = history->frames + ((first_frame + frame_index) % render_stats_history_count);
+            f32 frame_reference;
+            f32 bar_height = RenderStats_PlotValue(stats, (Render_Stats_Plot)plot, &frame_reference) * pixels_per_unit;
+            if (bar_height > 0.0f)
+            {
+                QuadRenderBatch_PushRectFilled(&shard->quads, V2F(plot_origin.x + (f32)frame_index, plot_bottom - bar_height),
+                                               V2F(1.0f, bar_height), plot_colours[plot], 0.0f);
+            }
+        }
+        
+        // NOTE(christian): the latest frame's reference, capacity can grow during the run.
+        if (reference > 0.0f)
+        {
+            QuadRenderBatch_PushRectFilled(&shard->quads, V2F(plot_origin.x, plot_bottom - reference * pixels_per_unit),
+                                           V2F((f32)render_stats_history_count, 1.0f), reference_colour, 0.0f);
+        }
+    }
+    RenderShards_EndSegment(shard);
+}
+
+function void
+RenderStats_WriteCSVHeader(FILE *file)
+{
+    fprintf(file, "frame,draws,draws_instanced,topology_changes,rasterizer_changes,maps,map_bytes,"
+            "quad_buffer_capacity,vertex_buffer_capacity,quads,quad_capacity,vertices,vertex_capacity,"
+            "draw_calls,draw_call_state_changes,covered_pixels,overdraw,frame_ms,update_ms,render_ms\n");
+}
+
+function void
+RenderStats_WriteCSVRow(FILE *file, u64 frame_index, Render_Stats *stats)
+{
+    fprintf(file, "%llu,%u,%u,%u,%u,%u,%llu,%u,%u,%u,%u,%u,%u,%u,%u,%llu,%.4f,%.4f,%.4f,%.4f\n",
+            (unsigned long long)frame_index, stats->draw_count, stats->draw_instanced_count,
+            stats->topology_changes, stats->rasterizer_changes, stats->map_count,
+            (unsigned long long)stats->map_bytes, stats->quad_buffer_capacity, stats->vertex_buffer_capacity,
+            stats->quads, stats->quad_capacity, stats->vertices, stats->vertex_capacity,
+            stats->draw_calls, stats->draw_call_state_changes,
+            (unsigned long long)stats->covered_pixels, stats->overdraw,
+            stats->frame_ms, stats->update_ms, stats->render_ms);
+}
@@ -0,0 +1,288 @@
+/* date = October 17th 2026 9:40 am */
+
+#ifndef BP_RENDER_H
+#define BP_RENDER_H
+
+// NOTE(christian): size of the back buffer every backend renders into.
+#define render_target_width 480
+#define render_target_height 270
+
+//~ NOTE(christian): quad packing
+// NOTE(christian): a Quad in floats. only the renderers' setup and the push helpers go through this,
+// everything in between moves the packed 32 bytes around. see Quad in bp_base_math.h for the layout.
+typedef struct Quad_Unpacked
+{
+    v2f origin;
+    v2f x_axis;
+    v2f y_axis;
+    v4f colours[4];
+    f32 side_roundness;
+    f32 side_thickness;
+    u32 flags;
+    v2f uv_min;
+    v2f uv_max;
+} Quad_Unpacked;
+
+// NOTE(christian): every pack saturates to its field's range and rounds to the nearest step.
+inline u32 QuadPack_V2F(v2f a);
+inline u32 QuadPack_Colour(v4f colour);
+inline u32 QuadPack_UV(v2f uv);
+inline u32 QuadPack_Style(f32 side_roundness, f32 side_thickness, u32 flags);
+inline v2f QuadUnpack_V2F(u32 packed);
+inline v4f QuadUnpack_Colour(u32 packed);
+inline v2f QuadUnpack_UV(u32 packed);
+function Quad_Unpacked Quad_Unpack(Quad *quad);
+inline void Quad_GetBounds(Quad *quad, v2f *out_min, v2f *out_max);
+
+// NOTE(christian): lane_width quads' fields at a time, same rounding as the scalar packs.
+inline lane_u32 QuadPack_LaneV2F(lane_f32 x, lane_f32 y);
+inline lane_u32 QuadPack_LaneColour(lane_f32 r, lane_f32 g, lane_f32 b, lane_f32 a);
+inline lane_u32 QuadPack_LaneStyle(lane_f32 side_roundness, lane_f32 side_thickness, u32 flags);
+
+//~ NOTE(christian): quad rendering
+// NOTE(christian): quads are pushed into a chain of fixed size chunks carved out of the
+// batch's own arena. chunks are kept across frames and only handed out again on reset,
+// so the chain grows to the biggest scene we have seen and is bounded by the reserve.
+#define quad_render_chunk_capacity 4096
+#define quad_render_batch_reserve GB(2)
+
+typedef struct Quad_Render_Chunk
+{
+    struct Quad_Render_Chunk *next;
+    u32 quads_drawn;
+    Quad quads[quad_render_chunk_capacity];
+} Quad_Render_Chunk;
+
+typedef struct Quad_Render_Batch
+{
+    Memory_Arena chunk_arena;
+    Quad_Render_Chunk *first_chunk;
+    Quad_Render_Chunk *current_chunk;
+    u32 chunk_count;
+    u32 quads_drawn;
+    
+    // NOTE(christian): handed out once the reserve is exhausted so pushes never write out of bounds. never drawn.
+    Quad overflow_quad;
+} Quad_Render_Batch;
+
+function b32 QuadRenderBatch_Init(Quad_Render_Batch *render_batch);
+function void QuadRenderBatch_Reset(Quad_Render_Batch *render_batch);
+inline Quad *QuadRenderBatch_Acquire(Quad_Render_Batch *render_batch);
+function u32 QuadRenderBatch_Reserve(Quad_Render_Batch *render_batch, u32 count, Quad_Render_Chunk **first_chunk, u32 *first_index);
+function Quad_Render_Chunk *QuadRenderChunk_Seek(Quad_Render_Chunk *chunk, u32 index, u32 offset, u32 *out_index);
+inline Quad *QuadRenderBatch_Push(Quad_Render_Batch *render_batch, v2f origin, v2f x_axis, v2f y_axis,
+                                  v4f colour_tl, v4f colour_tr, v4f colour_br, v4f colour_bl, f32 side_roundness,
+                                  f32 side_thickness);
+inline Quad *QuadRenderBatch_PushRectFilled(Quad_Render_Batch *render_batch, v2f origin, v2f dims, v4f colour, f32 roundness);
+inline Quad *QuadRenderBatch_PushRectOutline(Quad_Render_Batch *render_batch, v2f origin, v2f dims, v4f colour, f32 roundness, f32 thickness);
+inline Quad *QuadRenderBatch_PushCircleFilled(Quad_Render_Batch *render_batch, v2f origin, v4f colour, f32 radius);
+inline Quad *QuadRenderBatch_PushCircleOutline(Quad_Render_Batch *render_batch, v2f origin, v4f colour, f32 radius, f32 thickness);
+
+//~ NOTE(christian): immediate rendering
+// TODO(christian): immediate mode rending api.
+/*
+we cannot limit ourselves with quads. we want to draw convex / nonconvex polygons,
+lines, triangles, and so on. We might leave the quad rendering batch for the UI system.
+knowing this, we do instanced rendering for quad rendering, and issue draw calls for
+immediate rendering
+
+// we also cannot just say "draw line" or "draw triangle" becasue how would d3d11 interpret
+that? we need some sort of "draw call" struct that records what of primitive we have drawn.
+and thus we input the number of vertices used to d3d. we also might want an index to the vertices
+array in render_batch
+*/
+
+typedef enum Render_Primitive_Kind
+{
+    RenderPrimitiveKind_None,
+    RenderPrimitiveKind_Point, // 1 vertices. D3D11_PRIMITIVE_TOPOLOGY_POINTLIST.
+    RenderPrimitiveKind_Line, // pushed as a strip, stored as D3D11_PRIMITIVE_TOPOLOGY_LINELIST.
+    RenderPrimitiveKind_Triangle, // 3 vertices. D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST
+    RenderPrimitiveKind_Quad, // 4 vertices pushed in strip order, stored as two triangles.
+} Render_Primitive_Kind;
+
+typedef struct Render_Per_Vertex_Data
+{
+    v2f vertex;
+    v4f colour;
+} Render_Per_Vertex_Data;
+
+typedef struct Render_Draw_Call
+{
+    Render_Primitive_Kind primitive_kind;
+    u32 vertex_array_base_index;
+    u32 vertex_array_end_index;
+    b32 filled;
+} Render_Draw_Call;
+
+// NOTE(christian): draw calls and vertices each get their own arena so the arrays stay contiguous
+// and grow by committing pages. these are reserve limits, not what we pay for.
+#define max_draw_calls (1024*1024)
+#define max_vertices (16*1024*1024)
+typedef struct Render_Batch
+{
+    Memory_Arena draw_call_arena;
+    Render_Draw_Call *draw_calls;
+    u32 draw_call_count;
+    
+    Memory_Arena vertex_arena;
+    Render_Per_Vertex_Data *vertices;
+    u32 vertex_count;
+    
+    // NOTE(christian): draw calls below this index are closed, new primitives never fold into them.
+    u32 first_open_draw_call;
+    
+    b32 has_begun;
+    b32 filled;
+    Render_Primitive_Kind current_primitive;
+    u32 current_vertex_array_start;
+    v4f current_colour;
+} Render_Batch;
+
+function b32 RenderBatch_Init(Render_Batch *render_batch);
+function void RenderBatch_Reset(Render_Batch *render_batch);
+inline void RenderBatch_BeginPrimitive(Render_Batch *render_batch, Render_Primitive_Kind kind, b32 filled);
+inline void RenderBatch_End(Render_Batch *render_batch);
+inline v4f RenderBatch_Colour(Render_Batch *render_batch, v4f colour);
+inline void RenderBatch_Vertex(Render_Batch *render_batch, v2f v);
+function void RenderBatch_PushLine(Render_Batch *render_batch, v2f start, v2f end, v4f colour);
+
+//~ NOTE(christian): circle tessellation cache
+// NOTE(christian): one unit circle table per segment count (multiples of 4). each table runs
+// two full turns so any arc is a contiguous slice of it. radius picks the segment count.
+#define circle_min_segments 8
+#define circle_max_segments 128
+#define circle_max_error 0.25f
+#define circle_table_count (((circle_max_segments - circle_min_segments) / 4) + 1)
+#define circle_table_stride (circle_max_segments * 2 + 8)
+
+typedef struct Circle_Table
+{
+    u32 segment_count;
+    f32 *cos;
+    f32 *sin;
+} Circle_Table;
+
+function void Circle_BuildTables(void);
+inline u32 Circle_SegmentCountForRadius(f32 radius);
+inline Circle_Table Circle_GetTable(u32 segment_count);
+
+function void RenderBatch_PushCircleOutline(Render_Batch *render_batch, v2f origin, v4f colour, f32 radius);
+function void RenderBatch_PushCircleFilled(Render_Batch *render_batch, v2f origin, v4f colour, f32 radius);
+function void RenderBatch_PushArcOutline(Render_Batch *render_batch, v2f origin, v4f colour, f32 radius,
+                                         f32 start_radians, f32 end_radians);
+function void RenderBatch_PushRing(Render_Batch *render_batch, v2f origin, v4f colour,
+                                   f32 inner_radius, f32 outer_radius);
+
+//~ NOTE(christian): batch shards
+// NOTE(christian): one quad / immediate batch pair per job thread, so jobs can emit geometry without
+// touching a shared counter. emitting happens between RenderShards_BeginSegment and EndSegment on
+// the calling thread's shard, and every segment carries a sort key of layer and submission index.
+// the caller picks the submission index (a job's first index, say), not the thread, so merging
+// segments in key order gives the same batches however the jobs were scheduled. layers only order
+// within a batch kind, the backends still draw every immediate primitive before any quad.
+#define render_shard_max_segments (64*1024)
+
+#define RenderShards_SortKey(layer,submission_index) (((u64)(layer) << 32) | (u64)(submission_index))
+
+typedef struct Render_Segment
+{
+    u64 sort_key;
+    u32 shard_index;
+    
+    // NOTE(christian): ranges are in the shard's batches. first_chunk is where the shard's quads were
+    // when the segment began, first_quad_in_chunk may be one past its end (the quads start in the next one).
+    Quad_Render_Chunk *first_chunk;
+    u32 first_quad_in_chunk;
+    u32 first_quad;
+    u32 one_past_last_quad;
+    
+    u32 first_draw_call;
+    u32 one_past_last_draw_call;
+} Render_Segment;
+
+typedef struct Render_Shard
+{
+    Quad_Render_Batch quads;
+    Render_Batch immediate;
+    
+    Render_Segment *segments;
+    u32 segment_count;
+    b32 segment_open;
+    
+    // NOTE(christian): keeps the counters of neighbouring shards off each other's cache lines.
+    u8 padding[64];
+} Render_Shard;
+
+typedef struct Render_Shards
+{
+    Job_System *jobs;
+    u32 shard_count;
+    Render_Shard *shards;
+} Render_Shards;
+
+function b32 RenderShards_Init(Render_Shards *shards, Memory_Arena *arena, Job_System *jobs);
+function void RenderShards_Reset(Render_Shards *shards);
+inline Render_Shard *RenderShards_BeginSegment(Render_Shards *shards, u32 layer, u32 submission_index);
+inline void RenderShards_EndSegment(Render_Shard *shard);
+function void RenderShards_Merge(Render_Shards *shards, Quad_Render_Batch *quad_render_batch, Render_Batch *render_batch);
+
+//~ NOTE(christian): render stats
+// NOTE(christian): per frame counters of what went to the backend. the submission half is counted
+// by the backend as it issues calls (only d3d11 does, the software path leaves it zero), the batch
+// half is read off the merged batches by RenderStats_CollectBatches and is the same for every
+// backend. coverage is the sum of quad bounding boxes clipped to the target, so rounded and outline
+// quads count as full rects. it's an upper bound on the pixels quads shade, not an exact count.
+typedef struct Render_Stats
+{
+    // NOTE(christian): submission.
+    u32 draw_count;
+    u32 draw_instanced_count;
+    u32 topology_changes;
+    u32 rasterizer_changes;
+    u32 map_count;
+    u64 map_bytes;
+    u32 quad_buffer_capacity;
+    u32 vertex_buffer_capacity;
+    
+    // NOTE(christian): batches. capacities are what the batches have allocated, not their reserves.
+    u32 quads;
+    u32 quad_capacity;
+    u32 vertices;
+    u32 vertex_capacity;
+    u32 draw_calls;
+    // NOTE(christian): neighbouring draw calls that differ in primitive kind or fill. the least state
+    // changes any backend needs for the immediate batch.
+    u32 draw_call_state_changes;
+    u64 covered_pixels;
+    f32 overdraw;
+    
+    // NOTE(christian): timing, filled in by the caller. frame is the frame's work up to the point the
+    // stats are recorded, so it doesn't count the pacer's wait.
+    f32 frame_ms;
+    f32 update_ms;
+    f32 render_ms;
+} Render_Stats;
+
+// NOTE(christian): the overlay plots the last render_stats_history_count frames, one pixel column per
+// frame, on top of everything else in the quad batch. with an atlas each plot is labelled with its
+// name and the latest frame's value.
+#define render_stats_history_count 120
+#define render_stats_overlay_layer 0xFFFF
+
+typedef struct Render_Stats_History
+{
+    Render_Stats frames[render_stats_history_count];
+    u64 frame_count;
+} Render_Stats_History;
+
+function void RenderStats_CollectBatches(Render_Stats *stats, Quad_Render_Batch *quad_render_batch,
+                                         Render_Batch *render_batch, v2f target_dims);
+function void RenderStats_Record(Render_Stats_History *history, Render_Stats *stats);
+struct Glyph_Atlas;
+function void RenderStats_DrawOverlay(Render_Stats_History *history, Render_Shards *shards, struct Glyph_Atlas *atlas,
+                                      v2f origin);
+function void RenderStats_WriteCSVHeader(FILE *file);
+function void RenderStats_WriteCSVRow(FILE *file, u64 frame_index, Render_Stats *stats);
+
+#endif //BP_RENDER_H
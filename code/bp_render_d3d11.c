@@ -0,0 +1,968 @@
+#define d3d11_frames_in_flight 3
+
+// NOTE(christian): a shader the reload thread built, null where nothing changed.
+typedef struct D3D11_Reloaded_Shader
+{
+    ID3D11DeviceChild *shader;
+    ID3D11InputLayout *input_layout;
+} D3D11_Reloaded_Shader;
+
+typedef struct D3D11_Renderer
+{
+    ID3D11Device *base_device;
+    ID3D11Device1 *main_device;
+    ID3D11DeviceContext *base_device_context;
+    IDXGISwapChain1 *dxgi_swap_chain;
+    ID3D11Texture2D *back_buffer;
+    ID3D11RenderTargetView *render_target_view;
+    ID3D11RasterizerState1 *fill_no_cull_rasterizer_state;
+    ID3D11RasterizerState1 *wire_no_cull_rasterizer_state;
+    ID3D11BlendState *render_blend_state;
+    
+    ID3D11VertexShader *main_vertex_shader;
+    ID3D11PixelShader *main_pixel_shader;
+    ID3D11Buffer *quad_sb;
+    ID3D11ShaderResourceView *quad_srv;
+    u32 quad_sb_capacity;
+    ID3D11Buffer *quad_renderer_constants;
+    ID3D11Buffer *quad_instance_constants;
+    
+    // NOTE(christian): the glyph atlas every quad samples. a white texel when there's no atlas.
+    ID3D11Texture2D *glyph_atlas_texture;
+    ID3D11ShaderResourceView *glyph_atlas_srv;
+    ID3D11SamplerState *point_clamp_sampler;
+    
+    // NOTE(christian): quad_sb is a ring. head/tail are monotonic quad counts, position is % capacity.
+    // every frame ends with an event query; once it signals, the GPU is done with that frame's quads.
+    b32 quad_sb_no_overwrite;
+    u64 quad_ring_head;
+    u64 quad_ring_tail;
+    ID3D11Query *frame_fences[d3d11_frames_in_flight];
+    u64 frame_fence_ring_heads[d3d11_frames_in_flight];
+    u32 oldest_frame_in_flight;
+    u32 frames_in_flight;
+    
+    // NOTE(christian): submission counters of the last frame. only the backend fields are filled here.
+    Render_Stats frame_stats;
+    
+    ID3D11VertexShader *immediate_vertex_shader;
+    ID3D11PixelShader *immediate_pixel_shader;
+    ID3D11Buffer *render_batch_vertex_buffer;
+    u32 render_batch_vertex_capacity;
+    ID3D11InputLayout *render_batch_input_layout;
+    
+    // NOTE(christian): hot reload. the reload thread fills the mailbox and sets full, the render
+    // thread swaps everything in it at the start of a frame and clears full. one side owns it at a time.
+    Shader_Reloader shader_reloader;
+    D3D11_Reloaded_Shader reload_mailbox[ShaderID_Count];
+    volatile u32 reload_mailbox_full;
+    
+    D3D11_VIEWPORT viewport;
+} D3D11_Renderer;
+
+// NOTE(christian): quad_sb grows geometrically up to d3d11_quad_sb_max_quads, aiming for room for
+// two frames so one can be written while the last is in flight. anything past the cap is
+// streamed through the same buffer in several DrawInstanced ranges.
+#define d3d11_quad_sb_initial_quads quad_render_chunk_capacity
+#define d3d11_quad_sb_max_quads (u32)(MB(128) / sizeof(Quad))
+
+function b32
+D3D11_ResizeQuadBuffer(D3D11_Renderer *renderer, u32 quad_capacity)
+{
+    if (renderer->quad_srv)
+    {
+        ID3D11ShaderResourceView_Release(renderer->quad_srv);
+        renderer->quad_srv = null;
+    }
+    
+    if (renderer->quad_sb)
+    {
+        ID3D11Buffer_Release(renderer->quad_sb);
+        renderer->quad_sb = null;
+    }
+    
+    renderer->quad_sb_capacity = 0;
+    
+    D3D11_BUFFER_DESC quad_sb_desc;
+    quad_sb_desc.ByteWidth = quad_capacity * sizeof(Quad);
+    quad_sb_desc.Usage = D3D11_USAGE_DYNAMIC;
+    quad_sb_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    quad_sb_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    quad_sb_desc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    quad_sb_desc.StructureByteStride = sizeof(Quad);
+    HRESULT hresult = ID3D11Device1_CreateBuffer(renderer->main_device, &quad_sb_desc, null, &renderer->quad_sb);
+    
+    if (hresult == S_OK)
+    {
+        D3D11_SHADER_RESOURCE_VIEW_DESC quad_srv_desc;
+        quad_srv_desc.Format = DXGI_FORMAT_UNKNOWN;
+        quad_srv_desc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+        quad_srv_desc.Buffer.FirstElement = 0;
+        quad_srv_desc.Buffer.NumElements = quad_capacity;
+        hresult = ID3D11Device1_CreateShaderResourceView(renderer->main_device, (ID3D11Resource *)renderer->quad_sb,
+                                                         &quad_srv_desc, &renderer->quad_srv);
+        if (hresult == S_OK)
+        {
+            renderer->quad_sb_capacity = quad_capacity;
+        }
+    }
+    
+    // NOTE(christian): new buffer, nothing in it is in use. frames still in flight read the old one.
+    renderer->quad_ring_head = 0;
+    renderer->quad_ring_tail = 0;
+    for (u32 fence_index = 0; fence_index < d3d11_frames_in_flight; ++fence_index)
+    {
+        renderer->frame_fence_ring_heads[fence_index] = 0;
+    }
+    
+    return(hresult == S_OK);
+}
+
+#define d3d11_vertex_buffer_initial_vertices 4096
+
+function b32
+D3D11_ResizeVertexBuffer(D3D11_Renderer *renderer, u32 vertex_capacity)
+{
+    if (renderer->render_batch_vertex_buffer)
+    {
+        ID3D11Buffer_Release(renderer->render_batch_vertex_buffer);
+        renderer->render_batch_vertex_buffer = null;
+    }
+    
+    renderer->render_batch_vertex_capacity = 0;
+    
+    D3D11_BUFFER_DESC vertex_buffer_desc;
+    vertex_buffer_desc.ByteWidth = sizeof(Render_Per_Vertex_Data) * vertex_capacity;
+    vertex_buffer_desc.Usage = D3D11_USAGE_DYNAMIC;
+    vertex_buffer_desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    vertex_buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    vertex_buffer_desc.MiscFlags = 0;
+    vertex_buffer_desc.StructureByteStride = 0;
+    
+    HRESULT hresult = ID3D11Device1_CreateBuffer(renderer->main_device, &vertex_buffer_desc, null, 
+                                                 &renderer->render_batch_vertex_buffer);
+    if (hresult == S_OK)
+    {
+        renderer->render_batch_vertex_capacity = vertex_capacity;
+    }
+    
+    return(hresult == S_OK);
+}
+
+function void
+D3D11_RetireFrames(D3D11_Renderer *renderer, b32 wait_for_oldest)
+{
+    while (renderer->frames_in_flight)
+    {
+        ID3D11Query *fence = renderer->frame_fences[renderer->oldest_frame_in_flight];
+        HRESULT hresult = ID3D11DeviceContext_GetData(renderer->base_device_context, (ID3D11Asynchronous *)fence,
+                                                      null, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH);
+        if (hresult != S_OK)
+        {
+            if (!wait_for_oldest)
+            {
+                break;
+            }
+            
+            while (ID3D11DeviceContext_GetData(renderer->base_device_context, (ID3D11Asynchronous *)fence,
+                                               null, 0, 0) == S_FALSE);
+        }
+        
+        renderer->quad_ring_tail = Max(renderer->quad_ring_tail,
+                                       renderer->frame_fence_ring_heads[renderer->oldest_frame_in_flight]);
+        renderer->oldest_frame_in_flight = (renderer->oldest_frame_in_flight + 1) % d3d11_frames_in_flight;
+        --renderer->frames_in_flight;
+        wait_for_oldest = False;
+    }
+}
+
+// NOTE(christian): returns the first quad index of a contiguous range of count quads in quad_sb,
+// and the map type to write it with. falls back to DISCARD when the ring can't fit it.
+function u32
+D3D11_QuadRingAllocate(D3D11_Renderer *renderer, u32 count, D3D11_MAP *map_type)
+{
+    u32 result = 0;
+    *map_type = D3D11_MAP_WRITE_DISCARD;
+    
+    D3D11_RetireFrames(renderer, False);
+    
+    if (renderer->quad_sb_no_overwrite && renderer->quad_ring_head)
+    {
+        u64 capacity = renderer->quad_sb_capacity;
+        u64 position = renderer->quad_ring_head % capacity;
+        u64 padding = ((position + count) > capacity) ? (capacity - position) : 0;
+        u64 used = renderer->quad_ring_head - renderer->quad_ring_tail;
+        
+        if ((used + padding + count) <= capacity)
+        {
+            result = (u32)((position + padding) % capacity);
+            renderer->quad_ring_head += padding + count;
+            *map_type = D3D11_MAP_WRITE_NO_OVERWRITE;
+        }
+    }
+    
+    if (*map_type == D3D11_MAP_WRITE_DISCARD)
+    {
+        // NOTE(christian): DISCARD renames the buffer, whatever the GPU is still reading stays valid.
+        renderer->quad_ring_tail = 0;
+        renderer->quad_ring_head = count;
+        for (u32 fence_index = 0; fence_index < d3d11_frames_in_flight; ++fence_index)
+        {
+            renderer->frame_fence_ring_heads[fence_index] = 0;
+        }
+        result = 0;
+    }
+    
+    return(result);
+}
+
+function IDXGISwapChain1 *
+D3D11_AcquireSwapChain(HWND window_handle, ID3D11Device1 *device1)
+{
+    IDXGIDevice2 *dxgi_device = null;
+    IDXGIAdapter *dxgi_adapter = null;
+    IDXGIFactory2 *dxgi_factory = null;
+    
+    IDXGISwapChain1 *result = null;
+    
+    HRESULT hresult = ID3D11Device_QueryInterface(device1, &IID_IDXGIDevice2, (void **)(&dxgi_device));
+    if (hresult == S_OK)
+    {
+        hresult = IDXGIDevice2_GetAdapter(dxgi_device, &dxgi_adapter);
+        if (hresult == S_OK)
+        {
+            hresult = IDXGIAdapter_GetParent(dxgi_adapter, &IID_IDXGIFactory2, (void **)(&dxgi_factory));
+            if (hresult == S_OK)
+            {
+                
+                DXGI_SWAP_CHAIN_DESC1 swap_chain_desc1;
+                swap_chain_desc1.Width = 480;
+                swap_chain_desc1.Height = 270;
+                swap_chain_desc1.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+                swap_chain_desc1.Stereo = FALSE;
+                swap_chain_desc1.SampleDesc.Count = 1;
+                swap_chain_desc1.SampleDesc.Quality = 0;
+                swap_chain_desc1.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+                swap_chain_desc1.BufferCount = 2;
+                swap_chain_desc1.Scaling = DXGI_SCALING_STRETCH;
+                swap_chain_desc1.SwapEffect = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+                swap_chain_desc1.AlphaMode = DXGI_ALPHA_MODE_UNSPECIFIED;
+                //swap_chain_desc1.AlphaMode = DXGI_ALPHA_MODE_PREMULTIPLIED;
+                swap_chain_desc1.Flags = 0;
+                hresult = IDXGIFactory2_CreateSwapChainForHwnd(dxgi_factory, (IUnknown *)device1, window_handle, &swap_chain_desc1,
+                                                               null, null, &result);
+                
+                if (hresult != S_OK)
+                {
+                }
+                
+                IDXGIFactory2_Release(dxgi_factory);
+            }
+            
+            IDXGIAdapter_Release(dxgi_adapter);
+        }
+        
+        IDXGIDevice2_Release(dxgi_device);
+    }
+    
+    return(result);
+}
+
+function b32
+D3D11_CreateGlyphAtlas(D3D11_Renderer *renderer, Glyph_Atlas *glyph_atlas)
+{
+    u8 white_texel = 0xFF;
+    D3D11_TEXTURE2D_DESC texture_desc = {0};
+    texture_desc.Width = glyph_atlas ? glyph_atlas->width : 1;
+    texture_desc.Height = glyph_atlas ? glyph_atlas->height : 1;
+    texture_desc.MipLevels = 1;
+    texture_desc.ArraySize = 1;
+    texture_desc.Format = DXGI_FORMAT_R8_UNORM;
+    texture_desc.SampleDesc.Count = 1;
+    texture_desc.SampleDesc.Quality = 0;
+    texture_desc.Usage = D3D11_USAGE_IMMUTABLE;
+    texture_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    
+    D3D11_SUBRESOURCE_DATA texture_data = {0};
+    texture_data.pSysMem = glyph_atlas ? glyph_atlas->texels : &white_texel;
+    texture_data.SysMemPitch = texture_desc.Width;
+    
+    HRESULT hresult = ID3D11Device1_CreateTexture2D(renderer->main_device, &texture_desc, &texture_data,
+                                                    &renderer->glyph_atlas_texture);
+    if (hresult == S_OK)
+    {
+        hresult = ID3D11Device1_CreateShaderResourceView(renderer->main_device, (ID3D11Resource *)renderer->glyph_atlas_texture,
+                                                         null, &renderer->glyph_atlas_srv);
+    }
+    
+    if (hresult == S_OK)
+    {
+        D3D11_SAMPLER_DESC sampler_desc = {0};
+        sampler_desc.Filter = D3D11_FILTER_MIN_MAG_MIP_POINT;
+        sampler_desc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+        sampler_desc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+        sampler_desc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+        sampler_desc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+        sampler_desc.MaxLOD = D3D11_FLOAT32_MAX;
+        hresult = ID3D11Device1_CreateSamplerState(renderer->main_device, &sampler_desc, &renderer->point_clamp_sampler);
+    }
+    
+    return(hresult == S_OK);
+}
+
+//~ NOTE(christian): shaders
+// NOTE(christian): the pack and the fallback compile use the same flags, they're part of the key.
+#define d3d11_shader_compile_flags D3DCOMPILE_OPTIMIZATION_LEVEL3
+
+// NOTE(christian): errors and warnings go to stdout. the blob is the caller's to release.
+function b32
+D3D11_CompileShader(Shader_Source *source, String_Const_U8 text, ID3DBlob **out_bytecode)
+{
+    ID3DBlob *error_blob = null;
+    *out_bytecode = null;
+    HRESULT hresult = D3DCompile(text.str, text.count, source->path, null, D3D_COMPILE_STANDARD_FILE_INCLUDE,
+                                 source->entry_point, source->target, d3d11_shader_compile_flags, 0,
+                                 out_bytecode, &error_blob);
+    if (error_blob)
+    {
+        printf("%s", (char *)ID3D10Blob_GetBufferPointer(error_blob));
+        ID3D10Blob_Release(error_blob);
+    }
+    
+    b32 result = SUCCEEDED(hresult) && *out_bytecode;
+    return(result);
+}
+
+// NOTE(christian): the immediate vertex shader comes with the input layout built against it. safe
+// to call from any thread, the device is free threaded.
+function b32
+D3D11_CreateShader(D3D11_Renderer *renderer, Shader_ID id, void *bytecode, u64 size,
+                   ID3D11DeviceChild **out_shader, ID3D11InputLayout **out_input_layout)
+{
+    HRESULT hresult = E_FAIL;
+    *out_shader = null;
+    *out_input_layout = null;
+    switch (id)
+    {
+        case ShaderID_MainVertex:
+        case ShaderID_ImmediateVertex:
+        {
+            hresult = ID3D11Device1_CreateVertexShader(renderer->main_device, bytecode, size, null,
+                                                       (ID3D11VertexShader **)out_shader);
+        } break;
+        
+        case ShaderID_MainPixel:
+        case ShaderID_ImmediatePixel:
+        {
+            hresult = ID3D11Device1_CreatePixelShader(renderer->main_device, bytecode, size, null,
+                                                      (ID3D11PixelShader **)out_shader);
+        } break;
+        
+        default: break;
+    }
+    
+    if (SUCCEEDED(hresult) && (id == ShaderID_ImmediateVertex))
+    {
+        D3D11_INPUT_ELEMENT_DESC input_laypout_desc[] = 
+        {
+            (D3D11_INPUT_ELEMENT_DESC){
+                "Vertex", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0
+            },
+            (D3D11_INPUT_ELEMENT_DESC){
+                "Colour", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0
+            }
+        };
+        
+        hresult = ID3D11Device1_CreateInputLayout(renderer->main_device, input_laypout_desc, 2, bytecode, size,
+                                                  out_input_layout);
+        if (FAILED(hresult))
+        {
+            ID3D11DeviceChild_Release(*out_shader);
+            *out_shader = null;
+        }
+    }
+    
+    b32 result = SUCCEEDED(hresult);
+    return(result);
+}
+
+// NOTE(christian): puts shader in id's place and drops the one it replaces. render thread only. the
+// context keeps its own reference to whatever is bound, so releasing mid flight is fine.
+function void
+D3D11_SwapShader(D3D11_Renderer *renderer, Shader_ID id, ID3D11DeviceChild *shader, ID3D11InputLayout *input_layout)
+{
+    ID3D11DeviceChild **slot = null;
+    switch (id)
+    {
+        case ShaderID_MainVertex: { slot = (ID3D11DeviceChild **)&renderer->main_vertex_shader; } break;
+        case ShaderID_MainPixel: { slot = (ID3D11DeviceChild **)&renderer->main_pixel_shader; } break;
+        case ShaderID_ImmediateVertex: { slot = (ID3D11DeviceChild **)&renderer->immediate_vertex_shader; } break;
+        case ShaderID_ImmediatePixel: { slot = (ID3D11DeviceChild **)&renderer->immediate_pixel_shader; } break;
+        default: break;
+    }
+    
+    if (slot)
+    {
+        if (*slot)
+        {
+            ID3D11DeviceChild_Release(*slot);
+        }
+        *slot = shader;
+    }
+    
+    if (id == ShaderID_ImmediateVertex)
+    {
+        if (renderer->render_batch_input_layout)
+        {
+            ID3D11InputLayout_Release(renderer->render_batch_input_layout);
+        }
+        renderer->render_batch_input_layout = input_layout;
+    }
+}
+
+// NOTE(christian): compiles every entry of pack that is missing or doesn't match its source, into
+// arena. a source that can't be read keeps whatever the pack has. returns how many were compiled
+// and counts the ones that failed in *out_failed_count.
+function u32
+D3D11_UpdateShaderPack(Shader_Pack *pack, Memory_Arena *arena, u32 *out_failed_count)
+{
+    u32 result = 0;
+    u32 failed_count = 0;
+    for (u32 shader_index = 0; shader_index < ShaderID_Count; ++shader_index)
+    {
+        Shader_Source *source = Shader_GetSource((Shader_ID)shader_index);
+        Shader_Bytecode *shader = pack->shaders + shader_index;
+        String_Const_U8 text = Shader_ReadFile(arena, source->path);
+        if (!text.count)
+        {
+            printf("failed to read %s\n", source->path);
+            failed_count += shader->data ? 0 : 1;
+            continue;
+        }
+        
+        u64 source_hash = Shader_HashSource(text, source, d3d11_shader_compile_flags);
+        if (shader->data && (shader->source_hash == source_hash))
+        {
+            continue;
+        }
+        
+        ID3DBlob *bytecode_blob;
+        if (D3D11_CompileShader(source, text, &bytecode_blob))
+        {
+            u64 size = ID3D10Blob_GetBufferSize(bytecode_blob);
+            u8 *data = MemoryArena_PushArray(arena, u8, size);
+            if (data)
+            {
+                MemoryCopy(data, ID3D10Blob_GetBufferPointer(bytecode_blob), size);
+                shader->source_hash = source_hash;
+                shader->data = data;
+                shader->size = size;
+                ++result;
+            }
+        }
+        else
+        {
+            ++failed_count;
+        }
+        
+        if (bytecode_blob)
+        {
+            ID3D10Blob_Release(bytecode_blob);
+        }
+    }
+    
+    *out_failed_count = failed_count;
+    return(result);
+}
+
+// NOTE(christian): loads the pack, compiles what's stale and writes the pack back if anything was.
+// with an up to date pack there is no compiler call at all. the build runs the same thing through
+// -build-shaders, so a normal launch starts warm.
+function b32
+D3D11_BuildShaderPack(Shader_Pack *pack, Memory_Arena *arena)
+{
+    u64 begin_ticks = OS_GetTicks();
+    ShaderPack_Load(pack, arena, shader_pack_path);
+    u32 failed_count = 0;
+    u32 compiled_count = D3D11_UpdateShaderPack(pack, arena, &failed_count);
+    if (compiled_count && !ShaderPack_Write(pack, shader_pack_path))
+    {
+        printf("failed to write %s\n", shader_pack_path);
+    }
+    
+    printf("shaders: %u from pack, %u compiled, %u failed, %.2f ms\n",
+           ShaderID_Count - compiled_count - failed_count, compiled_count, failed_count,
+           1000.0 * OS_SecondsBetweenTicksF64(begin_ticks, OS_GetTicks()));
+    return(failed_count == 0);
+}
+
+function void
+D3D11_LoadShaders(D3D11_Renderer *renderer)
+{
+    Temporary_Memory scratch = Scratch_Begin(null, 0);
+    Shader_Pack pack;
+    D3D11_BuildShaderPack(&pack, scratch.arena);
+    for (u32 shader_index = 0; shader_index < ShaderID_Count; ++shader_index)
+    {
+        Shader_Bytecode *bytecode = pack.shaders + shader_index;
+        ID3D11DeviceChild *shader;
+        ID3D11InputLayout *input_layout;
+        if (bytecode->data &&
+            D3D11_CreateShader(renderer, (Shader_ID)shader_index, bytecode->data, bytecode->size, &shader, &input_layout))
+        {
+            D3D11_SwapShader(renderer, (Shader_ID)shader_index, shader, input_layout);
+        }
+    }
+    
+    Assert(renderer->main_vertex_shader && renderer->main_pixel_shader &&
+           renderer->immediate_vertex_shader && renderer->immediate_pixel_shader);
+    Scratch_End(scratch);
+}
+
+//~ NOTE(christian): shader hot reload
+function void
+D3D11_ReleaseReloadedShaders(D3D11_Reloaded_Shader *reloaded)
+{
+    for (u32 shader_index = 0; shader_index < ShaderID_Count; ++shader_index)
+    {
+        if (reloaded[shader_index].shader)
+        {
+            ID3D11DeviceChild_Release(reloaded[shader_index].shader);
+        }
+        if (reloaded[shader_index].input_layout)
+        {
+            ID3D11InputLayout_Release(reloaded[shader_index].input_layout);
+        }
+    }
+    MemoryZero(reloaded, sizeof(D3D11_Reloaded_Shader) * ShaderID_Count);
+}
+
+// NOTE(christian): Shader_Reload_Proc. compiling and creating both happen here on the reload
+// thread, the render thread only swaps pointers.
+function b32
+D3D11_ReloadShaders(void *backend, Shader_ID *ids, String_Const_U8 *sources, u32 count)
+{
+    D3D11_Renderer *renderer = (D3D11_Renderer *)backend;
+    D3D11_Reloaded_Shader reloaded[ShaderID_Count] = {0};
+    b32 result = True;
+    for (u32 reload_index = 0; result && (reload_index < count); ++reload_index)
+    {
+        Shader_ID id = ids[reload_index];
+        ID3DBlob *bytecode_blob;
+        result = D3D11_CompileShader(Shader_GetSource(id), sources[reload_index], &bytecode_blob);
+        if (result)
+        {
+            result = D3D11_CreateShader(renderer, id, ID3D10Blob_GetBufferPointer(bytecode_blob),
+                                        ID3D10Blob_GetBufferSize(bytecode_blob),
+                                        &reloaded[id].shader, &reloaded[id].input_layout);
+        }
+        
+        if (bytecode_blob)
+        {
+            ID3D10Blob_Release(bytecode_blob);
+        }
+    }
+    
+    // NOTE(christian): the render thread empties the mailbox every frame, so this waits a frame at most.
+    // once it's shutting down it doesn't empty it anymore, and the batch is dropped.
+    while (result && AtomicLoadU32(&renderer->reload_mailbox_full))
+    {
+        result = !AtomicLoadU32(&renderer->shader_reloader.stop);
+        OS_Sleep(1);
+    }
+    
+    if (result)
+    {
+        MemoryCopy(renderer->reload_mailbox, reloaded, sizeof(reloaded));
+        AtomicStoreU32(&renderer->reload_mailbox_full, 1);
+    }
+    else
+    {
+        D3D11_ReleaseReloadedShaders(reloaded);
+    }
+    return(result);
+}
+
+// NOTE(christian): render thread, before anything of the frame is bound.
+function void
+D3D11_ApplyReloadedShaders(D3D11_Renderer *renderer)
+{
+    if (AtomicLoadU32(&renderer->reload_mailbox_full))
+    {
+        for (u32 shader_index = 0; shader_index < ShaderID_Count; ++shader_index)
+        {
+            D3D11_Reloaded_Shader *reloaded = renderer->reload_mailbox + shader_index;
+            if (reloaded->shader)
+            {
+                D3D11_SwapShader(renderer, (Shader_ID)shader_index, reloaded->shader, reloaded->input_layout);
+            }
+        }
+        MemoryZero(renderer->reload_mailbox, sizeof(renderer->reload_mailbox));
+        AtomicStoreU32(&renderer->reload_mailbox_full, 0);
+    }
+}
+
+function b32
+D3D11_StartShaderReload(D3D11_Renderer *renderer)
+{
+    b32 result = ShaderReloader_Start(&renderer->shader_reloader, &D3D11_ReloadShaders, renderer);
+    return(result);
+}
+
+// NOTE(christian): render thread, at shutdown. joins the reload thread and releases whatever it left
+// in the mailbox that no frame swapped in.
+function void
+D3D11_StopShaderReload(D3D11_Renderer *renderer)
+{
+    ShaderReloader_Stop(&renderer->shader_reloader);
+    if (AtomicLoadU32(&renderer->reload_mailbox_full))
+    {
+        D3D11_ReleaseReloadedShaders(renderer->reload_mailbox);
+        AtomicStoreU32(&renderer->reload_mailbox_full, 0);
+    }
+}
+
+function b32
+D3D11_RendererInit(D3D11_Renderer *renderer, HWND window_handle, Glyph_Atlas *glyph_atlas)
+{
+    
+    D3D_FEATURE_LEVEL feature_level = D3D_FEATURE_LEVEL_11_0;
+    HRESULT hresult = D3D11CreateDevice(null, D3D_DRIVER_TYPE_HARDWARE, null, D3D11_CREATE_DEVICE_BGRA_SUPPORT | D3D11_CREATE_DEVICE_DEBUG,
+                                        &feature_level, 1, D3D11_SDK_VERSION, &renderer->base_device, null, &renderer->base_device_context);
+    
+    // NOTE(christian): logging
+    if (hresult == S_OK)
+    {
+        hresult = ID3D11Device_QueryInterface(renderer->base_device, &IID_ID3D11Device1, (void **)(&renderer->main_device));
+        
+        renderer->dxgi_swap_chain = D3D11_AcquireSwapChain(window_handle, renderer->main_device);
+        
+        hresult = IDXGISwapChain1_GetBuffer(renderer->dxgi_swap_chain, 0, &IID_ID3D11Texture2D,
+                                            (void **)(&renderer->back_buffer));
+        
+        D3D11_RENDER_TARGET_VIEW_DESC rtv_desc = {0};
+        rtv_desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+        rtv_desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2D;
+        
+        ID3D11Device1_CreateRenderTargetView(renderer->main_device, (ID3D11Resource *)renderer->back_buffer, &rtv_desc,
+                                             &renderer->render_target_view);
+        
+        D3D11_LoadShaders(renderer);
+        
+        //~
+        D3D11_RASTERIZER_DESC1 raster_desc1;
+        raster_desc1.FillMode = D3D11_FILL_SOLID;
+        raster_desc1.CullMode = D3D11_CULL_NONE;
+        raster_desc1.FrontCounterClockwise;
+        raster_desc1.DepthBias = 0;
+        raster_desc1.DepthBiasClamp = 0.0f;
+        raster_desc1.SlopeScaledDepthBias;
+        raster_desc1.DepthClipEnable = TRUE;
+        raster_desc1.ScissorEnable = FALSE;
+        raster_desc1.MultisampleEnable = FALSE;
+        raster_desc1.AntialiasedLineEnable = FALSE;
+        raster_desc1.ForcedSampleCount = FALSE;
+        ID3D11Device1_CreateRasterizerState1(renderer->main_device, &raster_desc1, &renderer->fill_no_cull_rasterizer_state);
+        
+        raster_desc1.FillMode = D3D11_FILL_WIREFRAME;
+        ID3D11Device1_CreateRasterizerState1(renderer->main_device, &raster_desc1, &renderer->wire_no_cull_rasterizer_state);
+        
+        D3D11_BLEND_DESC blend_desc = {0};
+        blend_desc.AlphaToCoverageEnable = FALSE;
+        blend_desc.IndependentBlendEnable = FALSE;
+        blend_desc.RenderTarget[0].BlendEnable = TRUE;
+        blend_desc.RenderTarget[0].SrcBlend = D3D11_BLEND_ONE;
+        blend_desc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
+        blend_desc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
+        blend_desc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
+        blend_desc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_INV_SRC_ALPHA;
+        blend_desc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
+        blend_desc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+        ID3D11Device1_CreateBlendState(renderer->main_device, &blend_desc, &renderer->render_blend_state);
+    }
+    
+    //~ NOTE(christian): general rendering
+    D3D11_ResizeVertexBuffer(renderer, d3d11_vertex_buffer_initial_vertices);
+    
+    //~ NOTE(christian): quad rendering
+    D3D11_ResizeQuadBuffer(renderer, d3d11_quad_sb_initial_quads);
+    D3D11_CreateGlyphAtlas(renderer, glyph_atlas);
+    
+    D3D11_BUFFER_DESC constant_buffer_desc;
+    constant_buffer_desc.ByteWidth = (sizeof(m44) + 15) & ~(15);
+    constant_buffer_desc.Usage = D3D11_USAGE_DYNAMIC;
+    constant_buffer_desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    constant_buffer_desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    constant_buffer_desc.MiscFlags = 0;
+    constant_buffer_desc.StructureByteStride = 0;
+    ID3D11Device1_CreateBuffer(renderer->main_device, &constant_buffer_desc, null, &renderer->quad_renderer_constants);
+    
+    constant_buffer_desc.ByteWidth = 16;
+    ID3D11Device1_CreateBuffer(renderer->main_device, &constant_buffer_desc, null, &renderer->quad_instance_constants);
+    
+    D3D11_FEATURE_DATA_D3D11_OPTIONS d3d11_options = {0};
+    if (ID3D11Device1_CheckFeatureSupport(renderer->main_device, D3D11_FEATURE_D3D11_OPTIONS,
+                                          &d3d11_options, sizeof(d3d11_options)) == S_OK)
+    {
+        renderer->quad_sb_no_overwrite = d3d11_options.MapNoOverwriteOnDynamicBufferSRV;
+    }
+    
+    D3D11_QUERY_DESC fence_desc;
+    fence_desc.Query = D3D11_QUERY_EVENT;
+    fence_desc.MiscFlags = 0;
+    for (u32 fence_index = 0; fence_index < d3d11_frames_in_flight; ++fence_index)
+    {
+        ID3D11Device1_CreateQuery(renderer->main_device, &fence_desc, renderer->frame_fences + fence_index);
+    }
+    
+    D3D11_TEXTURE2D_DESC back_buffer_desc;
+    ID3D11Texture2D_GetDesc(renderer->back_buffer, &back_buffer_desc);
+    
+    renderer->viewport.TopLeftX = 0.0f;
+    renderer->viewport.TopLeftY = 0.0f;
+    renderer->viewport.Width = (f32)back_buffer_desc.Width;
+    renderer->viewport.Height = (f32)back_buffer_desc.Height;
+    renderer->viewport.MinDepth = 0.0f;
+    renderer->viewport.MaxDepth = 1.0f;
+    
+    return(hresult == S_OK);
+}
+
+function void
+D3D11_RendererSubmit(D3D11_Renderer *renderer, Quad_Render_Batch *quad_render_batch, Render_Batch *render_batch)
+{
+    Render_Stats *stats = &renderer->frame_stats;
+    MemoryZero(stats, sizeof(Render_Stats));
+    D3D11_ApplyReloadedShaders(renderer);
+    
+    u32 quads_to_draw = quad_render_batch->quads_drawn;
+    if (((quads_to_draw * 2) > renderer->quad_sb_capacity) && (renderer->quad_sb_capacity < d3d11_quad_sb_max_quads))
+    {
+        u32 new_capacity = Max(renderer->quad_sb_capacity, d3d11_quad_sb_initial_quads);
+        while ((new_capacity < (quads_to_draw * 2)) && (new_capacity < d3d11_quad_sb_max_quads))
+        {
+            new_capacity *= 2;
+        }
+        
+        D3D11_ResizeQuadBuffer(renderer, Min(new_capacity, d3d11_quad_sb_max_quads));
+    }
+    
+    D3D11_MAPPED_SUBRESOURCE mapped_subresource;
+    switch (ID3D11DeviceContext_Map(renderer->base_device_context, (ID3D11Resource *)renderer->quad_renderer_constants, 
+                                    0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_subresource))
+    {
+        case S_OK:
+        {
+            m44 test = Matrix4x4_Orthographic_LH_CM_Z01(0.0f, renderer->viewport.Width,
+                                                        0.0f, renderer->viewport.Height,
+                                                        0.0f, 1.0f);
+            MemoryCopy(mapped_subresource.pData, &test, sizeof(m44));
+            ID3D11DeviceContext_Unmap(renderer->base_device_context, (ID3D11Resource *)renderer->quad_renderer_constants, 0);
+            ++stats->map_count;
+            stats->map_bytes += sizeof(m44);
+        } break;
+    }
+    
+    f32 clear_colour[] = { powf(0.0f, 2.2f), powf(0.0f, 2.2f), powf(0.0f, 2.2f), 1.0f };
+    
+    ID3D11DeviceContext_ClearRenderTargetView(renderer->base_device_context, renderer->render_target_view, clear_colour);
+    
+    //~ NOTE(christian): commons
+    ID3D11DeviceContext_VSSetConstantBuffers(renderer->base_device_context, 0, 1, &renderer->quad_renderer_constants);
+    
+    ID3D11DeviceContext_RSSetViewports(renderer->base_device_context, 1, &renderer->viewport);
+    
+    ID3D11DeviceContext_OMSetRenderTargets(renderer->base_device_context, 1, &renderer->render_target_view, null);
+    ID3D11DeviceContext_OMSetBlendState(renderer->base_device_context, renderer->render_blend_state, null, 0xFFFFFFFF);
+    
+    //~ NOTE(christian): general rendering
+    u32 stride = sizeof(Render_Per_Vertex_Data);
+    u32 offset = 0;
+    ID3D11DeviceContext_IASetInputLayout(renderer->base_device_context, renderer->render_batch_input_layout);
+    ID3D11DeviceContext_IASetVertexBuffers(renderer->base_device_context, 0, 1, &renderer->render_batch_vertex_buffer, &stride, &offset);
+    ID3D11DeviceContext_VSSetShader(renderer->base_device_context, renderer->immediate_vertex_shader, null, 0);
+    
+    ID3D11DeviceContext_PSSetShader(renderer->base_device_context, renderer->immediate_pixel_shader, null, 0);
+    
+    // NOTE(christian): the whole vertex array goes up in one map. draw calls are already merged
+    // and every primitive is a list, so each one is a Draw at its offset.
+    if (render_batch->vertex_count > renderer->render_batch_vertex_capacity)
+    {
+        u32 new_capacity = Max(renderer->render_batch_vertex_capacity, d3d11_vertex_buffer_initial_vertices);
+        while (new_capacity < render_batch->vertex_count)
+        {
+            new_capacity *= 2;
+        }
+        
+        D3D11_ResizeVertexBuffer(renderer, new_capacity);
+        ID3D11DeviceContext_IASetVertexBuffers(renderer->base_device_context, 0, 1, &renderer->render_batch_vertex_buffer, &stride, &offset);
+    }
+    
+    ProfileBegin("upload");
+    b32 vertices_uploaded = False;
+    if (render_batch->vertex_count && (render_batch->vertex_count <= renderer->render_batch_vertex_capacity))
+    {
+        switch (ID3D11DeviceContext_Map(renderer->base_device_context, (ID3D11Resource *)renderer->render_batch_vertex_buffer, 
+                                        0, D3D11_MAP_WRITE_DISCARD, 0, &mapped_subresource))
+        {
+            case S_OK:
+            {
+                MemoryCopy(mapped_subresource.pData, render_batch->vertices,
+                           sizeof(Render_Per_Vertex_Data) * render_batch->vertex_count);
+                ID3D11DeviceContext_Unmap(renderer->base_device_context, (ID3D11Resource *)renderer->render_batch_vertex_buffer, 0);
+                ++stats->map_count;
+                stats->map_bytes += sizeof(Render_Per_Vertex_Data) * render_batch->vertex_count;
+                vertices_uploaded = True;
+            } break;
+        }
+    }
+    
+    ProfileEnd("upload");
+    
+    ProfileBegin("draw submission");
+    D3D11_PRIMITIVE_TOPOLOGY current_topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+    ID3D11RasterizerState *current_rasterizer = null;
+    for (u32 draw_call_index = 0;
+         vertices_uploaded && (draw_call_index < render_batch->draw_call_count);
+         ++draw_call_index)
+    {
+        Render_Draw_Call *draw_call = render_batch->draw_calls + draw_call_index;
+        AssertTrue(draw_call->vertex_array_base_index < draw_call->vertex_array_end_index);
+        
+        ID3D11RasterizerState *rasterizer = (ID3D11RasterizerState *)(draw_call->filled ? 
+                                                                      renderer->fill_no_cull_rasterizer_state :
+                                                                      renderer->wire_no_cull_rasterizer_state);
+        u32 vertices = draw_call->vertex_array_end_index - draw_call->vertex_array_base_index;
+        
+        D3D11_PRIMITIVE_TOPOLOGY topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+        switch (draw_call->primitive_kind)
+        {
+            case RenderPrimitiveKind_Point:
+            {
+                topology = D3D11_PRIMITIVE_TOPOLOGY_POINTLIST;
+            } break;
+            
+            case RenderPrimitiveKind_Line:
+            {
+                topology = D3D11_PRIMITIVE_TOPOLOGY_LINELIST;
+            } break;
+            
+            case RenderPrimitiveKind_Triangle:
+            {
+                topology = D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+            } break;
+            
+            default:
+            {
+                InvalidCodePath();
+            } break;
+        }
+        
+        if (topology != current_topology)
+        {
+            ID3D11DeviceContext_IASetPrimitiveTopology(renderer->base_device_context, topology);
+            current_topology = topology;
+            ++stats->topology_changes;
+        }
+        
+        if (rasterizer != current_rasterizer)
+        {
+            ID3D11DeviceContext_RSSetState(renderer->base_device_context, rasterizer);
+            current_rasterizer = rasterizer;
+            ++stats->rasterizer_changes;
+        }
+        
+        ID3D11DeviceContext_Draw(renderer->base_device_context, vertices, draw_call->vertex_array_base_index);
+        ++stats->draw_count;
+    }
+    
+    //~ NOTE(christian): quad rendering
+    ID3D11DeviceContext_IASetPrimitiveTopology(renderer->base_device_context, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    ++stats->topology_changes;
+    ID3D11DeviceContext_IASetInputLayout(renderer->base_device_context, null);
+    ID3D11DeviceContext_IASetVertexBuffers(renderer->base_device_context, 0, 0, null, null, null);
+    
+    ID3D11DeviceContext_VSSetShaderResources(renderer->base_device_context, 0, 1, &renderer->quad_srv);
+    ID3D11DeviceContext_VSSetShader(renderer->base_device_context, renderer->main_vertex_shader, null, 0);
+    
+    ID3D11DeviceContext_PSSetShader(renderer->base_device_context, renderer->main_pixel_shader, null, 0);
+    ID3D11DeviceContext_PSSetShaderResources(renderer->base_device_context, 1, 1, &renderer->glyph_atlas_srv);
+    ID3D11DeviceContext_PSSetSamplers(renderer->base_device_context, 0, 1, &renderer->point_clamp_sampler);
+    
+    ID3D11DeviceContext_RSSetState(renderer->base_device_context, (ID3D11RasterizerState *)renderer->fill_no_cull_rasterizer_state);
+    ++stats->rasterizer_changes;
+    
+    ID3D11DeviceContext_VSSetConstantBuffers(renderer->base_device_context, 1, 1, &renderer->quad_instance_constants);
+    
+    // NOTE(christian): only the quads pushed this frame are uploaded. each range is sub-allocated
+    // out of the ring and copied straight from the chunk chain.
+    Quad_Render_Chunk *chunk = quad_render_batch->first_chunk;
+    u32 chunk_offset = 0;
+    while (quads_to_draw && renderer->quad_sb_capacity)
+    {
+        u32 range_count = Min(quads_to_draw, renderer->quad_sb_capacity);
+        D3D11_MAP map_type;
+        u32 range_base = D3D11_QuadRingAllocate(renderer, range_count, &map_type);
+        
+        D3D11_MAPPED_SUBRESOURCE quad_mapped_subresource;
+        if (ID3D11DeviceContext_Map(renderer->base_device_context, (ID3D11Resource *)renderer->quad_sb,
+                                    0, map_type, 0, &quad_mapped_subresource) != S_OK)
+        {
+            break;
+        }
+        
+        Quad *dest = (Quad *)quad_mapped_subresource.pData + range_base;
+        u32 quads_left_in_range = range_count;
+        while (quads_left_in_range)
+        {
+            u32 copy_count = Min(quads_left_in_range, chunk->quads_drawn - chunk_offset);
+            MemoryCopy(dest, chunk->quads + chunk_offset, copy_count * sizeof(Quad));
+            dest += copy_count;
+            chunk_offset += copy_count;
+            quads_left_in_range -= copy_count;
+            
+            if (chunk_offset == chunk->quads_drawn)
+            {
+                chunk = chunk->next;
+                chunk_offset = 0;
+            }
+        }
+        
+        ID3D11DeviceContext_Unmap(renderer->base_device_context, (ID3D11Resource *)renderer->quad_sb, 0);
+        ++stats->map_count;
+        stats->map_bytes += range_count * sizeof(Quad);
+        
+        D3D11_MAPPED_SUBRESOURCE instance_mapped_subresource;
+        if (ID3D11DeviceContext_Map(renderer->base_device_context, (ID3D11Resource *)renderer->quad_instance_constants,
+                                    0, D3D11_MAP_WRITE_DISCARD, 0, &instance_mapped_subresource) == S_OK)
+        {
+            *(u32 *)instance_mapped_subresource.pData = range_base;
+            ID3D11DeviceContext_Unmap(renderer->base_device_context, (ID3D11Resource *)renderer->quad_instance_constants, 0);
+            ++stats->map_count;
+            stats->map_bytes += sizeof(u32);
+        }
+        
+        ID3D11DeviceContext_DrawInstanced(renderer->base_device_context, 4, range_count, 0, 0);
+        ++stats->draw_instanced_count;
+        quads_to_draw -= range_count;
+    }
+    
+    ProfileEnd("draw submission");
+    stats->quad_buffer_capacity = renderer->quad_sb_capacity;
+    stats->vertex_buffer_capacity = renderer->render_batch_vertex_capacity;
+    
+    // NOTE(christian): fence this frame's slice of the ring. if every slot is busy wait for the oldest.
+    if (renderer->frames_in_flight == d3d11_frames_in_flight)
+    {
+        D3D11_RetireFrames(renderer, True);
+    }
+    
+    u32 fence_index = (renderer->oldest_frame_in_flight + renderer->frames_in_flight) % d3d11_frames_in_flight;
+    ID3D11DeviceContext_End(renderer->base_device_context, (ID3D11Asynchronous *)renderer->frame_fences[fence_index]);
+    renderer->frame_fence_ring_heads[fence_index] = renderer->quad_ring_head;
+    ++renderer->frames_in_flight;
+    
+    ProfileBegin("present");
+    IDXGISwapChain1_Present(renderer->dxgi_swap_chain, 1, 0);
+    ProfileEnd("present");
+}
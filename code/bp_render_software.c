@@ -0,0 +1,1421 @@
+//~ NOTE(christian): software rasterizer
+// NOTE(christian): draws the same Quad_Render_Batch / Render_Batch the d3d11 backend gets, into a
+// render_target_width x render_target_height buffer, for machines without a gpu. the target is kept
+// as one f32 plane per channel in linear space (what the _SRGB render target blends in) and gets
+// resolved to sRGB RGBA8 at the end of the frame. spans are lane_width pixels wide and always start
+// on a multiple of lane_width, so the width must be one too.
+//
+// with more than one job thread and processor the frame is binned into sw_tile_size tiles first,
+// setting every primitive up once, and every tile is a job that clears, draws and resolves it. per
+// pixel maths never looks at the clip rect and each tile sees its primitives in submission order, so
+// the output is bit-identical to the single threaded path, which stays around as the reference.
+#define sw_srgb_table_count 4096
+#define sw_tile_size 32
+#define sw_bin_arena_reserve GB(1)
+
+typedef struct SW_Rect
+{
+    s32 min_x;
+    s32 min_y;
+    s32 max_x; // exclusive
+    s32 max_y; // exclusive
+} SW_Rect;
+
+typedef enum SW_Primitive_Kind
+{
+    SW_PrimitiveKind_Point,
+    SW_PrimitiveKind_Line,
+    SW_PrimitiveKind_Triangle,
+    SW_PrimitiveKind_Quad,
+    // NOTE(christian): set up to nothing, a degenerate line, triangle or quad.
+    SW_PrimitiveKind_None,
+} SW_Primitive_Kind;
+
+typedef struct SW_Primitive
+{
+    SW_Primitive_Kind kind;
+    
+    // NOTE(christian): inclusive tile range the primitive can touch.
+    u16 tile_min_x;
+    u16 tile_min_y;
+    u16 tile_max_x;
+    u16 tile_max_y;
+    
+    // NOTE(christian): first Render_Per_Vertex_Data for points, lines and triangles, the Quad for quads.
+    void *data;
+} SW_Primitive;
+
+// NOTE(christian): what the draw functions work out once per primitive before touching pixels.
+// triangles are wound so the area is positive.
+typedef struct SW_Triangle_Setup
+{
+    v2f vertices[3];
+    v4f colours[3];
+    f32 inverse_area;
+    // NOTE(christian): bit i is set when the edge opposite vertex i is a top or left edge.
+    u32 top_left_edges;
+} SW_Triangle_Setup;
+
+typedef struct SW_Line_Setup
+{
+    SW_Triangle_Setup triangles[2];
+    u32 triangle_count;
+} SW_Line_Setup;
+
+typedef struct SW_Quad_Setup
+{
+    v2f origin;
+    v2f u_from;
+    v2f v_from;
+    v2f min;
+    v2f max;
+    v2f center;
+    v2f round_half_dim;
+    f32 round_roundness;
+    v2f outline_half_dim;
+    f32 outline_roundness;
+    v2f uv_min;
+    v2f uv_extent;
+    b32 uniform_colour;
+    b32 rounded;
+    b32 outlined;
+    b32 has_uv;
+    v4f colours[4];
+} SW_Quad_Setup;
+
+// NOTE(christian): a tile's copy of a primitive, set up once while binning. every tile the
+// primitive touches draws from the same setup, so the results match the untiled path.
+typedef struct SW_Binned_Primitive
+{
+    SW_Primitive_Kind kind;
+    union
+    {
+        Render_Per_Vertex_Data point;
+        SW_Line_Setup line;
+        SW_Triangle_Setup triangle;
+        SW_Quad_Setup quad;
+    };
+} SW_Binned_Primitive;
+
+typedef struct SW_Renderer
+{
+    u32 width;
+    u32 height;
+    
+    // NOTE(christian): premultiplied, linear.
+    f32 *red;
+    f32 *green;
+    f32 *blue;
+    f32 *alpha;
+    
+    // NOTE(christian): resolved frame, R G B A bytes in memory order.
+    u32 *pixels;
+    
+    u8 srgb_from_linear[sw_srgb_table_count];
+    
+    // NOTE(christian): what textured quads sample, point filtered and clamped like the d3d11 sampler.
+    // null draws them untextured.
+    Glyph_Atlas *glyph_atlas;
+    
+    // NOTE(christian): tiling. bins are rebuilt every frame in bin_arena. primitives has a slot for
+    // every vertex and quad, tile t owns tile_primitives[tile_offsets[t], tile_offsets[t + 1]), set up
+    // copies of the slots that touch it. null jobs means untiled.
+    Job_System *jobs;
+    u32 tile_count_x;
+    u32 tile_count_y;
+    u32 tile_count;
+    Memory_Arena bin_arena;
+    SW_Primitive *primitives;
+    u32 primitive_count;
+    u32 *tile_offsets;
+    SW_Binned_Primitive *tile_primitives;
+} SW_Renderer;
+
+global f32 sw_lane_offsets[8] = { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+
+function b32
+SW_RendererInit(SW_Renderer *renderer, Memory_Arena *arena, u32 width, u32 height, Job_System *jobs,
+                Glyph_Atlas *glyph_atlas)
+{
+    Assert((width % lane_width) == 0);
+    renderer->glyph_atlas = glyph_atlas;
+    
+    // NOTE(christian): planes are cache line aligned so tiles (128 bytes of a row) never share a line.
+    u32 pixel_count = width * height;
+    renderer->width = width;
+    renderer->height = height;
+    renderer->red = (f32 *)MemoryArena_PushAligned(arena, sizeof(f32) * pixel_count, 64);
+    renderer->green = (f32 *)MemoryArena_PushAligned(arena, sizeof(f32) * pixel_count, 64);
+    renderer->blue = (f32 *)MemoryArena_PushAligned(arena, sizeof(f32) * pixel_count, 64);
+    renderer->alpha = (f32 *)MemoryArena_PushAligned(arena, sizeof(f32) * pixel_count, 64);
+    renderer->pixels = (u32 *)MemoryArena_PushAligned(arena, sizeof(u32) * pixel_count, 64);
+    if (renderer->pixels)
+    {
+        MemoryZero(renderer->pixels, sizeof(u32) * pixel_count);
+    }
+    
+    renderer->tile_count_x = (width + sw_tile_size - 1) / sw_tile_size;
+    renderer->tile_count_y = (height + sw_tile_size - 1) / sw_tile_size;
+    renderer->tile_count = renderer->tile_count_x * renderer->tile_count_y;
+    
+    // NOTE(christian): tiling only pays off with another processor to share the tiles with. on one the
+    // binning costs more than the tiles save (bench scene: ~26ms tiled against ~19ms straight through),
+    // however many job threads there are.
+    u32 processor_count = OS_GetProcessorCount();
+    if (jobs && (Min(jobs->thread_count, processor_count) > 1) &&
+        MemoryArena_Init(&renderer->bin_arena, sw_bin_arena_reserve))
+    {
+        renderer->jobs = jobs;
+    }
+    
+    for (u32 entry_index = 0; entry_index < sw_srgb_table_count; ++entry_index)
+    {
+        f64 linear = (f64)entry_index / (f64)(sw_srgb_table_count - 1);
+        f64 srgb = (linear <= 0.0031308) ? (linear * 12.92) : (1.055 * pow(linear, 1.0 / 2.4) - 0.055);
+        renderer->srgb_from_linear[entry_index] = (u8)(srgb * 255.0 + 0.5);
+    }
+    
+    return(renderer->red && renderer->pixels);
+}
+
+inline SW_Rect
+SW_RendererFullRect(SW_Renderer *renderer)
+{
+    SW_Rect result = { 0, 0, (s32)renderer->width, (s32)renderer->height };
+    return(result);
+}
+
+function void
+SW_Clear(SW_Renderer *renderer, SW_Rect clip, v4f colour)
+{
+    for (s32 y = clip.min_y; y < clip.max_y; ++y)
+    {
+        u32 row = (u32)y * renderer->width;
+        for (s32 x = clip.min_x; x < clip.max_x; ++x)
+        {
+            renderer->red[row + x] = colour.r;
+            renderer->green[row + x] = colour.g;
+            renderer->blue[row + x] = colour.b;
+            renderer->alpha[row + x] = colour.a;
+        }
+    }
+}
+
+// NOTE(christian): ONE, INV_SRC_ALPHA. the pixel shaders output pow(colour, 2.2) in every channel, alpha included.
+inline void
+SW_BlendSpan(SW_Renderer *renderer, u32 pixel_index, lane_u32 mask,
+             lane_f32 red, lane_f32 green, lane_f32 blue, lane_f32 alpha)
+{
+    lane_f32 gamma = LaneF32_Set1(2.2f);
+    red = LaneF32_PowApprox(red, gamma);
+    green = LaneF32_PowApprox(green, gamma);
+    blue = LaneF32_PowApprox(blue, gamma);
+    alpha = LaneF32_PowApprox(alpha, gamma);
+    
+    lane_f32 inverse_alpha = LaneF32_Subtract(LaneF32_Set1(1.0f), alpha);
+    
+    lane_f32 dest_red = LaneF32_Load(renderer->red + pixel_index);
+    lane_f32 dest_green = LaneF32_Load(renderer->green + pixel_index);
+    lane_f32 dest_blue = LaneF32_Load(renderer->blue + pixel_index);
+    lane_f32 dest_alpha = LaneF32_Load(renderer->alpha + pixel_index);
+    
+    LaneF32_Store(renderer->red + pixel_index, LaneF32_Select(mask, LaneF32_MulAdd(dest_red, inverse_alpha, red), dest_red));
+    LaneF32_Store(renderer->green + pixel_index, LaneF32_Select(mask, LaneF32_MulAdd(dest_green, inverse_alpha, green), dest_green));
+    LaneF32_Store(renderer->blue + pixel_index, LaneF32_Select(mask, LaneF32_MulAdd(dest_blue, inverse_alpha, blue), dest_blue));
+    LaneF32_Store(renderer->alpha + pixel_index, LaneF32_Select(mask, LaneF32_MulAdd(dest_alpha, inverse_alpha, alpha), dest_alpha));
+}
+
+// NOTE(christian): pixel range whose centers fall in [min, max], clipped and widened to whole spans.
+inline b32
+SW_SpanBounds(SW_Rect clip, f32 min_x, f32 min_y, f32 max_x, f32 max_y, SW_Rect *out)
+{
+    // NOTE(christian): clamp first so far off-screen geometry can't overflow the int conversion.
+    min_x = Clamp((f32)clip.min_x - 1.0f, min_x, (f32)clip.max_x + 1.0f);
+    max_x = Clamp((f32)clip.min_x - 1.0f, max_x, (f32)clip.max_x + 1.0f);
+    min_y = Clamp((f32)clip.min_y - 1.0f, min_y, (f32)clip.max_y + 1.0f);
+    max_y = Clamp((f32)clip.min_y - 1.0f, max_y, (f32)clip.max_y + 1.0f);
+    
+    s32 first_x = (s32)floorf(min_x - 0.5f);
+    s32 first_y = (s32)floorf(min_y - 0.5f);
+    s32 last_x = (s32)ceilf(max_x - 0.5f) + 1;
+    s32 last_y = (s32)ceilf(max_y - 0.5f) + 1;
+    
+    out->min_x = Max(first_x, clip.min_x) & ~(lane_width - 1);
+    out->min_y = Max(first_y, clip.min_y);
+    out->max_x = Min(last_x, clip.max_x);
+    out->max_y = Min(last_y, clip.max_y);
+    return((out->min_x < out->max_x) && (out->min_y < out->max_y));
+}
+
+// NOTE(christian): clip.min_x and clip.max_x have to be multiples of lane_width, spans never straddle them.
+inline lane_u32
+SW_ClipMask(SW_Rect clip, lane_f32 pixel_x)
+{
+    lane_u32 result = LaneU32_And(LaneF32_GreaterEqual(pixel_x, LaneF32_Set1((f32)clip.min_x)),
+                                  LaneF32_LessThan(pixel_x, LaneF32_Set1((f32)clip.max_x)));
+    return(result);
+}
+
+//~ NOTE(christian): quads, PSMain of main_shader.hlsl
+inline lane_f32
+SW_RoundedBoxSDF(lane_f32 sample_x, lane_f32 sample_y, lane_f32 center_x, lane_f32 center_y,
+                 lane_f32 half_dim_x, lane_f32 half_dim_y, lane_f32 roundness)
+{
+    lane_f32 zero = LaneF32_Set1(0.0f);
+    lane_f32 to_x = LaneF32_Add(LaneF32_Subtract(LaneF32_Abs(LaneF32_Subtract(center_x, sample_x)), half_dim_x), roundness);
+    lane_f32 to_y = LaneF32_Add(LaneF32_Subtract(LaneF32_Abs(LaneF32_Subtract(center_y, sample_y)), half_dim_y), roundness);
+    to_x = LaneF32_Max(to_x, zero);
+    to_y = LaneF32_Max(to_y, zero);
+    
+    lane_f32 length = LaneF32_Sqrt(LaneF32_MulAdd(to_x, to_x, LaneF32_Multiply(to_y, to_y)));
+    lane_f32 result = LaneF32_Subtract(length, roundness);
+    return(result);
+}
+
+// NOTE(christian): smoothstep(0, edge, x)
+inline lane_f32
+SW_SmoothStep(lane_f32 edge, lane_f32 x)
+{
+    lane_f32 t = LaneF32_Divide(x, edge);
+    t = LaneF32_Min(LaneF32_Max(t, LaneF32_Set1(0.0f)), LaneF32_Set1(1.0f));
+    lane_f32 result = LaneF32_Multiply(LaneF32_Multiply(t, t), LaneF32_Subtract(LaneF32_Set1(3.0f), LaneF32_Multiply(LaneF32_Set1(2.0f), t)));
+    return(result);
+}
+
+// NOTE(christian): texel floor(uv * dims), clamped. no gathers in the lane ops, so it goes through memory.
+inline lane_f32
+SW_SampleAtlas(Glyph_Atlas *atlas, lane_f32 uv_x, lane_f32 uv_y)
+{
+    f32 texel_x[lane_width];
+    f32 texel_y[lane_width];
+    f32 coverage[lane_width];
+    LaneF32_Store(texel_x, LaneF32_Multiply(uv_x, LaneF32_Set1((f32)atlas->width)));
+    LaneF32_Store(texel_y, LaneF32_Multiply(uv_y, LaneF32_Set1((f32)atlas->height)));
+    for (u32 lane_index = 0; lane_index < lane_width; ++lane_index)
+    {
+        s32 x = Clamp(0, (s32)floorf(texel_x[lane_index]), (s32)atlas->width - 1);
+        s32 y = Clamp(0, (s32)floorf(texel_y[lane_index]), (s32)atlas->height - 1);
+        coverage[lane_index] = (f32)atlas->texels[(u32)y * atlas->width + (u32)x] * (1.0f / 255.0f);
+    }
+    return(LaneF32_Load(coverage));
+}
+
+// NOTE(christian): everything SW_DrawQuadSetup needs that doesn't depend on the pixel. False when the
+// axes are degenerate and there's nothing to draw.
+function b32
+SW_SetupQuad(SW_Quad_Setup *setup, Quad *packed_quad)
+{
+    Quad_Unpacked unpacked = Quad_Unpack(packed_quad);
+    Quad_Unpacked *quad = &unpacked;
+    v2f origin = quad->origin;
+    v2f x_axis = quad->x_axis;
+    v2f y_axis = quad->y_axis;
+    f32 determinant = x_axis.x * y_axis.y - y_axis.x * x_axis.y;
+    if (determinant == 0.0f)
+    {
+        return(False);
+    }
+    
+    setup->min = V2F(origin.x + Min(x_axis.x, 0.0f) + Min(y_axis.x, 0.0f), origin.y + Min(x_axis.y, 0.0f) + Min(y_axis.y, 0.0f));
+    setup->max = V2F(origin.x + Max(x_axis.x, 0.0f) + Max(y_axis.x, 0.0f), origin.y + Max(x_axis.y, 0.0f) + Max(y_axis.y, 0.0f));
+    
+    // NOTE(christian): (u, v) = inverse(x_axis, y_axis) * (p - origin). the quad is a strip of two
+    // triangles, so colours are barycentric per triangle and not bilinear.
+    f32 inverse_determinant = 1.0f / determinant;
+    setup->origin = origin;
+    setup->u_from = V2F(y_axis.y * inverse_determinant, -y_axis.x * inverse_determinant);
+    setup->v_from = V2F(-x_axis.y * inverse_determinant, x_axis.x * inverse_determinant);
+    
+    setup->uniform_colour = (quad->flags & QuadFlag_UniformColour) != 0;
+    for (u32 vertex_index = 0; vertex_index < 4; ++vertex_index)
+    {
+        setup->colours[vertex_index] = quad->colours[vertex_index];
+    }
+    
+    f32 softness = 0.8f;
+    f32 softness_padding = softness * 2.0f - 1.0f;
+    v2f half_dim = V2F(x_axis.x * 0.5f, y_axis.y * 0.5f);
+    setup->center = V2F(origin.x + half_dim.x, origin.y + half_dim.y);
+    
+    setup->rounded = quad->side_roundness > 0.0f;
+    setup->round_half_dim = V2F(half_dim.x - softness_padding, half_dim.y - softness_padding);
+    setup->round_roundness = quad->side_roundness;
+    
+    setup->outlined = quad->side_thickness > 0.0f;
+    v2f reduced_half_dim = V2F(half_dim.x - quad->side_thickness, half_dim.y - quad->side_thickness);
+    f32 reduce_percent_sides = Min(reduced_half_dim.x / half_dim.x, reduced_half_dim.y / half_dim.y);
+    setup->outline_half_dim = V2F(reduced_half_dim.x - softness_padding, reduced_half_dim.y - softness_padding);
+    setup->outline_roundness = quad->side_roundness * reduce_percent_sides * reduce_percent_sides;
+    
+    // NOTE(christian): an empty uv rect samples the white texel, which is the same as not sampling.
+    setup->has_uv = (quad->uv_min.x != quad->uv_max.x) || (quad->uv_min.y != quad->uv_max.y);
+    setup->uv_min = quad->uv_min;
+    setup->uv_extent = V2F(quad->uv_max.x - quad->uv_min.x, quad->uv_max.y - quad->uv_min.y);
+    return(True);
+}
+
+function void
+SW_DrawQuadSetup(SW_Renderer *renderer, SW_Rect clip, SW_Quad_Setup *setup)
+{
+    SW_Rect bounds;
+    if (!SW_SpanBounds(clip, setup->min.x, setup->min.y, setup->max.x, setup->max.y, &bounds))
+    {
+        return;
+    }
+    
+    lane_f32 u_from_x = LaneF32_Set1(setup->u_from.x);
+    lane_f32 u_from_y = LaneF32_Set1(setup->u_from.y);
+    lane_f32 v_from_x = LaneF32_Set1(setup->v_from.x);
+    lane_f32 v_from_y = LaneF32_Set1(setup->v_from.y);
+    lane_f32 origin_x = LaneF32_Set1(setup->origin.x);
+    lane_f32 origin_y = LaneF32_Set1(setup->origin.y);
+    
+    lane_f32 zero = LaneF32_Set1(0.0f);
+    lane_f32 one = LaneF32_Set1(1.0f);
+    
+    b32 uniform_colour = setup->uniform_colour;
+    lane_f32 colours[4][4];
+    for (u32 vertex_index = 0; vertex_index < 4; ++vertex_index)
+    {
+        for (u32 channel_index = 0; channel_index < 4; ++channel_index)
+        {
+            colours[vertex_index][channel_index] = LaneF32_Set1(setup->colours[vertex_index].v[channel_index]);
+        }
+    }
+    
+    f32 softness = 0.8f;
+    lane_f32 center_x = LaneF32_Set1(setup->center.x);
+    lane_f32 center_y = LaneF32_Set1(setup->center.y);
+    
+    b32 rounded = setup->rounded;
+    lane_f32 round_half_dim_x = LaneF32_Set1(setup->round_half_dim.x);
+    lane_f32 round_half_dim_y = LaneF32_Set1(setup->round_half_dim.y);
+    lane_f32 round_roundness = LaneF32_Set1(setup->round_roundness);
+    lane_f32 round_edge = LaneF32_Set1(softness * 2 - 1.25f);
+    
+    b32 outlined = setup->outlined;
+    lane_f32 outline_half_dim_x = LaneF32_Set1(setup->outline_half_dim.x);
+    lane_f32 outline_half_dim_y = LaneF32_Set1(setup->outline_half_dim.y);
+    lane_f32 outline_roundness = LaneF32_Set1(setup->outline_roundness);
+    lane_f32 outline_edge = LaneF32_Set1(softness * 0.05f);
+    
+    Glyph_Atlas *atlas = renderer->glyph_atlas;
+    b32 textured = atlas && setup->has_uv;
+    lane_f32 uv_min_x = LaneF32_Set1(setup->uv_min.x);
+    lane_f32 uv_min_y = LaneF32_Set1(setup->uv_min.y);
+    lane_f32 uv_extent_x = LaneF32_Set1(setup->uv_extent.x);
+    lane_f32 uv_extent_y = LaneF32_Set1(setup->uv_extent.y);
+    
+    for (s32 y = bounds.min_y; y < bounds.max_y; ++y)
+    {
+        lane_f32 pixel_y = LaneF32_Set1((f32)y + 0.5f);
+        lane_f32 relative_y = LaneF32_Subtract(pixel_y, origin_y);
+        for (s32 x = bounds.min_x; x < bounds.max_x; x += lane_width)
+        {
+            lane_f32 pixel_x = LaneF32_Add(LaneF32_Load(sw_lane_offsets), LaneF32_Set1((f32)x));
+            lane_u32 mask = SW_ClipMask(clip, pixel_x);
+            pixel_x = LaneF32_Add(pixel_x, LaneF32_Set1(0.5f));
+            
+            lane_f32 relative_x = LaneF32_Subtract(pixel_x, origin_x);
+            lane_f32 u = LaneF32_MulAdd(u_from_x, relative_x, LaneF32_Multiply(u_from_y, relative_y));
+            lane_f32 v = LaneF32_MulAdd(v_from_x, relative_x, LaneF32_Multiply(v_from_y, relative_y));
+            mask = LaneU32_And(mask, LaneU32_And(LaneF32_GreaterEqual(u, zero), LaneF32_LessThan(u, one)));
+            mask = LaneU32_And(mask, LaneU32_And(LaneF32_GreaterEqual(v, zero), LaneF32_LessThan(v, one)));
+            if (!LaneU32_AnyNonZero(mask))
+            {
+                continue;
+            }
+            
+            // NOTE(christian): strip triangles are (0, 1, 2) below the diagonal and (2, 1, 3) above it.
+            // a uniform colour comes out of that as itself, so it skips the interpolation.
+            lane_f32 colour[4];
+            if (uniform_colour)
+            {
+                for (u32 channel_index = 0; channel_index < 4; ++channel_index)
+                {
+                    colour[channel_index] = colours[0][channel_index];
+                }
+            }
+            else
+            {
+                lane_u32 lower = LaneF32_LessThan(LaneF32_Add(u, v), one);
+                lane_f32 inverse_u = LaneF32_Subtract(one, u);
+                lane_f32 inverse_v = LaneF32_Subtract(one, v);
+                for (u32 channel_index = 0; channel_index < 4; ++channel_index)
+                {
+                    lane_f32 c0 = colours[0][channel_index];
+                    lane_f32 c1 = colours[1][channel_index];
+                    lane_f32 c2 = colours[2][channel_index];
+                    lane_f32 c3 = colours[3][channel_index];
+                    lane_f32 lower_colour = LaneF32_MulAdd(LaneF32_Subtract(c2, c0), v,
+                                                           LaneF32_MulAdd(LaneF32_Subtract(c1, c0), u, c0));
+                    lane_f32 upper_colour = LaneF32_MulAdd(LaneF32_Subtract(c2, c3), inverse_u,
+                                                           LaneF32_MulAdd(LaneF32_Subtract(c1, c3), inverse_v, c3));
+                    colour[channel_index] = LaneF32_Select(lower, lower_colour, upper_colour);
+                }
+            }
+            
+            lane_f32 coverage = one;
+            if (rounded)
+            {
+                lane_f32 signed_dist = SW_RoundedBoxSDF(pixel_x, pixel_y, center_x, center_y,
+                                                        round_half_dim_x, round_half_dim_y, round_roundness);
+                signed_dist = LaneF32_Subtract(signed_dist, LaneF32_Set1(0.25f));
+                coverage = LaneF32_Subtract(one, SW_SmoothStep(round_edge, signed_dist));
+            }
+            
+            if (outlined)
+            {
+                lane_f32 signed_dist = SW_RoundedBoxSDF(pixel_x, pixel_y, center_x, center_y,
+                                                        outline_half_dim_x, outline_half_dim_y, outline_roundness);
+                signed_dist = LaneF32_Add(signed_dist, LaneF32_Set1(0.30f));
+                coverage = LaneF32_Multiply(coverage, SW_SmoothStep(outline_edge, signed_dist));
+            }
+            
+            if (textured)
+            {
+                coverage = LaneF32_Multiply(coverage, SW_SampleAtlas(atlas, LaneF32_MulAdd(uv_extent_x, u, uv_min_x),
+                                                                     LaneF32_MulAdd(uv_extent_y, v, uv_min_y)));
+            }
+            
+            u32 pixel_index = (u32)y * renderer->width + (u32)x;
+            SW_BlendSpan(renderer, pixel_index, mask,
+                         LaneF32_Multiply(colour[0], coverage), LaneF32_Multiply(colour[1], coverage),
+                         LaneF32_Multiply(colour[2], coverage), LaneF32_Multiply(colour[3], coverage));
+        }
+    }
+}
+
+function void
+SW_DrawQuad(SW_Renderer *renderer, SW_Rect clip, Quad *packed_quad)
+{
+    SW_Quad_Setup setup;
+    if (SW_SetupQuad(&setup, packed_quad))
+    {
+        SW_DrawQuadSetup(renderer, clip, &setup);
+    }
+}
+
+//~ NOTE(christian): immediate primitives, PSMain of immediate_render.hlsl
+// NOTE(christian): edge functions with the d3d top-left fill rule. both windings are drawn (CULL_NONE).
+inline b32
+SW_IsTopLeftEdge(v2f a, v2f b)
+{
+    v2f edge = V2F_Subtract(b, a);
+    b32 result = ((edge.y == 0.0f) && (edge.x > 0.0f)) || (edge.y < 0.0f);
+    return(result);
+}
+
+inline lane_u32
+SW_EdgeInside(lane_f32 w, b32 top_left)
+{
+    lane_f32 zero = LaneF32_Set1(0.0f);
+    lane_u32 result = top_left ? LaneF32_GreaterEqual(w, zero) : LaneF32_GreaterThan(w, zero);
+    return(result);
+}
+
+// NOTE(christian): False when the triangle has no area.
+function b32
+SW_SetupTriangle(SW_Triangle_Setup *setup, Render_Per_Vertex_Data *v0, Render_Per_Vertex_Data *v1, Render_Per_Vertex_Data *v2)
+{
+    v2f p0 = v0->vertex;
+    v2f p1 = v1->vertex;
+    v2f p2 = v2->vertex;
+    f32 area = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+    if (area == 0.0f)
+    {
+        return(False);
+    }
+    
+    if (area < 0.0f)
+    {
+        Render_Per_Vertex_Data *swap = v1;
+        v1 = v2;
+        v2 = swap;
+        p1 = v1->vertex;
+        p2 = v2->vertex;
+        area = -area;
+    }
+    
+    setup->vertices[0] = p0;
+    setup->vertices[1] = p1;
+    setup->vertices[2] = p2;
+    setup->colours[0] = v0->colour;
+    setup->colours[1] = v1->colour;
+    setup->colours[2] = v2->colour;
+    setup->inverse_area = 1.0f / area;
+    
+    // NOTE(christian): w_i is the edge opposite vertex i: (b - a) x (p - a).
+    setup->top_left_edges = 0;
+    for (u32 edge_index = 0; edge_index < 3; ++edge_index)
+    {
+        v2f a = setup->vertices[(edge_index + 1) % 3];
+        v2f b = setup->vertices[(edge_index + 2) % 3];
+        setup->top_left_edges |= SW_IsTopLeftEdge(a, b) << edge_index;
+    }
+    return(True);
+}
+
+function void
+SW_DrawTriangleSetup(SW_Renderer *renderer, SW_Rect clip, SW_Triangle_Setup *setup)
+{
+    v2f p0 = setup->vertices[0];
+    v2f p1 = setup->vertices[1];
+    v2f p2 = setup->vertices[2];
+    SW_Rect bounds;
+    if (!SW_SpanBounds(clip,
+                       Min(p0.x, Min(p1.x, p2.x)), Min(p0.y, Min(p1.y, p2.y)),
+                       Max(p0.x, Max(p1.x, p2.x)), Max(p0.y, Max(p1.y, p2.y)), &bounds))
+    {
+        return;
+    }
+    
+    lane_f32 edge_dx[3];
+    lane_f32 edge_dy[3];
+    lane_f32 edge_ax[3];
+    lane_f32 edge_ay[3];
+    b32 top_left[3];
+    for (u32 edge_index = 0; edge_index < 3; ++edge_index)
+    {
+        v2f a = setup->vertices[(edge_index + 1) % 3];
+        v2f b = setup->vertices[(edge_index + 2) % 3];
+        edge_dx[edge_index] = LaneF32_Set1(b.x - a.x);
+        edge_dy[edge_index] = LaneF32_Set1(b.y - a.y);
+        edge_ax[edge_index] = LaneF32_Set1(a.x);
+        edge_ay[edge_index] = LaneF32_Set1(a.y);
+        top_left[edge_index] = (setup->top_left_edges >> edge_index) & 1;
+    }
+    
+    lane_f32 inverse_area = LaneF32_Set1(setup->inverse_area);
+    lane_f32 colours[3][4];
+    for (u32 vertex_index = 0; vertex_index < 3; ++vertex_index)
+    {
+        for (u32 channel_index = 0; channel_index < 4; ++channel_index)
+        {
+            colours[vertex_index][channel_index] = LaneF32_Set1(setup->colours[vertex_index].v[channel_index]);
+        }
+    }
+    
+    for (s32 y = bounds.min_y; y < bounds.max_y; ++y)
+    {
+        lane_f32 pixel_y = LaneF32_Set1((f32)y + 0.5f);
+        for (s32 x = bounds.min_x; x < bounds.max_x; x += lane_width)
+        {
+            lane_f32 pixel_x = LaneF32_Add(LaneF32_Load(sw_lane_offsets), LaneF32_Set1((f32)x));
+            lane_u32 mask = SW_ClipMask(clip, pixel_x);
+            pixel_x = LaneF32_Add(pixel_x, LaneF32_Set1(0.5f));
+            
+            lane_f32 weights[3];
+            for (u32 edge_index = 0; edge_index < 3; ++edge_index)
+            {
+                lane_f32 w = LaneF32_Subtract(LaneF32_Multiply(edge_dx[edge_index], LaneF32_Subtract(pixel_y, edge_ay[edge_index])),
+                                              LaneF32_Multiply(edge_dy[edge_index], LaneF32_Subtract(pixel_x, edge_ax[edge_index])));
+                mask = LaneU32_And(mask, SW_EdgeInside(w, top_left[edge_index]));
+                weights[edge_index] = LaneF32_Multiply(w, inverse_area);
+            }
+            
+            if (!LaneU32_AnyNonZero(mask))
+            {
+                continue;
+            }
+            
+            lane_f32 colour[4];
+            for (u32 channel_index = 0; channel_index < 4; ++channel_index)
+            {
+                colour[channel_index] = LaneF32_MulAdd(weights[2], colours[2][channel_index],
+                                                       LaneF32_MulAdd(weights[1], colours[1][channel_index],
+                                                                      LaneF32_Multiply(weights[0], colours[0][channel_index])));
+            }
+            
+            u32 pixel_index = (u32)y * renderer->width + (u32)x;
+            SW_BlendSpan(renderer, pixel_index, mask, colour[0], colour[1], colour[2], colour[3]);
+        }
+    }
+}
+
+function void
+SW_DrawTriangle(SW_Renderer *renderer, SW_Rect clip, Render_Per_Vertex_Data *v0, Render_Per_Vertex_Data *v1, Render_Per_Vertex_Data *v2)
+{
+    SW_Triangle_Setup setup;
+    if (SW_SetupTriangle(&setup, v0, v1, v2))
+    {
+        SW_DrawTriangleSetup(renderer, clip, &setup);
+    }
+}
+
+// NOTE(christian): a one pixel wide rectangle along the segment, rasterized as two triangles.
+// d3d's diamond-exit rule for aliased lines isn't reproduced exactly, ends can differ by a pixel.
+// False when neither triangle has any area.
+function b32
+SW_SetupLine(SW_Line_Setup *setup, Render_Per_Vertex_Data *start, Render_Per_Vertex_Data *end)
+{
+    setup->triangle_count = 0;
+    v2f direction = V2F_Subtract(end->vertex, start->vertex);
+    f32 length = sqrtf(direction.x * direction.x + direction.y * direction.y);
+    if (length > 0.0f)
+    {
+        v2f half_normal = V2F(-direction.y * (0.5f / length), direction.x * (0.5f / length));
+        Render_Per_Vertex_Data corners[4];
+        corners[0].vertex = V2F_Add(start->vertex, half_normal);
+        corners[0].colour = start->colour;
+        corners[1].vertex = V2F_Subtract(start->vertex, half_normal);
+        corners[1].colour = start->colour;
+        corners[2].vertex = V2F_Add(end->vertex, half_normal);
+        corners[2].colour = end->colour;
+        corners[3].vertex = V2F_Subtract(end->vertex, half_normal);
+        corners[3].colour = end->colour;
+        
+        setup->triangle_count += SW_SetupTriangle(setup->triangles + setup->triangle_count, corners + 0, corners + 1, corners + 2);
+        setup->triangle_count += SW_SetupTriangle(setup->triangles + setup->triangle_count, corners + 2, corners + 1, corners + 3);
+    }
+    return(setup->triangle_count > 0);
+}
+
+function void
+SW_DrawLineSetup(SW_Renderer *renderer, SW_Rect clip, SW_Line_Setup *setup)
+{
+    for (u32 triangle_index = 0; triangle_index < setup->triangle_count; ++triangle_index)
+    {
+        SW_DrawTriangleSetup(renderer, clip, setup->triangles + triangle_index);
+    }
+}
+
+function void
+SW_DrawLine(SW_Renderer *renderer, SW_Rect clip, Render_Per_Vertex_Data *start, Render_Per_Vertex_Data *end)
+{
+    SW_Line_Setup setup;
+    if (SW_SetupLine(&setup, start, end))
+    {
+        SW_DrawLineSetup(renderer, clip, &setup);
+    }
+}
+
+function void
+SW_DrawPoint(SW_Renderer *renderer, SW_Rect clip, Render_Per_Vertex_Data *point)
+{
+    s32 x = (s32)floorf(point->vertex.x);
+    s32 y = (s32)floorf(point->vertex.y);
+    if ((x >= clip.min_x) && (x < clip.max_x) && (y >= clip.min_y) && (y < clip.max_y))
+    {
+        s32 span_x = x & ~(lane_width - 1);
+        lane_f32 lane_x = LaneF32_Add(LaneF32_Load(sw_lane_offsets), LaneF32_Set1((f32)span_x));
+        lane_u32 mask = LaneU32_And(LaneF32_GreaterEqual(lane_x, LaneF32_Set1((f32)x)),
+                                    LaneF32_LessThan(lane_x, LaneF32_Set1((f32)x + 1.0f)));
+        
+        v4f colour = point->colour;
+        SW_BlendSpan(renderer, (u32)y * renderer->width + (u32)span_x, mask,
+                     LaneF32_Set1(colour.r), LaneF32_Set1(colour.g), LaneF32_Set1(colour.b), LaneF32_Set1(colour.a));
+    }
+}
+
+function void
+SW_DrawRenderBatch(SW_Renderer *renderer, SW_Rect clip, Render_Batch *render_batch)
+{
+    for (u32 draw_call_index = 0; draw_call_index < render_batch->draw_call_count; ++draw_call_index)
+    {
+        Render_Draw_Call *draw_call = render_batch->draw_calls + draw_call_index;
+        Render_Per_Vertex_Data *vertices = render_batch->vertices;
+        u32 end_index = draw_call->vertex_array_end_index;
+        switch (draw_call->primitive_kind)
+        {
+            case RenderPrimitiveKind_Point:
+            {
+                for (u32 vertex_index = draw_call->vertex_array_base_index; vertex_index < end_index; ++vertex_index)
+                {
+                    SW_DrawPoint(renderer, clip, vertices + vertex_index);
+                }
+            } break;
+            
+            case RenderPrimitiveKind_Line:
+            {
+                for (u32 vertex_index = draw_call->vertex_array_base_index; (vertex_index + 1) < end_index; vertex_index += 2)
+                {
+                    SW_DrawLine(renderer, clip, vertices + vertex_index, vertices + vertex_index + 1);
+                }
+            } break;
+            
+            case RenderPrimitiveKind_Triangle:
+            {
+                for (u32 vertex_index = draw_call->vertex_array_base_index; (vertex_index + 2) < end_index; vertex_index += 3)
+                {
+                    Render_Per_Vertex_Data *triangle = vertices + vertex_index;
+                    if (draw_call->filled)
+                    {
+                        SW_DrawTriangle(renderer, clip, triangle + 0, triangle + 1, triangle + 2);
+                    }
+                    else
+                    {
+                        SW_DrawLine(renderer, clip, triangle + 0, triangle + 1);
+                        SW_DrawLine(renderer, clip, triangle + 1, triangle + 2);
+                        SW_DrawLine(renderer, clip, triangle + 2, triangle + 0);
+                    }
+                }
+            } break;
+            
+            default:
+            {
+                InvalidCodePath();
+            } break;
+        }
+    }
+}
+
+function void
+SW_DrawQuadBatch(SW_Renderer *renderer, SW_Rect clip, Quad_Render_Batch *quad_render_batch)
+{
+    for (Quad_Render_Chunk *chunk = quad_render_batch->first_chunk;
+         chunk && chunk->quads_drawn;
+         chunk = chunk->next)
+    {
+        for (u32 quad_index = 0; quad_index < chunk->quads_drawn; ++quad_index)
+        {
+            SW_DrawQuad(renderer, clip, chunk->quads + quad_index);
+        }
+    }
+}
+
+function void
+SW_Resolve(SW_Renderer *renderer, SW_Rect clip)
+{
+    f32 table_scale = (f32)(sw_srgb_table_count - 1);
+    for (s32 y = clip.min_y; y < clip.max_y; ++y)
+    {
+        u32 row = (u32)y * renderer->width;
+        for (s32 x = clip.min_x; x < clip.max_x; ++x)
+        {
+            u32 pixel_index = row + (u32)x;
+            f32 channels[4] = { renderer->red[pixel_index], renderer->green[pixel_index],
+                renderer->blue[pixel_index], renderer->alpha[pixel_index] };
+            
+            u8 *out = (u8 *)(renderer->pixels + pixel_index);
+            for (u32 channel_index = 0; channel_index < 3; ++channel_index)
+            {
+                f32 linear = Clamp(0.0f, channels[channel_index], 1.0f);
+                out[channel_index] = renderer->srgb_from_linear[(u32)(linear * table_scale + 0.5f)];
+            }
+            
+            // NOTE(christian): alpha isn't gamma encoded by an _SRGB target.
+            out[3] = (u8)(Clamp(0.0f, channels[3], 1.0f) * 255.0f + 0.5f);
+        }
+    }
+}
+
+//~ NOTE(christian): tile binning
+// NOTE(christian): every vertex of the render batch and every quad owns one primitive slot, vertices
+// first, so slot order is submission order (the order SW_DrawRenderBatch / SW_DrawQuadBatch draw in).
+// a point, a line's first vertex and a filled triangle's first vertex hold their primitive, the other
+// slots stay empty. an unfilled triangle is three lines, one in each of its vertices' slots.
+//
+// slots are binned in batches the way SpatialGrid_BuildParallel builds cells: every batch fills in
+// its slots and counts its tiles in a job, a serial pass turns the counts into where each batch
+// starts writing each tile, and every batch scatters its slots in a job. bins list batches in order
+// and slots in order within a batch, so every tile still sees its primitives in submission order.
+// a quad batch is one chunk of the quad batch, a vertex batch is as many vertices.
+#define sw_bin_batch_size quad_render_chunk_capacity
+
+typedef struct SW_Bin_Job
+{
+    SW_Renderer *renderer;
+    Render_Batch *render_batch;
+    Quad_Render_Chunk **quad_chunks;
+    u32 vertex_batch_count;
+    // NOTE(christian): batch b's count (then cursor) for tile t is batch_tile_cursors[b * tile_count + t].
+    u32 *batch_tile_cursors;
+    // NOTE(christian): the closing edge of an unfilled triangle points back at its first vertex, so it
+    // can't be a (start, start + 1) line in the batch. slot s gets its copy in closing_lines[2s].
+    Render_Per_Vertex_Data *closing_lines;
+} SW_Bin_Job;
+
+// NOTE(christian): an empty tile range, so the slot is in no bin.
+inline void
+SW_SetEmptyPrimitive(SW_Renderer *renderer, u32 slot)
+{
+    SW_Primitive *primitive = renderer->primitives + slot;
+    primitive->kind = SW_PrimitiveKind_Point;
+    primitive->tile_min_x = 1;
+    primitive->tile_min_y = 1;
+    primitive->tile_max_x = 0;
+    primitive->tile_max_y = 0;
+    primitive->data = null;
+}
+
+inline void
+SW_SetPrimitive(SW_Renderer *renderer, u32 slot, SW_Primitive_Kind kind, void *data,
+                f32 min_x, f32 min_y, f32 max_x, f32 max_y)
+{
+    // NOTE(christian): the same span bounds the draw functions compute, so bins are conservative.
+    SW_Rect bounds;
+    if (SW_SpanBounds(SW_RendererFullRect(renderer), min_x, min_y, max_x, max_y, &bounds))
+    {
+        SW_Primitive *primitive = renderer->primitives + slot;
+        primitive->kind = kind;
+        primitive->tile_min_x = (u16)(bounds.min_x / sw_tile_size);
+        primitive->tile_min_y = (u16)(bounds.min_y / sw_tile_size);
+        primitive->tile_max_x = (u16)((bounds.max_x - 1) / sw_tile_size);
+        primitive->tile_max_y = (u16)((bounds.max_y - 1) / sw_tile_size);
+        primitive->data = data;
+    }
+    else
+    {
+        SW_SetEmptyPrimitive(renderer, slot);
+    }
+}
+
+inline void
+SW_SetLinePrimitive(SW_Renderer *renderer, u32 slot, Render_Per_Vertex_Data *start, Render_Per_Vertex_Data *end)
+{
+    // NOTE(christian): lines are drawn half a pixel either side of the segment.
+    v2f a = start->vertex;
+    v2f b = end->vertex;
+    SW_SetPrimitive(renderer, slot, SW_PrimitiveKind_Line, start,
+                    Min(a.x, b.x) - 1.0f, Min(a.y, b.y) - 1.0f, Max(a.x, b.x) + 1.0f, Max(a.y, b.y) + 1.0f);
+}
+
+// NOTE(christian): draw calls cover ascending, disjoint vertex ranges. this is the last one starting
+// at or before vertex_index, or draw_call_count if there is none.
+function u32
+SW_FindDrawCall(Render_Batch *render_batch, u32 vertex_index)
+{
+    u32 low = 0;
+    u32 high = render_batch->draw_call_count;
+    while (low < high)
+    {
+        u32 middle = low + (high - low) / 2;
+        if (render_batch->draw_calls[middle].vertex_array_base_index <= vertex_index)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    u32 result = low ? (low - 1) : render_batch->draw_call_count;
+    return(result);
+}
+
+function void
+SW_FillVertexSlots(SW_Bin_Job *job, u32 first, u32 one_past_last)
+{
+    SW_Renderer *renderer = job->renderer;
+    Render_Batch *render_batch = job->render_batch;
+    Render_Per_Vertex_Data *vertices = render_batch->vertices;
+    u32 draw_call_index = SW_FindDrawCall(render_batch, first);
+    for (u32 vertex_index = first; vertex_index < one_past_last; ++vertex_index)
+    {
+        while ((draw_call_index < render_batch->draw_call_count) &&
+               (render_batch->draw_calls[draw_call_index].vertex_array_end_index <= vertex_index))
+        {
+            ++draw_call_index;
+        }
+        
+        Render_Draw_Call *draw_call = (draw_call_index < render_batch->draw_call_count) ? (render_batch->draw_calls + draw_call_index) : null;
+        if (!draw_call || (vertex_index < draw_call->vertex_array_base_index))
+        {
+            SW_SetEmptyPrimitive(renderer, vertex_index);
+            continue;
+        }
+        
+        u32 base_index = draw_call->vertex_array_base_index;
+        u32 end_index = draw_call->vertex_array_end_index;
+        switch (draw_call->primitive_kind)
+        {
+            case RenderPrimitiveKind_Point:
+            {
+                v2f p = vertices[vertex_index].vertex;
+                SW_SetPrimitive(renderer, vertex_index, SW_PrimitiveKind_Point, vertices + vertex_index,
+                                floorf(p.x), floorf(p.y), floorf(p.x) + 1.0f, floorf(p.y) + 1.0f);
+            } break;
+            
+            case RenderPrimitiveKind_Line:
+            {
+                if (!((vertex_index - base_index) & 1) && ((vertex_index + 1) < end_index))
+                {
+                    SW_SetLinePrimitive(renderer, vertex_index, vertices + vertex_index, vertices + vertex_index + 1);
+                }
+                else
+                {
+                    SW_SetEmptyPrimitive(renderer, vertex_index);
+                }
+            } break;
+            
+            case RenderPrimitiveKind_Triangle:
+            {
+                u32 triangle_index = vertex_index - (vertex_index - base_index) % 3;
+                Render_Per_Vertex_Data *triangle = vertices + triangle_index;
+                if ((triangle_index + 2) >= end_index)
+                {
+                    SW_SetEmptyPrimitive(renderer, vertex_index);
+                }
+                else if (draw_call->filled)
+                {
+                    if (vertex_index == triangle_index)
+                    {
+                        v2f p0 = triangle[0].vertex;
+                        v2f p1 = triangle[1].vertex;
+                        v2f p2 = triangle[2].vertex;
+                        SW_SetPrimitive(renderer, vertex_index, SW_PrimitiveKind_Triangle, triangle,
+                                        Min(p0.x, Min(p1.x, p2.x)), Min(p0.y, Min(p1.y, p2.y)),
+                                        Max(p0.x, Max(p1.x, p2.x)), Max(p0.y, Max(p1.y, p2.y)));
+                    }
+                    else
+                    {
+                        SW_SetEmptyPrimitive(renderer, vertex_index);
+                    }
+                }
+                else if (vertex_index < (triangle_index + 2))
+                {
+                    SW_SetLinePrimitive(renderer, vertex_index, vertices + vertex_index, vertices + vertex_index + 1);
+                }
+                else
+                {
+                    Render_Per_Vertex_Data *closing = job->closing_lines + 2 * vertex_index;
+                    closing[0] = triangle[2];
+                    closing[1] = triangle[0];
+                    SW_SetLinePrimitive(renderer, vertex_index, closing + 0, closing + 1);
+                }
+            } break;
+            
+            default:
+            {
+                InvalidCodePath();
+            } break;
+        }
+    }
+}
+
+function void
+SW_FillQuadSlots(SW_Bin_Job *job, Quad_Render_Chunk *chunk, u32 first_slot)
+{
+    SW_Renderer *renderer = job->renderer;
+    for (u32 quad_index = 0; quad_index < chunk->quads_drawn; ++quad_index)
+    {
+        Quad *quad = chunk->quads + quad_index;
+        v2f min;
+        v2f max;
+        Quad_GetBounds(quad, &min, &max);
+        SW_SetPrimitive(renderer, first_slot + quad_index, SW_PrimitiveKind_Quad, quad, min.x, min.y, max.x, max.y);
+    }
+}
+
+// NOTE(christian): the slots of one batch.
+inline void
+SW_BinBatchSlots(SW_Bin_Job *job, u32 batch_index, u32 *first, u32 *one_past_last)
+{
+    u32 vertex_count = job->render_batch->vertex_count;
+    if (batch_index < job->vertex_batch_count)
+    {
+        *first = batch_index * sw_bin_batch_size;
+        *one_past_last = Min(*first + sw_bin_batch_size, vertex_count);
+    }
+    else
+    {
+        u32 chunk_index = batch_index - job->vertex_batch_count;
+        *first = vertex_count + chunk_index * quad_render_chunk_capacity;
+        *one_past_last = *first + job->quad_chunks[chunk_index]->quads_drawn;
+    }
+}
+
+function void
+SW_BinCountJob(void *data, u32 first_batch, u32 one_past_last_batch)
+{
+    SW_Bin_Job *job = (SW_Bin_Job *)data;
+    SW_Renderer *renderer = job->renderer;
+    u32 tile_count = renderer->tile_count;
+    u32 tile_count_x = renderer->tile_count_x;
+    for (u32 batch_index = first_batch; batch_index < one_past_last_batch; ++batch_index)
+    {
+        u32 first;
+        u32 one_past_last;
+        SW_BinBatchSlots(job, batch_index, &first, &one_past_last);
+        if (batch_index < job->vertex_batch_count)
+        {
+            SW_FillVertexSlots(job, first, one_past_last);
+        }
+        else
+        {
+            SW_FillQuadSlots(job, job->quad_chunks[batch_index - job->vertex_batch_count], first);
+        }
+        
+        u32 *counts = job->batch_tile_cursors + batch_index * tile_count;
+        MemoryZero(counts, sizeof(u32) * tile_count);
+        for (u32 slot = first; slot < one_past_last; ++slot)
+        {
+            SW_Primitive *primitive = renderer->primitives + slot;
+            for (u32 tile_y = primitive->tile_min_y; tile_y <= primitive->tile_max_y; ++tile_y)
+            {
+                for (u32 tile_x = primitive->tile_min_x; tile_x <= primitive->tile_max_x; ++tile_x)
+                {
+                    ++counts[tile_y * tile_count_x + tile_x];
+                }
+            }
+        }
+    }
+}
+
+function void
+SW_BinScatterJob(void *data, u32 first_batch, u32 one_past_last_batch)
+{
+    SW_Bin_Job *job = (SW_Bin_Job *)data;
+    SW_Renderer *renderer = job->renderer;
+    u32 tile_count = renderer->tile_count;
+    u32 tile_count_x = renderer->tile_count_x;
+    SW_Binned_Primitive *tile_primitives = renderer->tile_primitives;
+    for (u32 batch_index = first_batch; batch_index < one_past_last_batch; ++batch_index)
+    {
+        u32 first;
+        u32 one_past_last;
+        SW_BinBatchSlots(job, batch_index, &first, &one_past_last);
+        
+        u32 *cursors = job->batch_tile_cursors + batch_index * tile_count;
+        for (u32 slot = first; slot < one_past_last; ++slot)
+        {
+            SW_Primitive *primitive = renderer->primitives + slot;
+            if ((primitive->tile_min_x > primitive->tile_max_x) || (primitive->tile_min_y > primitive->tile_max_y))
+            {
+                continue;
+            }
+            
+            // NOTE(christian): a degenerate one still takes its places in the bins, the counts have them.
+            SW_Binned_Primitive binned;
+            binned.kind = primitive->kind;
+            switch (primitive->kind)
+            {
+                case SW_PrimitiveKind_Point:
+                {
+                    binned.point = *(Render_Per_Vertex_Data *)primitive->data;
+                } break;
+                
+                case SW_PrimitiveKind_Line:
+                {
+                    Render_Per_Vertex_Data *line = (Render_Per_Vertex_Data *)primitive->data;
+                    if (!SW_SetupLine(&binned.line, line + 0, line + 1))
+                    {
+                        binned.kind = SW_PrimitiveKind_None;
+                    }
+                } break;
+                
+                case SW_PrimitiveKind_Triangle:
+                {
+                    Render_Per_Vertex_Data *triangle = (Render_Per_Vertex_Data *)primitive->data;
+                    if (!SW_SetupTriangle(&binned.triangle, triangle + 0, triangle + 1, triangle + 2))
+                    {
+                        binned.kind = SW_PrimitiveKind_None;
+                    }
+                } break;
+                
+                case SW_PrimitiveKind_Quad:
+                {
+                    if (!SW_SetupQuad(&binned.quad, (Quad *)primitive->data))
+                    {
+                        binned.kind = SW_PrimitiveKind_None;
+                    }
+                } break;
+                
+                default:
+                {
+                    InvalidCodePath();
+                } break;
+            }
+            
+            for (u32 tile_y = primitive->tile_min_y; tile_y <= primitive->tile_max_y; ++tile_y)
+            {
+                for (u32 tile_x = primitive->tile_min_x; tile_x <= primitive->tile_max_x; ++tile_x)
+                {
+                    tile_primitives[cursors[tile_y * tile_count_x + tile_x]++] = binned;
+                }
+            }
+        }
+    }
+}
+
+function void
+SW_BinPrimitives(SW_Renderer *renderer, Quad_Render_Batch *quad_render_batch, Render_Batch *render_batch)
+{
+    Memory_Arena *arena = &renderer->bin_arena;
+    MemoryArena_Reset(arena);
+    
+    SW_Bin_Job job = {0};
+    job.renderer = renderer;
+    job.render_batch = render_batch;
+    job.vertex_batch_count = (render_batch->vertex_count + sw_bin_batch_size - 1) / sw_bin_batch_size;
+    
+    u32 chunk_count = 0;
+    job.quad_chunks = MemoryArena_PushArray(arena, Quad_Render_Chunk *, quad_render_batch->chunk_count);
+    for (Quad_Render_Chunk *chunk = quad_render_batch->first_chunk;
+         chunk && chunk->quads_drawn && (chunk_count < quad_render_batch->chunk_count);
+         chunk = chunk->next)
+    {
+        job.quad_chunks[chunk_count++] = chunk;
+    }
+    
+    u32 batch_count = job.vertex_batch_count + chunk_count;
+    u32 tile_count = renderer->tile_count;
+    renderer->primitive_count = render_batch->vertex_count + quad_render_batch->quads_drawn;
+    renderer->primitives = MemoryArena_PushArray(arena, SW_Primitive, renderer->primitive_count);
+    job.closing_lines = MemoryArena_PushArray(arena, Render_Per_Vertex_Data, 2 * render_batch->vertex_count);
+    job.batch_tile_cursors = MemoryArena_PushArray(arena, u32, batch_count * tile_count);
+    
+    Job_Counter count_counter = {0};
+    JobSystem_ParallelFor(renderer->jobs, &count_counter, batch_count, 1, &SW_BinCountJob, &job);
+    JobSystem_Wait(renderer->jobs, &count_counter);
+    
+    // NOTE(christian): the serial part, tiles times batches.
+    u32 *tile_offsets = MemoryArena_PushArray(arena, u32, tile_count + 1);
+    u32 offset = 0;
+    for (u32 tile_index = 0; tile_index < tile_count; ++tile_index)
+    {
+        tile_offsets[tile_index] = offset;
+        u32 *cursor = job.batch_tile_cursors + tile_index;
+        for (u32 batch_index = 0; batch_index < batch_count; ++batch_index)
+        {
+            u32 count = *cursor;
+            *cursor = offset;
+            offset += count;
+            cursor += tile_count;
+        }
+    }
+    tile_offsets[tile_count] = offset;
+    
+    renderer->tile_offsets = tile_offsets;
+    renderer->tile_primitives = MemoryArena_PushArray(arena, SW_Binned_Primitive, offset);
+    
+    Job_Counter scatter_counter = {0};
+    JobSystem_ParallelFor(renderer->jobs, &scatter_counter, batch_count, 1, &SW_BinScatterJob, &job);
+    JobSystem_Wait(renderer->jobs, &scatter_counter);
+}
+
+function void
+SW_DrawTile(SW_Renderer *renderer, u32 tile_index)
+{
+    u32 tile_x = tile_index % renderer->tile_count_x;
+    u32 tile_y = tile_index / renderer->tile_count_x;
+    SW_Rect clip;
+    clip.min_x = (s32)(tile_x * sw_tile_size);
+    clip.min_y = (s32)(tile_y * sw_tile_size);
+    clip.max_x = Min(clip.min_x + sw_tile_size, (s32)renderer->width);
+    clip.max_y = Min(clip.min_y + sw_tile_size, (s32)renderer->height);
+    
+    SW_Clear(renderer, clip, V4F(0.0f, 0.0f, 0.0f, 1.0f));
+    
+    u32 end_offset = renderer->tile_offsets[tile_index + 1];
+    for (u32 offset = renderer->tile_offsets[tile_index]; offset < end_offset; ++offset)
+    {
+        SW_Binned_Primitive *binned = renderer->tile_primitives + offset;
+        switch (binned->kind)
+        {
+            case SW_PrimitiveKind_Point:
+            {
+                SW_DrawPoint(renderer, clip, &binned->point);
+            } break;
+            
+            case SW_PrimitiveKind_Line:
+            {
+                SW_DrawLineSetup(renderer, clip, &binned->line);
+            } break;
+            
+            case SW_PrimitiveKind_Triangle:
+            {
+                SW_DrawTriangleSetup(renderer, clip, &binned->triangle);
+            } break;
+            
+            case SW_PrimitiveKind_Quad:
+            {
+                SW_DrawQuadSetup(renderer, clip, &binned->quad);
+            } break;
+            
+            default: break;
+        }
+    }
+    
+    SW_Resolve(renderer, clip);
+}
+
+function void
+SW_DrawTilesJob(void *data, u32 first, u32 one_past_last)
+{
+    SW_Renderer *renderer = (SW_Renderer *)data;
+    for (u32 tile_index = first; tile_index < one_past_last; ++tile_index)
+    {
+        SW_DrawTile(renderer, tile_index);
+    }
+}
+
+// NOTE(christian): same order as D3D11_RendererSubmit: clear, immediate primitives, then quads.
+function void
+SW_RendererSubmit(SW_Renderer *renderer, Quad_Render_Batch *quad_render_batch, Render_Batch *render_batch)
+{
+    if (renderer->jobs)
+    {
+        ProfileBegin("sw bin");
+        SW_BinPrimitives(renderer, quad_render_batch, render_batch);
+        ProfileEnd("sw bin");
+        
+        Job_Counter tiles_counter = {0};
+        JobSystem_ParallelFor(renderer->jobs, &tiles_counter, renderer->tile_count, 1, &SW_DrawTilesJob, renderer);
+        JobSystem_Wait(renderer->jobs, &tiles_counter);
+    }
+    else
+    {
+        SW_Rect full = SW_RendererFullRect(renderer);
+        SW_Clear(renderer, full, V4F(0.0f, 0.0f, 0.0f, 1.0f));
+        SW_DrawRenderBatch(renderer, full, render_batch);
+        SW_DrawQuadBatch(renderer, full, quad_render_batch);
+        SW_Resolve(renderer, full);
+    }
+}
+
+//~ NOTE(christian): frame dumps
+function b32
+SW_WritePPM(SW_Renderer *renderer, char *path)
+{
+    b32 result = False;
+    FILE *file = fopen(path, "wb");
+    if (file)
+    {
+        fprintf(file, "P6\n%u %u\n255\n", renderer->width, renderer->height);
+        u32 pixel_count = renderer->width * renderer->height;
+        for (u32 pixel_index = 0; pixel_index < pixel_count; ++pixel_index)
+        {
+            fwrite(renderer->pixels + pixel_index, 3, 1, file);
+        }
+        
+        result = ferror(file) == 0;
+        fclose(file);
+    }
+    return(result);
+}
+
+global u32 g_sw_crc_table[256];
+
+function u32
+SW_CRC32(u32 crc, u8 *data, u64 size)
+{
+    if (!g_sw_crc_table[1])
+    {
+        for (u32 entry_index = 0; entry_index < 256; ++entry_index)
+        {
+            u32 value = entry_index;
+            for (u32 bit_index = 0; bit_index < 8; ++bit_index)
+            {
+                value = (value & 1) ? (0xEDB88320 ^ (value >> 1)) : (value >> 1);
+            }
+            g_sw_crc_table[entry_index] = value;
+        }
+    }
+    
+    crc = ~crc;
+    for (u64 byte_index = 0; byte_index < size; ++byte_index)
+    {
+        crc = g_sw_crc_table[(crc ^ data[byte_index]) & 0xFF] ^ (crc >> 8);
+    }
+    return(~crc);
+}
+
+inline void
+SW_WriteU32BE(u8 *dest, u32 value)
+{
+    dest[0] = (u8)(value >> 24);
+    dest[1] = (u8)(value >> 16);
+    dest[2] = (u8)(value >> 8);
+    dest[3] = (u8)(value);
+}
+
+function void
+SW_WritePNGChunk(FILE *file, char *type, u8 *data, u32 size)
+{
+    u8 header[8];
+    SW_WriteU32BE(header, size);
+    MemoryCopy(header + 4, type, 4);
+    
+    u32 crc = SW_CRC32(0, header + 4, 4);
+    crc = SW_CRC32(crc, data, size);
+    u8 footer[4];
+    SW_WriteU32BE(footer, crc);
+    
+    fwrite(header, sizeof(header), 1, file);
+    if (size)
+    {
+        fwrite(data, size, 1, file);
+    }
+    fwrite(footer, sizeof(footer), 1, file);
+}
+
+// NOTE(christian): RGBA8 with stored (uncompressed) deflate blocks. big, but exact and dependency free.
+function b32
+SW_WritePNG(SW_Renderer *renderer, char *path)
+{
+    b32 result = False;
+    FILE *file = fopen(path, "wb");
+    if (file)
+    {
+        Temporary_Memory scratch = Scratch_Begin(null, 0);
+        
+        u32 row_size = 1 + renderer->width * 4;
+        u32 raw_size = row_size * renderer->height;
+        u8 *raw = MemoryArena_PushArray(scratch.arena, u8, raw_size);
+        for (u32 y = 0; y < renderer->height; ++y)
+        {
+            raw[y * row_size] = 0;
+            MemoryCopy(raw + y * row_size + 1, renderer->pixels + y * renderer->width, renderer->width * 4);
+        }
+        
+        u32 block_count = (raw_size + 65534) / 65535;
+        u32 zlib_size = 2 + block_count * 5 + raw_size + 4;
+        u8 *zlib = MemoryArena_PushArray(scratch.arena, u8, zlib_size);
+        u8 *at = zlib;
+        *at++ = 0x78;
+        *at++ = 0x01;
+        
+        u32 adler_a = 1;
+        u32 adler_b = 0;
+        for (u32 offset = 0; offset < raw_size; offset += 65535)
+        {
+            u32 block_size = Min(raw_size - offset, 65535);
+            *at++ = ((offset + block_size) == raw_size) ? 1 : 0;
+            *at++ = (u8)(block_size);
+            *at++ = (u8)(block_size >> 8);
+            *at++ = (u8)(~block_size);
+            *at++ = (u8)(~block_size >> 8);
+            MemoryCopy(at, raw + offset, block_size);
+            at += block_size;
+            
+            for (u32 byte_index = 0; byte_index < block_size; ++byte_index)
+            {
+                adler_a = (adler_a + raw[offset + byte_index]) % 65521;
+                adler_b = (adler_b + adler_a) % 65521;
+            }
+        }
+        SW_WriteU32BE(at, (adler_b << 16) | adler_a);
+        
+        u8 header[13];
+        SW_WriteU32BE(header + 0, renderer->width);
+        SW_WriteU32BE(header + 4, renderer->height);
+        header[8] = 8; // bit depth
+        header[9] = 6; // RGBA
+        header[10] = 0;
+        header[11] = 0;
+        header[12] = 0;
+        
+        u8 signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        fwrite(signature, sizeof(signature), 1, file);
+        SW_WritePNGChunk(file, "IHDR", header, sizeof(header));
+        SW_WritePNGChunk(file, "IDAT", zlib, zlib_size);
+        SW_WritePNGChunk(file, "IEND", null, 0);
+        
+        Scratch_End(scratch);
+        result = ferror(file) == 0;
+        fclose(file);
+    }
+    return(result);
+}
+
+// NOTE(christian): .png gets a png, anything else a binary ppm.
+function b32
+SW_WriteImage(SW_Renderer *renderer, char *path)
+{
+    u64 length = strlen(path);
+    b32 png = (length >= 4) && !strcmp(path + length - 4, ".png");
+    b32 result = png ? SW_WritePNG(renderer, path) : SW_WritePPM(renderer, path);
+    return(result);
+}
@@ -0,0 +1,238 @@
+//~ NOTE(christian): shader pack
+inline u64
+Hash_FNV1a64(u64 hash, u8 *data, u64 size)
+{
+    u64 result = hash;
+    for (u64 byte_index = 0; byte_index < size; ++byte_index)
+    {
+        result ^= data[byte_index];
+        result *= 0x100000001b3llu;
+    }
+    return(result);
+}
+
+function Shader_Source *
+Shader_GetSource(Shader_ID id)
+{
+    local Shader_Source sources[ShaderID_Count] =
+    {
+        { "../data/shaders/main_shader.hlsl", "VSMain", "vs_5_0" },
+        { "../data/shaders/main_shader.hlsl", "PSMain", "ps_5_0" },
+        { "../data/shaders/immediate_render.hlsl", "VSMain", "vs_5_0" },
+        { "../data/shaders/immediate_render.hlsl", "PSMain", "ps_5_0" },
+    };
+    Shader_Source *result = sources + id;
+    return(result);
+}
+
+function String_Const_U8
+Shader_ReadFile(Memory_Arena *arena, char *path)
+{
+    String_Const_U8 result = {0};
+    FILE *file = fopen(path, "rb");
+    if (file)
+    {
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        
+        u8 *data = (size > 0) ? MemoryArena_PushArray(arena, u8, (u64)size) : null;
+        if (data && (fread(data, (size_t)size, 1, file) == 1))
+        {
+            result.str = data;
+            result.count = (u64)size;
+        }
+        fclose(file);
+    }
+    return(result);
+}
+
+// NOTE(christian): the names are hashed with their terminators, so "VSMain" + "vs_5_0" can't collide
+// with "VSMainv" + "s_5_0".
+function u64
+Shader_HashSource(String_Const_U8 source, Shader_Source *shader, u32 compile_flags)
+{
+    u64 result = Hash_FNV1a64(hash_fnv1a64_seed, source.str, source.count);
+    result = Hash_FNV1a64(result, (u8 *)shader->entry_point, strlen(shader->entry_point) + 1);
+    result = Hash_FNV1a64(result, (u8 *)shader->target, strlen(shader->target) + 1);
+    result = Hash_FNV1a64(result, (u8 *)&compile_flags, sizeof(compile_flags));
+    return(result);
+}
+
+function void
+ShaderPack_Load(Shader_Pack *pack, Memory_Arena *arena, char *path)
+{
+    MemoryZero(pack, sizeof(Shader_Pack));
+    
+    String_Const_U8 file = Shader_ReadFile(arena, path);
+    u64 table_size = sizeof(Shader_Pack_Header) + sizeof(Shader_Pack_Entry) * ShaderID_Count;
+    if (file.count >= table_size)
+    {
+        Shader_Pack_Header *header = (Shader_Pack_Header *)file.str;
+        if ((header->magic == shader_pack_magic) &&
+            (header->version == shader_pack_version) &&
+            (header->entry_count == ShaderID_Count))
+        {
+            Shader_Pack_Entry *entries = (Shader_Pack_Entry *)(header + 1);
+            for (u32 shader_index = 0; shader_index < ShaderID_Count; ++shader_index)
+            {
+                Shader_Pack_Entry *entry = entries + shader_index;
+                if (entry->size && (entry->offset >= table_size) &&
+                    ((u64)entry->offset + entry->size <= file.count))
+                {
+                    Shader_Bytecode *shader = pack->shaders + shader_index;
+                    shader->source_hash = entry->source_hash;
+                    shader->data = file.str + entry->offset;
+                    shader->size = entry->size;
+                }
+            }
+        }
+    }
+}
+
+function b32
+ShaderPack_Write(Shader_Pack *pack, char *path)
+{
+    b32 result = False;
+    FILE *file = fopen(path, "wb");
+    if (file)
+    {
+        Shader_Pack_Header header = {0};
+        header.magic = shader_pack_magic;
+        header.version = shader_pack_version;
+        header.entry_count = ShaderID_Count;
+        fwrite(&header, sizeof(header), 1, file);
+        
+        u64 offset = sizeof(Shader_Pack_Header) + sizeof(Shader_Pack_Entry) * ShaderID_Count;
+        for (u32 shader_index = 0; shader_index < ShaderID_Count; ++shader_index)
+        {
+            Shader_Bytecode *shader = pack->shaders + shader_index;
+            Shader_Pack_Entry entry = {0};
+            if (shader->data)
+            {
+                entry.source_hash = shader->source_hash;
+                entry.offset = (u32)offset;
+                entry.size = (u32)shader->size;
+                offset += shader->size;
+            }
+            fwrite(&entry, sizeof(entry), 1, file);
+        }
+        
+        for (u32 shader_index = 0; shader_index < ShaderID_Count; ++shader_index)
+        {
+            Shader_Bytecode *shader = pack->shaders + shader_index;
+            if (shader->data)
+            {
+                fwrite(shader->data, shader->size, 1, file);
+            }
+        }
+        
+        result = ferror(file) == 0;
+        fclose(file);
+    }
+    return(result);
+}
+
+//~ NOTE(christian): hot reload
+function void
+ShaderReloader_Thread(void *parameter)
+{
+    Shader_Reloader *reloader = (Shader_Reloader *)parameter;
+    char path[os_file_watch_max_path];
+    char full_path[os_file_watch_max_path * 2];
+    for (;;)
+    {
+        b32 changed[ShaderID_Count] = {0};
+        u32 timeout_ms = os_wait_infinite;
+        while (OS_FileWatchWait(&reloader->watch, timeout_ms, path, sizeof(path)))
+        {
+            snprintf(full_path, sizeof(full_path), "%s/%s", shader_watch_directory, path);
+            for (u32 shader_index = 0; shader_index < ShaderID_Count; ++shader_index)
+            {
+                changed[shader_index] |= !strcmp(full_path, Shader_GetSource((Shader_ID)shader_index)->path);
+            }
+            timeout_ms = shader_reload_settle_ms;
+        }
+        
+        if (AtomicLoadU32(&reloader->stop))
+        {
+            break;
+        }
+        
+        Temporary_Memory scratch = Scratch_Begin(null, 0);
+        Shader_ID ids[ShaderID_Count];
+        String_Const_U8 sources[ShaderID_Count];
+        u32 count = 0;
+        b32 readable = True;
+        for (u32 shader_index = 0; shader_index < ShaderID_Count; ++shader_index)
+        {
+            if (changed[shader_index])
+            {
+                Shader_Source *source = Shader_GetSource((Shader_ID)shader_index);
+                ids[count] = (Shader_ID)shader_index;
+                sources[count] = Shader_ReadFile(scratch.arena, source->path);
+                if (!sources[count].count)
+                {
+                    printf("failed to read %s\n", source->path);
+                    readable = False;
+                }
+                ++count;
+            }
+        }
+        
+        if (count && readable && !reloader->proc)
+        {
+            for (u32 index = 0; index < count; ++index)
+            {
+                Shader_Source *source = Shader_GetSource(ids[index]);
+                printf("shaders: %s %s changed, %u bytes, no backend to reload it\n",
+                       source->path, source->entry_point, sources[index].count);
+            }
+        }
+        else if (count && readable)
+        {
+            u64 begin_ticks = OS_GetTicks();
+            b32 reloaded = reloader->proc(reloader->backend, ids, sources, count);
+            if (reloaded || !AtomicLoadU32(&reloader->stop))
+            {
+                printf("shaders: %s %u in %.2f ms\n", reloaded ? "reloaded" : "kept the old ones, failed to compile", count,
+                       1000.0 * OS_SecondsBetweenTicksF64(begin_ticks, OS_GetTicks()));
+            }
+        }
+        Scratch_End(scratch);
+    }
+    
+    OS_SemaphoreSignal(&reloader->stopped, 1);
+}
+
+function b32
+ShaderReloader_Start(Shader_Reloader *reloader, Shader_Reload_Proc *proc, void *backend)
+{
+    reloader->proc = proc;
+    reloader->backend = backend;
+    reloader->stop = 0;
+    b32 result = OS_FileWatchInit(&reloader->watch, shader_watch_directory);
+    if (result)
+    {
+        result = OS_SemaphoreInit(&reloader->stopped, 0) && OS_ThreadStart(&ShaderReloader_Thread, reloader);
+        if (!result)
+        {
+            OS_FileWatchClose(&reloader->watch);
+        }
+    }
+    reloader->running = result;
+    return(result);
+}
+
+function void
+ShaderReloader_Stop(Shader_Reloader *reloader)
+{
+    if (reloader->running)
+    {
+        AtomicStoreU32(&reloader->stop, 1);
+        OS_FileWatchWake(&reloader->watch);
+        OS_SemaphoreWait(&reloader->stopped);
+        OS_FileWatchClose(&reloader->watch);
+        reloader->running = False;
+    }
+}
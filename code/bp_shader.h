@@ -0,0 +1,112 @@
+/* date = October 17th 2026 11:40 pm */
+
+#ifndef BP_SHADER_H
+#define BP_SHADER_H
+
+//~ NOTE(christian): shader pack
+// NOTE(christian): every shader the backends use, compiled ahead of time into one file of bytecode.
+// each entry is keyed by a hash of its source file, entry point, target and compile flags, so a
+// pack built from other sources is noticed entry by entry. the backend compiles only the stale ones
+// and writes the pack back, so the next launch is warm again.
+//
+// the file is a Shader_Pack_Header, shader_id_count Shader_Pack_Entries, then the bytecode.
+// offsets are from the start of the file. a pack with the wrong magic, version or count is ignored
+// as a whole. #includes aren't followed, so a shader that includes another file has to be built
+// with -build-shaders after the include changes.
+#define shader_pack_path "../build/bytepath_shaders.pack"
+#define shader_pack_magic 0x50535042 // "BPSP"
+#define shader_pack_version 1
+
+typedef enum Shader_ID
+{
+    ShaderID_MainVertex,
+    ShaderID_MainPixel,
+    ShaderID_ImmediateVertex,
+    ShaderID_ImmediatePixel,
+    ShaderID_Count
+} Shader_ID;
+
+typedef struct Shader_Source
+{
+    char *path;
+    char *entry_point;
+    char *target;
+} Shader_Source;
+
+typedef struct Shader_Pack_Header
+{
+    u32 magic;
+    u32 version;
+    u32 entry_count;
+    u32 reserved;
+} Shader_Pack_Header;
+
+typedef struct Shader_Pack_Entry
+{
+    u64 source_hash;
+    u32 offset;
+    u32 size;
+} Shader_Pack_Entry;
+
+// NOTE(christian): bytecode of an empty entry is null.
+typedef struct Shader_Bytecode
+{
+    u64 source_hash;
+    u8 *data;
+    u64 size;
+} Shader_Bytecode;
+
+typedef struct Shader_Pack
+{
+    Shader_Bytecode shaders[ShaderID_Count];
+} Shader_Pack;
+
+// NOTE(christian): where each Shader_ID comes from. paths are relative to the build directory.
+function Shader_Source *Shader_GetSource(Shader_ID id);
+
+// NOTE(christian): FNV-1a, 64 bit. continue a hash by passing the last result as hash.
+#define hash_fnv1a64_seed 0xcbf29ce484222325llu
+inline u64 Hash_FNV1a64(u64 hash, u8 *data, u64 size);
+
+// NOTE(christian): the whole file, or an empty string when it can't be read.
+function String_Const_U8 Shader_ReadFile(Memory_Arena *arena, char *path);
+function u64 Shader_HashSource(String_Const_U8 source, Shader_Source *shader, u32 compile_flags);
+
+// NOTE(christian): entries that are missing or don't match come back empty, the rest point into arena.
+function void ShaderPack_Load(Shader_Pack *pack, Memory_Arena *arena, char *path);
+function b32 ShaderPack_Write(Shader_Pack *pack, char *path);
+
+//~ NOTE(christian): hot reload
+// NOTE(christian): a thread of its own blocks on a file watch over shader_watch_directory. once a
+// change comes in it keeps collecting until nothing has changed for shader_reload_settle_ms, then
+// hands every shader whose source file changed to the backend in one batch. the backend compiles
+// them on that thread and leaves the results for its render thread to swap in between frames, so
+// a reload costs the frame nothing but the swap.
+#define shader_watch_directory "../data"
+#define shader_reload_settle_ms 50
+
+// NOTE(christian): the backend's side of a reload, on the reload thread. a batch is all or nothing:
+// if any shader fails to compile the old ones all stay, and the error is logged. returns whether
+// the batch was handed over.
+typedef b32 Shader_Reload_Proc(void *backend, Shader_ID *ids, String_Const_U8 *sources, u32 count);
+
+typedef struct Shader_Reloader
+{
+    OS_File_Watch watch;
+    Shader_Reload_Proc *proc;
+    void *backend;
+    b32 running;
+    // NOTE(christian): set by ShaderReloader_Stop. a proc that waits on the render thread should give
+    // up once it's set, the render thread is the one stopping it.
+    volatile u32 stop;
+    OS_Semaphore stopped;
+} Shader_Reloader;
+
+// NOTE(christian): with no proc there's nothing to reload into, the thread only logs which shaders
+// changed. that's what -hot-reload does without the d3d11 backend.
+function b32 ShaderReloader_Start(Shader_Reloader *reloader, Shader_Reload_Proc *proc, void *backend);
+// NOTE(christian): wakes the thread and waits for it to finish the batch it's on and exit. does
+// nothing if it never started.
+function void ShaderReloader_Stop(Shader_Reloader *reloader);
+
+#endif //BP_SHADER_H
@@ -0,0 +1,437 @@
+function b32
+SpatialGrid_Init(Spatial_Grid *grid, Memory_Arena *arena, v2f min, v2f dims, f32 cell_size, u32 capacity)
+{
+    MemoryZero(grid, sizeof(Spatial_Grid));
+    grid->min = min;
+    grid->cell_size = cell_size;
+    grid->inverse_cell_size = 1.0f / cell_size;
+    grid->cell_count_x = Max((u32)ceilf(dims.x * grid->inverse_cell_size), 1);
+    grid->cell_count_y = Max((u32)ceilf(dims.y * grid->inverse_cell_size), 1);
+    grid->cell_count = grid->cell_count_x * grid->cell_count_y;
+    grid->capacity = capacity;
+    grid->max_batch_count = Max((capacity + spatial_build_batch_size - 1) / spatial_build_batch_size, 1);
+    
+    grid->cell_offsets = MemoryArena_PushArrayZero(arena, u32, grid->cell_count + 1);
+    grid->items = MemoryArena_PushArray(arena, u32, capacity);
+    grid->item_x = MemoryArena_PushArrayZero(arena, f32, capacity + lane_width);
+    grid->item_y = MemoryArena_PushArrayZero(arena, f32, capacity + lane_width);
+    grid->item_radius = MemoryArena_PushArrayZero(arena, f32, capacity + lane_width);
+    grid->input_cells = MemoryArena_PushArray(arena, u32, capacity);
+    grid->batch_cursors = MemoryArena_PushArray(arena, u32, grid->max_batch_count * grid->cell_count);
+    grid->batch_max_radius = MemoryArena_PushArray(arena, f32, grid->max_batch_count);
+    
+    b32 result = (grid->cell_offsets && grid->items && grid->item_x && grid->item_y && grid->item_radius &&
+                  grid->input_cells && grid->batch_cursors && grid->batch_max_radius);
+    return(result);
+}
+
+// NOTE(christian): clamped into [0, count). Max puts nan at 0 as well.
+inline u32
+SpatialGrid_CellCoordinate(f32 value, f32 min, f32 inverse_cell_size, u32 count)
+{
+    f32 cell = Max((value - min) * inverse_cell_size, 0.0f);
+    u32 result = (u32)(s32)Min(cell, (f32)(count - 1));
+    return(result);
+}
+
+//~ NOTE(christian): build
+// NOTE(christian): the grid fields are copied into locals, otherwise every store through a u32 array
+// could alias them and the compiler reloads them all per item.
+function void
+SpatialGrid_CountBatch(Spatial_Grid *grid, f32 *x, f32 *y, f32 *radius, u32 first, u32 one_past_last)
+{
+    u32 batch_index = first / spatial_build_batch_size;
+    u32 *counts = grid->batch_cursors + batch_index * grid->cell_count;
+    u32 *input_cells = grid->input_cells;
+    v2f min = grid->min;
+    f32 inverse_cell_size = grid->inverse_cell_size;
+    u32 cell_count_x = grid->cell_count_x;
+    u32 cell_count_y = grid->cell_count_y;
+    MemoryZero(counts, sizeof(u32) * grid->cell_count);
+    
+    f32 max_radius = 0.0f;
+    for (u32 index = first; index < one_past_last; ++index)
+    {
+        u32 cell_x = SpatialGrid_CellCoordinate(x[index], min.x, inverse_cell_size, cell_count_x);
+        u32 cell_y = SpatialGrid_CellCoordinate(y[index], min.y, inverse_cell_size, cell_count_y);
+        u32 cell = cell_y * cell_count_x + cell_x;
+        input_cells[index] = cell;
+        ++counts[cell];
+        max_radius = Max(max_radius, radius[index]);
+    }
+    grid->batch_max_radius[batch_index] = max_radius;
+}
+
+// NOTE(christian): turns every batch's counts into where that batch starts writing each cell.
+function void
+SpatialGrid_AssignOffsets(Spatial_Grid *grid, u32 batch_count)
+{
+    u32 offset = 0;
+    for (u32 cell = 0; cell < grid->cell_count; ++cell)
+    {
+        grid->cell_offsets[cell] = offset;
+        u32 *cursor = grid->batch_cursors + cell;
+        for (u32 batch_index = 0; batch_index < batch_count; ++batch_index)
+        {
+            u32 count = *cursor;
+            *cursor = offset;
+            offset += count;
+            cursor += grid->cell_count;
+        }
+    }
+    grid->cell_offsets[grid->cell_count] = offset;
+    
+    grid->max_radius = 0.0f;
+    for (u32 batch_index = 0; batch_index < batch_count; ++batch_index)
+    {
+        grid->max_radius = Max(grid->max_radius, grid->batch_max_radius[batch_index]);
+    }
+}
+
+function void
+SpatialGrid_ScatterBatch(Spatial_Grid *grid, f32 *x, f32 *y, f32 *radius, u32 first, u32 one_past_last)
+{
+    u32 *cursors = grid->batch_cursors + (first / spatial_build_batch_size) * grid->cell_count;
+    u32 *input_cells = grid->input_cells;
+    u32 *items = grid->items;
+    f32 *item_x = grid->item_x;
+    f32 *item_y = grid->item_y;
+    f32 *item_radius = grid->item_radius;
+    for (u32 index = first; index < one_past_last; ++index)
+    {
+        u32 sorted_index = cursors[input_cells[index]]++;
+        items[sorted_index] = index;
+        item_x[sorted_index] = x[index];
+        item_y[sorted_index] = y[index];
+        item_radius[sorted_index] = radius[index];
+    }
+}
+
+function void
+SpatialGrid_Build(Spatial_Grid *grid, f32 *x, f32 *y, f32 *radius, u32 count)
+{
+    Assert(count <= grid->capacity);
+    count = Min(count, grid->capacity);
+    grid->item_count = count;
+    
+    u32 batch_count = (count + spatial_build_batch_size - 1) / spatial_build_batch_size;
+    for (u32 first = 0; first < count; first += spatial_build_batch_size)
+    {
+        SpatialGrid_CountBatch(grid, x, y, radius, first, Min(first + spatial_build_batch_size, count));
+    }
+    SpatialGrid_AssignOffsets(grid, batch_count);
+    for (u32 first = 0; first < count; first += spatial_build_batch_size)
+    {
+        SpatialGrid_ScatterBatch(grid, x, y, radius, first, Min(first + spatial_build_batch_size, count));
+    }
+}
+
+typedef struct Spatial_Build_Job
+{
+    Spatial_Grid *grid;
+    f32 *x;
+    f32 *y;
+    f32 *radius;
+} Spatial_Build_Job;
+
+function void
+SpatialGrid_CountJob(void *data, u32 first, u32 one_past_last)
+{
+    Spatial_Build_Job *job = (Spatial_Build_Job *)data;
+    SpatialGrid_CountBatch(job->grid, job->x, job->y, job->radius, first, one_past_last);
+}
+
+function void
+SpatialGrid_ScatterJob(void *data, u32 first, u32 one_past_last)
+{
+    Spatial_Build_Job *job = (Spatial_Build_Job *)data;
+    SpatialGrid_ScatterBatch(job->grid, job->x, job->y, job->radius, first, one_past_last);
+}
+
+// NOTE(christian): count and scatter are both parallel over batches. only the offset pass in between
+// is serial, and it is cells times batches, which doesn't grow with the item count much.
+function void
+SpatialGrid_BuildParallel(Spatial_Grid *grid, Job_System *jobs, f32 *x, f32 *y, f32 *radius, u32 count)
+{
+    Assert(count <= grid->capacity);
+    count = Min(count, grid->capacity);
+    grid->item_count = count;
+    
+    Spatial_Build_Job build_job = { grid, x, y, radius };
+    Job_Counter count_counter = {0};
+    JobSystem_ParallelFor(jobs, &count_counter, count, spatial_build_batch_size, &SpatialGrid_CountJob, &build_job);
+    JobSystem_Wait(jobs, &count_counter);
+    
+    SpatialGrid_AssignOffsets(grid, (count + spatial_build_batch_size - 1) / spatial_build_batch_size);
+    
+    Job_Counter scatter_counter = {0};
+    JobSystem_ParallelFor(jobs, &scatter_counter, count, spatial_build_batch_size, &SpatialGrid_ScatterJob, &build_job);
+    JobSystem_Wait(jobs, &scatter_counter);
+}
+
+//~ NOTE(christian): queries
+typedef struct Spatial_Cell_Range
+{
+    u32 min_x;
+    u32 min_y;
+    u32 max_x;
+    u32 max_y;
+} Spatial_Cell_Range;
+
+// NOTE(christian): every cell that can hold the center of an item overlapping [min, max].
+inline Spatial_Cell_Range
+SpatialGrid_CellRange(Spatial_Grid *grid, v2f min, v2f max)
+{
+    f32 pad = grid->max_radius;
+    Spatial_Cell_Range result;
+    result.min_x = SpatialGrid_CellCoordinate(min.x - pad, grid->min.x, grid->inverse_cell_size, grid->cell_count_x);
+    result.min_y = SpatialGrid_CellCoordinate(min.y - pad, grid->min.y, grid->inverse_cell_size, grid->cell_count_y);
+    result.max_x = SpatialGrid_CellCoordinate(max.x + pad, grid->min.x, grid->inverse_cell_size, grid->cell_count_x);
+    result.max_y = SpatialGrid_CellCoordinate(max.y + pad, grid->min.y, grid->inverse_cell_size, grid->cell_count_y);
+    return(result);
+}
+
+inline u32
+SpatialGrid_AppendMatches(Spatial_Grid *grid, lane_u32 mask, u32 sorted_index, u32 lane_count,
+                          u32 *out, u32 out_capacity, u32 match_count)
+{
+    u32 result = match_count;
+    if (LaneU32_AnyNonZero(mask))
+    {
+        u32 masks[lane_width];
+        LaneU32_Store(masks, mask);
+        for (u32 lane_index = 0; lane_index < lane_count; ++lane_index)
+        {
+            if (masks[lane_index])
+            {
+                if (result < out_capacity)
+                {
+                    out[result] = grid->items[sorted_index + lane_index];
+                }
+                ++result;
+            }
+        }
+    }
+    return(result);
+}
+
+// NOTE(christian): a row of cells is one contiguous run of items, so each row of the range is a
+// single loop. the last lane of a run can read past it, into the next run or the lane of slack the
+// sorted arrays carry, but only lanes inside the run get appended.
+function u32
+SpatialGrid_QueryCircle(Spatial_Grid *grid, v2f center, f32 radius, u32 *out, u32 out_capacity)
+{
+    u32 result = 0;
+    if (grid->item_count)
+    {
+        Spatial_Cell_Range range = SpatialGrid_CellRange(grid, V2F(center.x - radius, center.y - radius),
+                                                         V2F(center.x + radius, center.y + radius));
+        lane_f32 center_x = LaneF32_Set1(center.x);
+        lane_f32 center_y = LaneF32_Set1(center.y);
+        lane_f32 query_radius = LaneF32_Set1(radius);
+        for (u32 cell_y = range.min_y; cell_y <= range.max_y; ++cell_y)
+        {
+            u32 row = cell_y * grid->cell_count_x;
+            u32 first = grid->cell_offsets[row + range.min_x];
+            u32 one_past_last = grid->cell_offsets[row + range.max_x + 1];
+            for (u32 index = first; index < one_past_last; index += lane_width)
+            {
+                lane_f32 dx = LaneF32_Subtract(LaneF32_Load(grid->item_x + index), center_x);
+                lane_f32 dy = LaneF32_Subtract(LaneF32_Load(grid->item_y + index), center_y);
+                lane_f32 reach = LaneF32_Add(LaneF32_Load(grid->item_radius + index), query_radius);
+                lane_f32 distance_squared = LaneF32_Add(LaneF32_Multiply(dx, dx), LaneF32_Multiply(dy, dy));
+                lane_u32 mask = LaneF32_GreaterEqual(LaneF32_Multiply(reach, reach), distance_squared);
+                result = SpatialGrid_AppendMatches(grid, mask, index, Min(lane_width, one_past_last - index),
+                                                   out, out_capacity, result);
+            }
+        }
+    }
+    return(result);
+}
+
+function u32
+SpatialGrid_QueryAABB(Spatial_Grid *grid, v2f min, v2f max, u32 *out, u32 out_capacity)
+{
+    u32 result = 0;
+    if (grid->item_count)
+    {
+        Spatial_Cell_Range range = SpatialGrid_CellRange(grid, min, max);
+        lane_f32 min_x = LaneF32_Set1(min.x);
+        lane_f32 min_y = LaneF32_Set1(min.y);
+        lane_f32 max_x = LaneF32_Set1(max.x);
+        lane_f32 max_y = LaneF32_Set1(max.y);
+        for (u32 cell_y = range.min_y; cell_y <= range.max_y; ++cell_y)
+        {
+            u32 row = cell_y * grid->cell_count_x;
+            u32 first = grid->cell_offsets[row + range.min_x];
+            u32 one_past_last = grid->cell_offsets[row + range.max_x + 1];
+            for (u32 index = first; index < one_past_last; index += lane_width)
+            {
+                // NOTE(christian): distance from the center to the closest point of the box.
+                lane_f32 x = LaneF32_Load(grid->item_x + index);
+                lane_f32 y = LaneF32_Load(grid->item_y + index);
+                lane_f32 item_radius = LaneF32_Load(grid->item_radius + index);
+                lane_f32 dx = LaneF32_Subtract(x, LaneF32_Min(LaneF32_Max(x, min_x), max_x));
+                lane_f32 dy = LaneF32_Subtract(y, LaneF32_Min(LaneF32_Max(y, min_y), max_y));
+                lane_f32 distance_squared = LaneF32_Add(LaneF32_Multiply(dx, dx), LaneF32_Multiply(dy, dy));
+                lane_u32 mask = LaneF32_GreaterEqual(LaneF32_Multiply(item_radius, item_radius), distance_squared);
+                result = SpatialGrid_AppendMatches(grid, mask, index, Min(lane_width, one_past_last - index),
+                                                   out, out_capacity, result);
+            }
+        }
+    }
+    return(result);
+}
+
+// NOTE(christian): tests the items of cells [min_x, max_x] x [min_y, max_y], clamped to the grid,
+// against a ray with a unit direction. keeps the closest hit under best_distance.
+function void
+SpatialGrid_RaycastCells(Spatial_Grid *grid, v2f origin, v2f direction, s32 min_x, s32 min_y, s32 max_x, s32 max_y,
+                         u32 *best_item, f32 *best_distance)
+{
+    min_x = Max(min_x, 0);
+    min_y = Max(min_y, 0);
+    max_x = Min(max_x, (s32)grid->cell_count_x - 1);
+    max_y = Min(max_y, (s32)grid->cell_count_y - 1);
+    for (s32 cell_y = min_y; (min_x <= max_x) && (cell_y <= max_y); ++cell_y)
+    {
+        u32 row = (u32)cell_y * grid->cell_count_x;
+        u32 first = grid->cell_offsets[row + (u32)min_x];
+        u32 one_past_last = grid->cell_offsets[row + (u32)max_x + 1];
+        for (u32 index = first; index < one_past_last; ++index)
+        {
+            f32 to_x = grid->item_x[index] - origin.x;
+            f32 to_y = grid->item_y[index] - origin.y;
+            f32 radius = grid->item_radius[index];
+            f32 along = to_x * direction.x + to_y * direction.y;
+            f32 outside = to_x * to_x + to_y * to_y - radius * radius;
+            f32 distance = -1.0f;
+            if (outside <= 0.0f)
+            {
+                distance = 0.0f;
+            }
+            else if (along > 0.0f)
+            {
+                f32 discriminant = along * along - outside;
+                if (discriminant >= 0.0f)
+                {
+                    distance = along - sqrtf(discriminant);
+                }
+            }
+            
+            if ((distance >= 0.0f) && (distance < *best_distance))
+            {
+                *best_distance = distance;
+                *best_item = grid->items[index];
+            }
+        }
+    }
+}
+
+// NOTE(christian): walks the cells under the ray one at a time (Amanatides & Woo). an item can reach
+// pad cells past its own, so entering a cell tests the strip of cells that just came within pad of
+// the ray, which tests each item once. a hit at distance t is found by the time the walk enters the
+// cell under t, so the walk stops once it enters a cell past the best hit.
+function u32
+SpatialGrid_Raycast(Spatial_Grid *grid, v2f origin, v2f direction, f32 max_distance, f32 *out_distance)
+{
+    u32 result = spatial_invalid_index;
+    f32 best_distance = max_distance;
+    
+    f32 length = sqrtf(direction.x * direction.x + direction.y * direction.y);
+    if (grid->item_count && (length > 0.0f) && (max_distance >= 0.0f))
+    {
+        direction = V2F_Scale(direction, 1.0f / length);
+        
+        // NOTE(christian): clip [0, max_distance] to the grid.
+        v2f grid_max = V2F(grid->min.x + grid->cell_size * grid->cell_count_x,
+                           grid->min.y + grid->cell_size * grid->cell_count_y);
+        f32 enter = 0.0f;
+        f32 leave = max_distance;
+        f32 origins[2] = { origin.x, origin.y };
+        f32 directions[2] = { direction.x, direction.y };
+        f32 mins[2] = { grid->min.x, grid->min.y };
+        f32 maxs[2] = { grid_max.x, grid_max.y };
+        for (u32 axis = 0; axis < 2; ++axis)
+        {
+            if (directions[axis] != 0.0f)
+            {
+                f32 t0 = (mins[axis] - origins[axis]) / directions[axis];
+                f32 t1 = (maxs[axis] - origins[axis]) / directions[axis];
+                enter = Max(enter, Min(t0, t1));
+                leave = Min(leave, Max(t0, t1));
+            }
+            else if ((origins[axis] < mins[axis]) || (origins[axis] > maxs[axis]))
+            {
+                leave = -1.0f;
+            }
+        }
+        
+        if (enter <= leave)
+        {
+            v2f start = V2F(origin.x + direction.x * enter, origin.y + direction.y * enter);
+            s32 cell_x = (s32)SpatialGrid_CellCoordinate(start.x, grid->min.x, grid->inverse_cell_size, grid->cell_count_x);
+            s32 cell_y = (s32)SpatialGrid_CellCoordinate(start.y, grid->min.y, grid->inverse_cell_size, grid->cell_count_y);
+            s32 pad = (s32)ceilf(grid->max_radius * grid->inverse_cell_size);
+            
+            s32 step_x = (direction.x > 0.0f) ? 1 : ((direction.x < 0.0f) ? -1 : 0);
+            s32 step_y = (direction.y > 0.0f) ? 1 : ((direction.y < 0.0f) ? -1 : 0);
+            f32 next_x = INFINITY;
+            f32 next_y = INFINITY;
+            f32 delta_x = INFINITY;
+            f32 delta_y = INFINITY;
+            if (step_x)
+            {
+                f32 boundary = grid->min.x + grid->cell_size * (f32)(cell_x + (step_x > 0));
+                next_x = (boundary - origin.x) / direction.x;
+                delta_x = grid->cell_size / AbsoluteValueF32(direction.x);
+            }
+            if (step_y)
+            {
+                f32 boundary = grid->min.y + grid->cell_size * (f32)(cell_y + (step_y > 0));
+                next_y = (boundary - origin.y) / direction.y;
+                delta_y = grid->cell_size / AbsoluteValueF32(direction.y);
+            }
+            
+            SpatialGrid_RaycastCells(grid, origin, direction, cell_x - pad, cell_y - pad, cell_x + pad, cell_y + pad,
+                                     &result, &best_distance);
+            for (;;)
+            {
+                f32 cell_enter = Min(next_x, next_y);
+                if ((cell_enter > leave) || (cell_enter > best_distance))
+                {
+                    break;
+                }
+                
+                if (next_x < next_y)
+                {
+                    cell_x += step_x;
+                    next_x += delta_x;
+                    s32 strip_x = cell_x + step_x * pad;
+                    SpatialGrid_RaycastCells(grid, origin, direction, strip_x, cell_y - pad, strip_x, cell_y + pad,
+                                             &result, &best_distance);
+                }
+                else
+                {
+                    cell_y += step_y;
+                    next_y += delta_y;
+                    s32 strip_y = cell_y + step_y * pad;
+                    SpatialGrid_RaycastCells(grid, origin, direction, cell_x - pad, strip_y, cell_x + pad, strip_y,
+                                             &result, &best_distance);
+                }
+                
+                if ((cell_x < 0) || (cell_x >= (s32)grid->cell_count_x) ||
+                    (cell_y < 0) || (cell_y >= (s32)grid->cell_count_y))
+                {
+                    break;
+                }
+            }
+        }
+    }
+    
+    if (out_distance)
+    {
+        *out_distance = (result != spatial_invalid_index) ? best_distance : max_distance;
+    }
+    return(result);
+}
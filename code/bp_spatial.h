@@ -0,0 +1,71 @@
+/* date = October 17th 2026 9:30 pm */
+
+#ifndef BP_SPATIAL_H
+#define BP_SPATIAL_H
+
+// NOTE(christian): uniform grid over the play field, rebuilt from scratch every tick. every item
+// goes into the one cell its center falls in, and the build is a counting sort: count items per
+// cell, prefix sum the counts into offsets, scatter. no per cell lists, no allocation after init,
+// and each cell ends up as one contiguous run of items.
+//
+// items are circles. a circle can hang over into the cells next to its own, so queries grow their
+// bounds by the largest radius in the grid and then test the candidates exactly. centers outside
+// the field are clamped into the border cells, so nothing gets lost off the edge.
+//
+// the sorted items also keep their own copy of x, y and radius. queries read straight down a
+// cell's run and only touch the caller's arrays through the index they hand back.
+#define spatial_invalid_index 0xFFFFFFFF
+
+// NOTE(christian): items per build job. the parallel build is the same counting sort with one
+// histogram per batch. offsets are handed out cell by cell, batch by batch, so the result is
+// identical to the serial build no matter how the batches get scheduled.
+#define spatial_build_batch_size 4096
+
+typedef struct Spatial_Grid
+{
+    v2f min;
+    f32 cell_size;
+    f32 inverse_cell_size;
+    u32 cell_count_x;
+    u32 cell_count_y;
+    u32 cell_count;
+    
+    u32 capacity;
+    u32 item_count;
+    f32 max_radius;
+    
+    // NOTE(christian): the items of cell c are [cell_offsets[c], cell_offsets[c + 1]).
+    u32 *cell_offsets;
+    
+    // NOTE(christian): in cell order. items holds the index the item had in the arrays it was built
+    // from. the f32 arrays have lane_width of slack at the end so queries can load whole lanes.
+    u32 *items;
+    f32 *item_x;
+    f32 *item_y;
+    f32 *item_radius;
+    
+    // NOTE(christian): build scratch. the cell of every input item, and one histogram per batch
+    // that becomes that batch's write cursors.
+    u32 *input_cells;
+    u32 *batch_cursors;
+    f32 *batch_max_radius;
+    u32 max_batch_count;
+} Spatial_Grid;
+
+function b32 SpatialGrid_Init(Spatial_Grid *grid, Memory_Arena *arena, v2f min, v2f dims, f32 cell_size, u32 capacity);
+function void SpatialGrid_Build(Spatial_Grid *grid, f32 *x, f32 *y, f32 *radius, u32 count);
+function void SpatialGrid_BuildParallel(Spatial_Grid *grid, Job_System *jobs, f32 *x, f32 *y, f32 *radius, u32 count);
+
+//~ NOTE(christian): queries
+// NOTE(christian): the overlap queries return how many items matched and write the first
+// out_capacity of their indices to out, in cell order. a result above out_capacity means the
+// rest were dropped.
+function u32 SpatialGrid_QueryCircle(Spatial_Grid *grid, v2f center, f32 radius, u32 *out, u32 out_capacity);
+function u32 SpatialGrid_QueryAABB(Spatial_Grid *grid, v2f min, v2f max, u32 *out, u32 out_capacity);
+
+// NOTE(christian): the first item the ray touches within max_distance, or spatial_invalid_index.
+// direction doesn't need to be normalised, distances are in pixels either way. a ray that starts
+// inside an item hits it at 0. only the part of the ray over the play field is walked.
+function u32 SpatialGrid_Raycast(Spatial_Grid *grid, v2f origin, v2f direction, f32 max_distance, f32 *out_distance);
+
+#endif //BP_SPATIAL_H
@@ -0,0 +1,377 @@
+//~ NOTE(christian): font
+// NOTE(christian): rows top to bottom, bit 4 is the leftmost pixel.
+typedef struct Glyph_Bitmap
+{
+    u32 codepoint;
+    u8 rows[glyph_bitmap_height];
+} Glyph_Bitmap;
+
+global Glyph_Bitmap g_glyph_bitmaps[] =
+{
+    { 0x0020, { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 } },
+    { 0x0021, { 0x04, 0x04, 0x04, 0x04, 0x00, 0x00, 0x04 } },
+    { 0x0022, { 0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00 } },
+    { 0x0023, { 0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A } },
+    { 0x0024, { 0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04 } },
+    { 0x0025, { 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 } },
+    { 0x0026, { 0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D } },
+    { 0x0027, { 0x0C, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00 } },
+    { 0x0028, { 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 } },
+    { 0x0029, { 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 } },
+    { 0x002A, { 0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00 } },
+    { 0x002B, { 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 } },
+    { 0x002C, { 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08 } },
+    { 0x002D, { 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 } },
+    { 0x002E, { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C } },
+    { 0x002F, { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 } },
+    { 0x0030, { 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E } },
+    { 0x0031, { 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+    { 0x0032, { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F } },
+    { 0x0033, { 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E } },
+    { 0x0034, { 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 } },
+    { 0x0035, { 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E } },
+    { 0x0036, { 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E } },
+    { 0x0037, { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 } },
+    { 0x0038, { 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E } },
+    { 0x0039, { 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C } },
+    { 0x003A, { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 } },
+    { 0x003B, { 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08 } },
+    { 0x003C, { 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 } },
+    { 0x003D, { 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 } },
+    { 0x003E, { 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 } },
+    { 0x003F, { 0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 } },
+    { 0x0040, { 0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E } },
+    { 0x0041, { 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11 } },
+    { 0x0042, { 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E } },
+    { 0x0043, { 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E } },
+    { 0x0044, { 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C } },
+    { 0x0045, { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F } },
+    { 0x0046, { 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 } },
+    { 0x0047, { 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F } },
+    { 0x0048, { 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 } },
+    { 0x0049, { 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+    { 0x004A, { 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C } },
+    { 0x004B, { 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 } },
+    { 0x004C, { 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F } },
+    { 0x004D, { 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 } },
+    { 0x004E, { 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 } },
+    { 0x004F, { 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+    { 0x0050, { 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 } },
+    { 0x0051, { 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D } },
+    { 0x0052, { 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 } },
+    { 0x0053, { 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E } },
+    { 0x0054, { 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 } },
+    { 0x0055, { 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E } },
+    { 0x0056, { 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 } },
+    { 0x0057, { 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A } },
+    { 0x0058, { 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 } },
+    { 0x0059, { 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 } },
+    { 0x005A, { 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F } },
+    { 0x005B, { 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E } },
+    { 0x005C, { 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 } },
+    { 0x005D, { 0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E } },
+    { 0x005E, { 0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00 } },
+    { 0x005F, { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F } },
+    { 0x0060, { 0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00 } },
+    { 0x0061, { 0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F } },
+    { 0x0062, { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E } },
+    { 0x0063, { 0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E } },
+    { 0x0064, { 0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F } },
+    { 0x0065, { 0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E } },
+    { 0x0066, { 0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08 } },
+    { 0x0067, { 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E } },
+    { 0x0068, { 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11 } },
+    { 0x0069, { 0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E } },
+    { 0x006A, { 0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0C } },
+    { 0x006B, { 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12 } },
+    { 0x006C, { 0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E } },
+    { 0x006D, { 0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11 } },
+    { 0x006E, { 0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11 } },
+    { 0x006F, { 0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E } },
+    { 0x0070, { 0x00, 0x00, 0x1E, 0x11, 0x1E, 0x10, 0x10 } },
+    { 0x0071, { 0x00, 0x00, 0x0D, 0x13, 0x0F, 0x01, 0x01 } },
+    { 0x0072, { 0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10 } },
+    { 0x0073, { 0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x1E } },
+    { 0x0074, { 0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06 } },
+    { 0x0075, { 0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D } },
+    { 0x0076, { 0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04 } },
+    { 0x0077, { 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A } },
+    { 0x0078, { 0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11 } },
+    { 0x0079, { 0x00, 0x00, 0x11, 0x11, 0x0F, 0x01, 0x0E } },
+    { 0x007A, { 0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F } },
+    { 0x007B, { 0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02 } },
+    { 0x007C, { 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 } },
+    { 0x007D, { 0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08 } },
+    { 0x007E, { 0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00 } },
+    { 0x00B0, { 0x0C, 0x12, 0x12, 0x0C, 0x00, 0x00, 0x00 } },
+    { 0x00B7, { 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00 } },
+    { 0x00D7, { 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x00 } },
+    { 0x2190, { 0x00, 0x04, 0x08, 0x1F, 0x08, 0x04, 0x00 } },
+    { 0x2191, { 0x04, 0x0E, 0x15, 0x04, 0x04, 0x04, 0x00 } },
+    { 0x2192, { 0x00, 0x04, 0x02, 0x1F, 0x02, 0x04, 0x00 } },
+    { 0x2193, { 0x00, 0x04, 0x04, 0x04, 0x15, 0x0E, 0x04 } },
+    { 0xFFFD, { 0x1F, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1F } },
+};
+
+inline u32
+GlyphAtlas_HashSlot(u32 codepoint)
+{
+    u32 result = (codepoint * 2654435761u) >> 24;
+    return(result & (glyph_hash_capacity - 1));
+}
+
+function b32
+GlyphAtlas_Bake(Glyph_Atlas *atlas, Memory_Arena *arena)
+{
+    Assert(ArrayCount(g_glyph_bitmaps) < glyph_max_count);
+    Assert((ArrayCount(g_glyph_bitmaps) * 2) <= glyph_hash_capacity);
+    
+    atlas->width = glyph_atlas_width;
+    atlas->height = glyph_atlas_height;
+    atlas->texels = MemoryArena_PushArrayZero(arena, u8, glyph_atlas_width * glyph_atlas_height);
+    atlas->glyphs = MemoryArena_PushArrayZero(arena, Glyph, ArrayCount(g_glyph_bitmaps));
+    atlas->glyph_count = 0;
+    atlas->fallback_glyph = 0;
+    if (!atlas->texels || !atlas->glyphs)
+    {
+        return(False);
+    }
+    
+    for (u32 slot_index = 0; slot_index < glyph_hash_capacity; ++slot_index)
+    {
+        atlas->hash_codepoints[slot_index] = glyph_hash_empty;
+    }
+    
+    // NOTE(christian): cell 0 is solid white, what untextured quads sample. glyphs start at cell 1.
+    for (u32 y = 0; y < glyph_cell_height; ++y)
+    {
+        for (u32 x = 0; x < glyph_cell_width; ++x)
+        {
+            atlas->texels[y * glyph_atlas_width + x] = 0xFF;
+        }
+    }
+    
+    u32 cells_per_row = glyph_atlas_width / glyph_cell_width;
+    v2f texel_size = V2F(1.0f / (f32)glyph_atlas_width, 1.0f / (f32)glyph_atlas_height);
+    for (u32 bitmap_index = 0; bitmap_index < ArrayCount(g_glyph_bitmaps); ++bitmap_index)
+    {
+        Glyph_Bitmap *bitmap = g_glyph_bitmaps + bitmap_index;
+        u32 cell_index = bitmap_index + 1;
+        u32 cell_x = (cell_index % cells_per_row) * glyph_cell_width;
+        u32 cell_y = (cell_index / cells_per_row) * glyph_cell_height;
+        
+        b32 blank = True;
+        for (u32 row = 0; row < glyph_bitmap_height; ++row)
+        {
+            u8 *texel = atlas->texels + (cell_y + row) * glyph_atlas_width + cell_x;
+            for (u32 column = 0; column < glyph_bitmap_width; ++column)
+            {
+                b32 set = (bitmap->rows[row] >> (glyph_bitmap_width - 1 - column)) & 1;
+                texel[column] = set ? 0xFF : 0x00;
+                blank &= !set;
+            }
+        }
+        
+        u32 glyph_index = atlas->glyph_count++;
+        Glyph *glyph = atlas->glyphs + glyph_index;
+        glyph->codepoint = bitmap->codepoint;
+        glyph->uv_min = V2F((f32)cell_x * texel_size.x, (f32)cell_y * texel_size.y);
+        glyph->uv_max = V2F((f32)(cell_x + glyph_bitmap_width) * texel_size.x,
+                            (f32)(cell_y + glyph_bitmap_height) * texel_size.y);
+        glyph->quad_uv_min = QuadPack_UV(glyph->uv_min);
+        glyph->quad_uv_max = QuadPack_UV(glyph->uv_max);
+        glyph->blank = blank;
+        
+        u32 slot = GlyphAtlas_HashSlot(bitmap->codepoint);
+        while (atlas->hash_codepoints[slot] != glyph_hash_empty)
+        {
+            slot = (slot + 1) & (glyph_hash_capacity - 1);
+        }
+        atlas->hash_codepoints[slot] = bitmap->codepoint;
+        atlas->hash_glyphs[slot] = (u16)glyph_index;
+        
+        if (bitmap->codepoint == utf_replacement_codepoint)
+        {
+            atlas->fallback_glyph = glyph_index;
+        }
+    }
+    
+    return(True);
+}
+
+inline Glyph *
+GlyphAtlas_Lookup(Glyph_Atlas *atlas, u32 codepoint)
+{
+    Glyph *result = atlas->glyphs + atlas->fallback_glyph;
+    u32 slot = GlyphAtlas_HashSlot(codepoint);
+    for (u32 probe = 0; probe < glyph_hash_capacity; ++probe)
+    {
+        u32 slot_codepoint = atlas->hash_codepoints[slot];
+        if (slot_codepoint == codepoint)
+        {
+            result = atlas->glyphs + atlas->hash_glyphs[slot];
+            break;
+        }
+        
+        if (slot_codepoint == glyph_hash_empty)
+        {
+            break;
+        }
+        slot = (slot + 1) & (glyph_hash_capacity - 1);
+    }
+    return(result);
+}
+
+//~ NOTE(christian): layout
+// NOTE(christian): the font is monospaced, so this needs no atlas. every codepoint, ill formed bytes
+// included, is one advance wide.
+function v2f
+Text_Measure(String_Const_U8 text, f32 scale)
+{
+    u32 line_count = text.count ? 1 : 0;
+    u32 column_count = 0;
+    u32 max_column_count = 0;
+    u8 *end = text.str + text.count;
+    for (u8 *at = text.str; at < end;)
+    {
+        String_Decode decode = StringDecode_UTF8(at, (u32)(end - at));
+        at = decode.next_in_str;
+        if (decode.codepoint == '\n')
+        {
+            ++line_count;
+            column_count = 0;
+        }
+        else
+        {
+            ++column_count;
+            max_column_count = Max(max_column_count, column_count);
+        }
+    }
+    
+    v2f result = V2F((f32)(max_column_count * text_glyph_advance) * scale, (f32)(line_count * text_line_advance) * scale);
+    return(result);
+}
+
+// NOTE(christian): walks a string one visible glyph at a time. blanks and newlines only move the pen.
+typedef struct Text_Cursor
+{
+    u8 *at;
+    u8 *end;
+    f32 scale;
+    v2f pen;
+} Text_Cursor;
+
+inline b32
+TextCursor_Next(Text_Cursor *cursor, Glyph_Atlas *atlas, Glyph **out_glyph, v2f *out_offset)
+{
+    b32 result = False;
+    while (!result && (cursor->at < cursor->end))
+    {
+        String_Decode decode = StringDecode_UTF8(cursor->at, (u32)(cursor->end - cursor->at));
+        cursor->at = decode.next_in_str;
+        if (decode.codepoint == '\n')
+        {
+            cursor->pen = V2F(0.0f, cursor->pen.y + (f32)text_line_advance * cursor->scale);
+        }
+        else
+        {
+            Glyph *glyph = GlyphAtlas_Lookup(atlas, decode.codepoint);
+            if (!glyph->blank)
+            {
+                *out_glyph = glyph;
+                *out_offset = cursor->pen;
+                result = True;
+            }
+            cursor->pen.x += (f32)text_glyph_advance * cursor->scale;
+        }
+    }
+    return(result);
+}
+
+function Text_Layout
+TextLayout_Build(Glyph_Atlas *atlas, Memory_Arena *arena, String_Const_U8 text, f32 scale)
+{
+    Text_Layout result = {0};
+    result.glyph_dims = V2F((f32)glyph_bitmap_width * scale, (f32)glyph_bitmap_height * scale);
+    result.dims = Text_Measure(text, scale);
+    
+    // NOTE(christian): never more glyphs than bytes.
+    result.glyphs = MemoryArena_PushArray(arena, Text_Layout_Glyph, text.count);
+    if (result.glyphs)
+    {
+        Text_Cursor cursor = { text.str, text.str + text.count, scale, V2F(0.0f, 0.0f) };
+        Glyph *glyph;
+        v2f offset;
+        while (TextCursor_Next(&cursor, atlas, &glyph, &offset))
+        {
+            Text_Layout_Glyph *layout_glyph = result.glyphs + result.glyph_count++;
+            layout_glyph->offset = offset;
+            layout_glyph->quad_uv_min = glyph->quad_uv_min;
+            layout_glyph->quad_uv_max = glyph->quad_uv_max;
+        }
+    }
+    return(result);
+}
+
+// NOTE(christian): everything but the position comes in packed. a string's glyphs share their
+// axes and colour, so those get packed once per string rather than once per glyph.
+inline Quad *
+QuadRenderBatch_PushGlyphPacked(Quad_Render_Batch *render_batch, v2f origin, u32 x_axis, u32 y_axis, u32 colour,
+                                u32 uv_min, u32 uv_max)
+{
+    Quad *quad = QuadRenderBatch_Acquire(render_batch);
+    quad->origin = QuadPack_V2F(origin);
+    quad->x_axis = x_axis;
+    quad->y_axis = y_axis;
+    quad->style = QuadFlag_UniformColour << quad_style_flags_shift;
+    quad->colours[0] = colour;
+    quad->colours[1] = uv_min;
+    quad->colours[2] = uv_max;
+    quad->colours[3] = 0;
+    return(quad);
+}
+
+inline Quad *
+QuadRenderBatch_PushGlyph(Quad_Render_Batch *render_batch, v2f origin, v2f dims, v4f colour, v2f uv_min, v2f uv_max)
+{
+    return QuadRenderBatch_PushGlyphPacked(render_batch, origin,
+                                           QuadPack_V2F(V2F(dims.x, 0.0f)), QuadPack_V2F(V2F(0.0f, dims.y)),
+                                           QuadPack_Colour(colour), QuadPack_UV(uv_min), QuadPack_UV(uv_max));
+}
+
+function void
+QuadRenderBatch_PushTextLayout(Quad_Render_Batch *render_batch, Text_Layout *layout, v2f origin, v4f colour)
+{
+    origin = V2F(RoundF32(origin.x), RoundF32(origin.y));
+    u32 x_axis = QuadPack_V2F(V2F(layout->glyph_dims.x, 0.0f));
+    u32 y_axis = QuadPack_V2F(V2F(0.0f, layout->glyph_dims.y));
+    u32 packed_colour = QuadPack_Colour(colour);
+    for (u32 glyph_index = 0; glyph_index < layout->glyph_count; ++glyph_index)
+    {
+        Text_Layout_Glyph *glyph = layout->glyphs + glyph_index;
+        QuadRenderBatch_PushGlyphPacked(render_batch, V2F_Add(origin, glyph->offset), x_axis, y_axis, packed_colour,
+                                        glyph->quad_uv_min, glyph->quad_uv_max);
+    }
+}
+
+// NOTE(christian): lays out and pushes in one go, for text that changes every frame. returns the pen
+// position after the last codepoint, relative to origin.
+function v2f
+QuadRenderBatch_PushText(Quad_Render_Batch *render_batch, Glyph_Atlas *atlas, v2f origin, v4f colour,
+                         f32 scale, String_Const_U8 text)
+{
+    origin = V2F(RoundF32(origin.x), RoundF32(origin.y));
+    v2f glyph_dims = V2F((f32)glyph_bitmap_width * scale, (f32)glyph_bitmap_height * scale);
+    u32 x_axis = QuadPack_V2F(V2F(glyph_dims.x, 0.0f));
+    u32 y_axis = QuadPack_V2F(V2F(0.0f, glyph_dims.y));
+    u32 packed_colour = QuadPack_Colour(colour);
+    Text_Cursor cursor = { text.str, text.str + text.count, scale, V2F(0.0f, 0.0f) };
+    Glyph *glyph;
+    v2f offset;
+    while (TextCursor_Next(&cursor, atlas, &glyph, &offset))
+    {
+        QuadRenderBatch_PushGlyphPacked(render_batch, V2F_Add(origin, offset), x_axis, y_axis, packed_colour,
+                                        glyph->quad_uv_min, glyph->quad_uv_max);
+    }
+    return(cursor.pen);
+}
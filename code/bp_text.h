@@ -0,0 +1,87 @@
+/* date = October 17th 2026 8:40 pm */
+
+#ifndef BP_TEXT_H
+#define BP_TEXT_H
+
+// NOTE(christian): text is quads. the font is a 5x7 bitmap compiled in, baked at startup into one
+// single channel coverage texture, and every glyph is a quad whose uv rect points at its cell. the
+// quad shader multiplies its colour by the atlas texel, so text draws in the same instanced draw as
+// every other quad. texel (0, 0) is white and untextured quads have a zero uv rect, so they sample
+// that and come out unchanged.
+#define glyph_atlas_width 128
+#define glyph_atlas_height 64
+#define glyph_bitmap_width 5
+#define glyph_bitmap_height 7
+#define glyph_cell_width (glyph_bitmap_width + 1)
+#define glyph_cell_height (glyph_bitmap_height + 1)
+#define glyph_max_count ((glyph_atlas_width / glyph_cell_width) * (glyph_atlas_height / glyph_cell_height))
+
+// NOTE(christian): in pixels at scale 1.
+#define text_glyph_advance glyph_cell_width
+#define text_line_advance (glyph_bitmap_height + 2)
+
+// NOTE(christian): codepoint -> glyph, open addressing. a power of two at least twice the glyph count.
+#define glyph_hash_capacity 256
+#define glyph_hash_empty 0xFFFFFFFF
+
+typedef struct Glyph
+{
+    u32 codepoint;
+    v2f uv_min;
+    v2f uv_max;
+    // NOTE(christian): the same rect already packed the way Quad carries it.
+    u32 quad_uv_min;
+    u32 quad_uv_max;
+    b32 blank;
+} Glyph;
+
+typedef struct Glyph_Atlas
+{
+    u32 width;
+    u32 height;
+    u8 *texels;
+    
+    Glyph *glyphs;
+    u32 glyph_count;
+    // NOTE(christian): U+FFFD, drawn for anything the font doesn't have.
+    u32 fallback_glyph;
+    
+    u32 hash_codepoints[glyph_hash_capacity];
+    u16 hash_glyphs[glyph_hash_capacity];
+} Glyph_Atlas;
+
+function b32 GlyphAtlas_Bake(Glyph_Atlas *atlas, Memory_Arena *arena);
+inline Glyph *GlyphAtlas_Lookup(Glyph_Atlas *atlas, u32 codepoint);
+
+//~ NOTE(christian): layout
+// NOTE(christian): origin is the top left of the first line, '\n' starts a new one. glyph quads are
+// snapped to whole pixels and scale should be whole too, so texels land on pixels one to one.
+// a Text_Layout is the quads of a string relative to its origin, for text that doesn't change every
+// frame. pushing it is a copy with an offset, no decoding or lookups.
+typedef struct Text_Layout_Glyph
+{
+    v2f offset;
+    u32 quad_uv_min;
+    u32 quad_uv_max;
+} Text_Layout_Glyph;
+
+typedef struct Text_Layout
+{
+    Text_Layout_Glyph *glyphs;
+    u32 glyph_count;
+    v2f glyph_dims;
+    v2f dims;
+} Text_Layout;
+
+function v2f Text_Measure(String_Const_U8 text, f32 scale);
+function Text_Layout TextLayout_Build(Glyph_Atlas *atlas, Memory_Arena *arena, String_Const_U8 text, f32 scale);
+
+inline Quad *QuadRenderBatch_PushGlyphPacked(Quad_Render_Batch *render_batch, v2f origin, u32 x_axis, u32 y_axis, u32 colour,
+                                             u32 uv_min, u32 uv_max);
+inline Quad *QuadRenderBatch_PushGlyph(Quad_Render_Batch *render_batch, v2f origin, v2f dims, v4f colour,
+                                       v2f uv_min, v2f uv_max);
+function void QuadRenderBatch_PushTextLayout(Quad_Render_Batch *render_batch, Text_Layout *layout, v2f origin, v4f colour);
+function v2f QuadRenderBatch_PushText(Quad_Render_Batch *render_batch, Glyph_Atlas *atlas, v2f origin, v4f colour,
+                                      f32 scale, String_Const_U8 text);
+
+#endif //BP_TEXT_H
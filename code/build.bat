@@ -1,9 +1,13 @@
 @echo off
 
 set CompilerOpts=/nologo /Od /W4 /DBP_DEBUG /Z7 /wd4201 /Zc:strictStrings-
+set BenchOpts=/nologo /O2 /W4 /DBP_DEBUG=0 /Z7 /wd4201 /Zc:strictStrings-
 set Libs=user32.lib D3D11.lib  dxguid.lib D3DCompiler.lib winmm.lib Gdi32.lib
 
 if not exist ..\build mkdir ..\build
 pushd ..\build
 cl %CompilerOpts% ..\code\main.c /link /incremental:no /out:bytepath.exe %Libs%
+cl %BenchOpts% ..\code\bp_bench.c /link /incremental:no /out:bytepath_bench.exe %Libs%
+rem optimized shader bytecode, only the shaders whose source changed get compiled
+bytepath.exe -build-shaders
 popd
\ No newline at end of file
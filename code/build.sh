@@ -0,0 +1,10 @@
+#!/bin/sh
+
+CompilerOpts="-std=gnu11 -O0 -g -Wall -Wextra -DBP_DEBUG=1 -ffp-contract=off -fgnu89-inline -Wno-unused-function -Wno-missing-braces -Wno-missing-field-initializers"
+BenchOpts="-std=gnu11 -O2 -g -Wall -Wextra -DBP_DEBUG=0 -ffp-contract=off -fgnu89-inline -Wno-unused-function -Wno-missing-braces -Wno-missing-field-initializers"
+Libs="-lm -pthread"
+
+mkdir -p ../build
+cd ../build
+cc $CompilerOpts ../code/main.c -o bytepath $Libs
+cc $BenchOpts ../code/bp_bench.c -o bytepath_bench $Libs
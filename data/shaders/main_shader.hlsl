@@ -4,17 +4,48 @@ cbuffer Constants : register(b0)
 	row_major float4x4 orthographic;
 }
 
-struct Quad
+// first quad of this DrawInstanced range inside quad_sb (the buffer is a ring)
+cbuffer Quad_Instance_Constants : register(b1)
 {
-	float2 origin 	: Origin;
-	float2 x_axis 	: XAxis;
-	float2 y_axis 	: YAxis;
-	float4 colours[4] : Colours;
+	uint instance_base;
+}
 
-	float roundness : Roundness;
-	float thickness : Thickness;
+// packed 32 byte instance, the layout of Quad in bp_base_math.h:
+// origin and axes are two s12.4 halves each, x low.
+// style is roundness u10.4 in bits 0-13, thickness u10.4 in bits 14-27, flags in bits 28-31.
+// colours are rgba8 with r in the low byte. with QUAD_FLAG_UNIFORM_COLOUR only colours[0] is a
+// colour, and colours[1] / colours[2] are the glyph atlas rect as unorm16 pairs (all zero samples
+// the white texel).
+struct Quad
+{
+	uint origin;
+	uint x_axis;
+	uint y_axis;
+	uint style;
+	uint colours[4];
 };
 
+#define QUAD_FLAG_UNIFORM_COLOUR 1
+
+float2 UnpackS12_4x2(uint packed)
+{
+	int2 fixed_point = int2(asint(packed << 16) >> 16, asint(packed) >> 16);
+	float2 result = float2(fixed_point) * (1.0f / 16.0f);
+	return(result);
+}
+
+float4 UnpackRGBA8(uint packed)
+{
+	float4 result = float4(packed & 0xFF, (packed >> 8) & 0xFF, (packed >> 16) & 0xFF, packed >> 24) * (1.0f / 255.0f);
+	return(result);
+}
+
+float2 UnpackUNorm16x2(uint packed)
+{
+	float2 result = float2(packed & 0xFFFF, packed >> 16) * (1.0f / 65535.0f);
+	return(result);
+}
+
 struct VS_Out
 {
 	float4 position : SV_Position;
@@ -24,10 +55,14 @@ struct VS_Out
 	float2 y_axis : YAxis;
 	float roundness : Roundness;
 	float thickness : Thickness;
+	float2 uv : UV;
 };
 
 StructuredBuffer<Quad> quad_sb : register(t0);
 
+Texture2D<float> glyph_atlas : register(t1);
+SamplerState point_clamp_sampler : register(s0);
+
 static float2 axis_combination[] =
 {
 	float2(0.0f, 0.0f),
@@ -50,25 +85,40 @@ RoundedBoxSDF(float2 sample, float2 center, float2 half_dim, float roundness)
 
 VS_Out VSMain(uint vertex_id : SV_VertexID, uint instance_id : SV_InstanceID)
 {
-	Quad quad = quad_sb[instance_id];
+	Quad quad = quad_sb[instance_base + instance_id];
+	float2 origin = UnpackS12_4x2(quad.origin);
+	float2 x_axis = UnpackS12_4x2(quad.x_axis);
+	float2 y_axis = UnpackS12_4x2(quad.y_axis);
+	uint flags = quad.style >> 28;
+	bool uniform_colour = (flags & QUAD_FLAG_UNIFORM_COLOUR) != 0;
+
+	float2 uv_min = float2(0.0f, 0.0f);
+	float2 uv_max = float2(0.0f, 0.0f);
+	if (uniform_colour)
+	{
+		uv_min = UnpackUNorm16x2(quad.colours[1]);
+		uv_max = UnpackUNorm16x2(quad.colours[2]);
+	}
 
 	VS_Out output = {
 		float4(0.0f, 0.0f, 0.0f, 1.0f),
-		quad.colours[vertex_id],
-		quad.origin,
-		quad.x_axis,
-		quad.y_axis,
-		quad.roundness,
-		quad.thickness
+		UnpackRGBA8(quad.colours[uniform_colour ? 0 : vertex_id]),
+		origin,
+		x_axis,
+		y_axis,
+		float(quad.style & 0x3FFF) * (1.0f / 16.0f),
+		float((quad.style >> 14) & 0x3FFF) * (1.0f / 16.0f),
+		float2(0.0f, 0.0f)
 	};
 	
 	column_major float2x2 coord = {
-		quad.x_axis.x, quad.y_axis.x,
-		quad.x_axis.y, quad.y_axis.y,
+		x_axis.x, y_axis.x,
+		x_axis.y, y_axis.y,
 	};
 
 	float2 combination = axis_combination[vertex_id];
-	float4 screen_p = float4(quad.origin + mul(coord, combination), 0.0f, 1.0f);
+	output.uv = uv_min + (uv_max - uv_min) * combination;
+	float4 screen_p = float4(origin + mul(coord, combination), 0.0f, 1.0f);
 	output.position = mul(orthographic, screen_p);
 	return(output);
 }
@@ -131,5 +181,7 @@ float4 PSMain(VS_Out input) : SV_Target
 		input.colour *= smoothstep(0.0f, softness * 0.05f, signed_dist);
 	}
 
+	input.colour *= glyph_atlas.Sample(point_clamp_sampler, input.uv);
+
 	return pow(input.colour, 2.2f);
 }
\ No newline at end of file